@@ -0,0 +1,931 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  batchProcessor.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Command-line mode which loads files, applies a chain of signal
+//				 operations to the selected channels and exports the results as
+//				 CSV and/or PNG, without creating any windows.
+// History:
+
+// Standard C++ headers
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+// wxWidgets headers
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+#include <wx/image.h>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+#include <lp2d/utilities/signals/fft.h>
+
+// Local headers
+#include "batchProcessor.h"
+#include "dataSourceManager.h"
+#include "parser/delimitedFileLoader.h"
+#include "parser/customFormatMatcher.h"
+#include "renderer/softwareRenderer.h"
+#include "signals/signalOperations.h"
+#include "signals/compiledExpression.h"
+#include "signals/biquadFilter.h"
+#include "signals/spectralAnalysis.h"
+#include "signals/realFFT.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for BatchProcessor class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const wxCmdLineEntryDesc BatchProcessor::mCommandLineDescription[] = {
+	{ wxCMD_LINE_SWITCH, "b", "batch", "process the files without opening a window",
+		wxCMD_LINE_VAL_NONE, 0 },
+	{ wxCMD_LINE_OPTION, "c", "channels", "comma-separated channel names or numbers (default all)",
+		wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "o", "operations", "comma-separated operations, applied in order:  "
+		"lowpass:<Hz>[:zerophase], highpass:<Hz>[:zerophase], derivative, integral, rms, fft, "
+		"psd[:<window samples>]",
+		wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "e", "expressions", "semicolon-separated derived channels, each "
+		"<name>=<expression>, where [n] is channel n and [0] is time (e.g. power=[2]*[3])",
+		wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "p", "png", "directory in which to write a plot of each file",
+		wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "s", "csv", "directory in which to write the processed data",
+		wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "g", "spectrogram", "directory in which to write a spectrogram "
+		"(time, frequency and PSD of each channel) of each file", wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "t", "trace", "file to which to write a timeline of the processing "
+		"(Chrome trace format)", wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, "W", "width", "plot width [pixels]", wxCMD_LINE_VAL_NUMBER, 0 },
+	{ wxCMD_LINE_OPTION, "H", "height", "plot height [pixels]", wxCMD_LINE_VAL_NUMBER, 0 },
+	{ wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE,
+		wxCMD_LINE_OPTION_HELP },
+	{ wxCMD_LINE_PARAM, nullptr, nullptr, "files", wxCMD_LINE_VAL_STRING,
+		wxCMD_LINE_PARAM_MULTIPLE },
+	{ wxCMD_LINE_NONE, nullptr, nullptr, nullptr, wxCMD_LINE_VAL_NONE, 0 }
+};
+
+const int BatchProcessor::mProcessingError(1);
+const int BatchProcessor::mUsageError(2);
+const long BatchProcessor::mDefaultImageWidth(1024);
+const long BatchProcessor::mDefaultImageHeight(768);
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		IsBatchMode
+//
+// Description:		Checks the raw arguments for the batch switch.  This is
+//					called before wxWidgets is initialized.
+//
+// Input Arguments:
+//		argc	= const int&
+//		argv	= wxChar**
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool BatchProcessor::IsBatchMode(const int &argc, wxChar **argv)
+{
+	int i;
+	for (i = 1; i < argc; ++i)
+	{
+		const wxString argument(argv[i]);
+		if (argument == _T("-b") || argument == _T("--batch"))
+			return true;
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Run
+//
+// Description:		Parses the command line and processes every file on the
+//					shared thread pool.  Each failure is reported on stderr.
+//
+// Input Arguments:
+//		argc	= const int&
+//		argv	= wxChar**
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, zero if every file was processed
+//
+//==========================================================================
+int BatchProcessor::Run(const int &argc, wxChar **argv)
+{
+	wxCmdLineParser parser(mCommandLineDescription, argc, argv);
+	const int parseResult(parser.Parse());
+	if (parseResult < 0)
+		return 0;// Help was shown
+	else if (parseResult > 0 || !ReadCommandLine(parser))
+		return mUsageError;
+
+	if (!mPNGDirectory.IsEmpty() && !wxImage::FindHandler(wxBITMAP_TYPE_PNG))
+		wxImage::AddHandler(new wxPNGHandler);
+
+	CustomFormatMatcher formats;
+	DataSourceManager::LoadCustomFormats(formats);
+	DelimitedFileLoader loader(ThreadPool::GetSharedPool(), formats);
+	DataSourceManager::SetUpColumnCache(loader);
+
+	PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+	monitor.SetEnabled(!mTraceFileName.IsEmpty());
+
+	std::vector<std::string> errors(mFiles.GetCount());
+	ThreadPool::GetSharedPool().ParallelFor(mFiles.GetCount(), 1,
+		[this, &loader, &errors](const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+		{
+			if (!ProcessFile(loader, mFiles[i], errors[i]) && errors[i].empty())
+				errors[i] = "failed";
+		}
+	});
+
+	int result(0);
+	unsigned int i;
+	for (i = 0; i < errors.size(); ++i)
+	{
+		if (errors[i].empty())
+			continue;
+
+		fprintf(stderr, "%s: %s\n", mFiles[i].ToUTF8().data(),
+			errors[i].c_str());
+		result = mProcessingError;
+	}
+
+	if (!mTraceFileName.IsEmpty() &&
+		!monitor.ExportChromeTrace(std::string(mTraceFileName.ToUTF8())))
+	{
+		fprintf(stderr, "Failed to write %s\n", mTraceFileName.ToUTF8().data());
+		result = mProcessingError;
+	}
+
+	return result;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ReadCommandLine
+//
+// Description:		Stores the parsed options.
+//
+// Input Arguments:
+//		parser	= const wxCmdLineParser&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the options are valid
+//
+//==========================================================================
+bool BatchProcessor::ReadCommandLine(const wxCmdLineParser &parser)
+{
+	size_t i;
+	for (i = 0; i < parser.GetParamCount(); ++i)
+		mFiles.Add(parser.GetParam(i));
+
+	wxString value;
+	if (parser.Found(_T("channels"), &value))
+	{
+		wxStringTokenizer tokenizer(value, _T(","), wxTOKEN_STRTOK);
+		while (tokenizer.HasMoreTokens())
+			mChannels.Add(tokenizer.GetNextToken().Trim().Trim(false));
+	}
+
+	if (parser.Found(_T("operations"), &value) && !ParseOperations(value, mOperations))
+	{
+		fprintf(stderr, "Invalid operations:  %s\n", value.ToUTF8().data());
+		return false;
+	}
+
+	std::string error;
+	if (parser.Found(_T("expressions"), &value) &&
+		!ParseDerivedChannels(value, mDerivedChannels, error))
+	{
+		fprintf(stderr, "Invalid expression:  %s\n", error.c_str());
+		return false;
+	}
+
+	parser.Found(_T("png"), &mPNGDirectory);
+	parser.Found(_T("csv"), &mCSVDirectory);
+	parser.Found(_T("spectrogram"), &mSpectrogramDirectory);
+	parser.Found(_T("trace"), &mTraceFileName);
+	parser.Found(_T("width"), &mImageWidth);
+	parser.Found(_T("height"), &mImageHeight);
+
+	if (mPNGDirectory.IsEmpty() && mCSVDirectory.IsEmpty() && mSpectrogramDirectory.IsEmpty())
+	{
+		fprintf(stderr, "Nothing to do; specify --png, --csv and/or --spectrogram\n");
+		return false;
+	}
+	else if (!mSpectrogramDirectory.IsEmpty() && std::find_if(mOperations.begin(),
+		mOperations.end(), [](const Operation &operation)
+	{
+		return operation.type == Operation::Type::FFT || operation.type == Operation::Type::PSD;
+	}) != mOperations.end())
+	{
+		fprintf(stderr, "Spectrograms require time-domain data; remove fft and psd\n");
+		return false;
+	}
+	else if (mImageWidth <= 0 || mImageHeight <= 0)
+	{
+		fprintf(stderr, "Invalid plot size\n");
+		return false;
+	}
+
+	for (const auto& directory : { mPNGDirectory, mCSVDirectory, mSpectrogramDirectory })
+	{
+		if (!directory.IsEmpty() && !wxFileName::DirExists(directory) &&
+			!wxFileName::Mkdir(directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		{
+			fprintf(stderr, "Failed to create %s\n", directory.ToUTF8().data());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ParseOperations
+//
+// Description:		Parses the operation chain.
+//
+// Input Arguments:
+//		chain		= const wxString&
+//
+// Output Arguments:
+//		operations	= std::vector<Operation>&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::ParseOperations(const wxString &chain,
+	std::vector<Operation> &operations)
+{
+	wxStringTokenizer tokenizer(chain, _T(","), wxTOKEN_STRTOK);
+	while (tokenizer.HasMoreTokens())
+	{
+		wxString token(tokenizer.GetNextToken().Trim().Trim(false).Lower());
+		wxString argument;
+		const int colon(token.Find(':'));
+		if (colon != wxNOT_FOUND)
+		{
+			argument = token.Mid(colon + 1);
+			token = token.Mid(0, colon);
+		}
+
+		Operation operation;
+		operation.frequency = 0.0;
+		operation.zeroPhase = false;
+		operation.windowSize = SpectralAnalysis::defaultWindowSize;
+		if (token == _T("lowpass") || token == _T("highpass"))
+		{
+			operation.type = token == _T("lowpass") ?
+				Operation::Type::LowPass : Operation::Type::HighPass;
+			const int optionColon(argument.Find(':'));
+			if (optionColon != wxNOT_FOUND)
+			{
+				if (argument.Mid(optionColon + 1) != _T("zerophase"))
+					return false;
+				operation.zeroPhase = true;
+				argument = argument.Mid(0, optionColon);
+			}
+
+			if (!argument.ToCDouble(&operation.frequency) || operation.frequency <= 0.0)
+				return false;
+		}
+		else if (token == _T("psd"))
+		{
+			operation.type = Operation::Type::PSD;
+			unsigned long windowSize;
+			if (!argument.IsEmpty() && (!argument.ToULong(&windowSize) ||
+				!RealFFT::IsValidSize(windowSize)))
+				return false;
+			else if (!argument.IsEmpty())
+				operation.windowSize = windowSize;
+		}
+		else if (!argument.IsEmpty())
+			return false;
+		else if (token == _T("derivative"))
+			operation.type = Operation::Type::Derivative;
+		else if (token == _T("integral"))
+			operation.type = Operation::Type::Integral;
+		else if (token == _T("rms"))
+			operation.type = Operation::Type::RMS;
+		else if (token == _T("fft"))
+			operation.type = Operation::Type::FFT;
+		else
+			return false;
+
+		operations.push_back(operation);
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ParseDerivedChannels
+//
+// Description:		Parses and compiles the derived channel definitions.
+//					Each is compiled once and evaluated for every file.
+//
+// Input Arguments:
+//		list		= const wxString&
+//
+// Output Arguments:
+//		channels	= std::vector<DerivedChannel>&
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::ParseDerivedChannels(const wxString &list,
+	std::vector<DerivedChannel> &channels, std::string &error)
+{
+	wxStringTokenizer tokenizer(list, _T(";"), wxTOKEN_STRTOK);
+	while (tokenizer.HasMoreTokens())
+	{
+		const wxString token(tokenizer.GetNextToken());
+		const int equals(token.Find('='));
+		DerivedChannel channel;
+		if (equals != wxNOT_FOUND)
+			channel.name = token.Mid(0, equals).Trim().Trim(false);
+
+		const wxString expressionText(token.Mid(equals + 1).Trim().Trim(false));
+		if (channel.name.IsEmpty())
+			channel.name = expressionText;
+
+		std::shared_ptr<CompiledExpression> expression(
+			std::make_shared<CompiledExpression>(ThreadPool::GetSharedPool()));
+		std::string expressionError;
+		if (!expression->Compile(std::string(expressionText.ToUTF8()), expressionError))
+		{
+			error = std::string(expressionText.ToUTF8()) + ":  " + expressionError;
+			return false;
+		}
+
+		channel.expression = expression;
+		channels.push_back(channel);
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ProcessFile
+//
+// Description:		Loads one file, processes the selected channels and
+//					writes the requested outputs.  Called on pool threads.
+//
+// Input Arguments:
+//		loader		= DelimitedFileLoader&
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::ProcessFile(DelimitedFileLoader &loader,
+	const wxString &fileName, std::string &error) const
+{
+	PerfMonitor::ScopedTimer timer("Process file");
+
+	if (!loader.CanLoad(fileName))
+	{
+		error = "missing, or uses a custom format which requires the GUI";
+		return false;
+	}
+
+	wxArrayString fileList, failedFiles;
+	fileList.Add(fileName);
+	std::vector<DelimitedFileLoader::LoadedFile> loaded(loader.Load(fileList, failedFiles));
+	if (loaded.empty())
+	{
+		error = "not delimited numeric data";
+		return false;
+	}
+
+	DelimitedFileLoader::LoadedFile& file(loaded.front());
+	std::vector<unsigned int> channels;
+	if (!SelectChannels(file.descriptions, channels, error))
+		return false;
+
+	wxArrayString names;
+	std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> curves(channels.size());
+	for (const auto& channel : channels)
+		names.Add(file.descriptions[channel]);
+
+	for (const auto& derivedChannel : mDerivedChannels)
+	{
+		std::unique_ptr<LibPlot2D::Dataset2D> curve(
+			Evaluate(*derivedChannel.expression, file.columns, error));
+		if (!curve)
+			return false;
+
+		names.Add(derivedChannel.name);
+		curves.push_back(std::move(curve));
+	}
+
+	ThreadPool::GetSharedPool().ParallelFor(channels.size(), 1,
+		[&file, &channels, &curves](const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+			curves[i] = DelimitedFileLoader::CreateDataset(file, channels[i]);
+	});
+
+	// Filters run over all of the curves together; other operations are
+	// applied to each curve concurrently
+	for (const auto& operation : mOperations)
+	{
+		if (operation.type == Operation::Type::LowPass ||
+			operation.type == Operation::Type::HighPass)
+		{
+			if (!ApplyFilter(operation, curves, error))
+				return false;
+			continue;
+		}
+
+		ThreadPool::GetSharedPool().ParallelFor(curves.size(), 1,
+			[&operation, &curves](const size_t &begin, const size_t &end)
+		{
+			size_t i;
+			for (i = begin; i < end; ++i)
+				curves[i] = Apply(operation, *curves[i]);
+		});
+	}
+
+	if (!mCSVDirectory.IsEmpty() &&
+		!WriteCSV(GetOutputFileName(mCSVDirectory, fileName, _T("csv")), names, curves))
+	{
+		error = "failed to write CSV";
+		return false;
+	}
+
+	if (!mSpectrogramDirectory.IsEmpty() && !WriteSpectrogram(
+		GetOutputFileName(mSpectrogramDirectory, fileName, _T("csv")), names, curves, error))
+		return false;
+
+	if (!mPNGDirectory.IsEmpty())
+	{
+		SoftwareRenderer renderer(mImageWidth, mImageHeight);
+		for (const auto& curve : curves)
+			renderer.AddCurve(*curve);
+
+		if (!renderer.SavePNG(GetOutputFileName(mPNGDirectory, fileName, _T("png"))))
+		{
+			error = "failed to write PNG";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		SelectChannels
+//
+// Description:		Finds the requested channels.  Each may be given by
+//					name (exact, or failing that ignoring case) or by its
+//					one-based number.
+//
+// Input Arguments:
+//		descriptions	= const wxArrayString&
+//
+// Output Arguments:
+//		channels		= std::vector<unsigned int>&, indices into descriptions
+//		error			= std::string&
+//
+// Return Value:
+//		bool, true if all were found
+//
+//==========================================================================
+bool BatchProcessor::SelectChannels(const wxArrayString &descriptions,
+	std::vector<unsigned int> &channels, std::string &error) const
+{
+	unsigned int i;
+	if (mChannels.IsEmpty())
+	{
+		for (i = 0; i < descriptions.GetCount(); ++i)
+			channels.push_back(i);
+		return true;
+	}
+
+	for (const auto& channel : mChannels)
+	{
+		int index(descriptions.Index(channel, true));
+		if (index == wxNOT_FOUND)
+			index = descriptions.Index(channel, false);
+
+		unsigned long number;
+		if (index == wxNOT_FOUND && channel.ToULong(&number) &&
+			number >= 1 && number <= descriptions.GetCount())
+			index = static_cast<int>(number - 1);
+
+		if (index == wxNOT_FOUND)
+		{
+			error = "no channel " + std::string(channel.ToUTF8());
+			return false;
+		}
+
+		channels.push_back(static_cast<unsigned int>(index));
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Apply
+//
+// Description:		Applies one operation (other than a filter) to a curve.
+//					The PSD of a curve which is shorter than the smallest
+//					window is empty.
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		data		= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> BatchProcessor::Apply(
+	const Operation &operation, const LibPlot2D::Dataset2D &data)
+{
+	const SignalOperations signalOperations(ThreadPool::GetSharedPool());
+	switch (operation.type)
+	{
+	case Operation::Type::Derivative:
+		return signalOperations.Derivative(data);
+
+	case Operation::Type::Integral:
+		return signalOperations.Integral(data);
+
+	case Operation::Type::RMS:
+		return signalOperations.RootMeanSquare(data);
+
+	case Operation::Type::FFT:
+		return std::unique_ptr<LibPlot2D::Dataset2D>(new LibPlot2D::Dataset2D(
+			LibPlot2D::FastFourierTransform::ComputeFFT(data)));
+
+	case Operation::Type::PSD:
+	{
+		std::unique_ptr<LibPlot2D::Dataset2D> density(SpectralAnalysis(
+			ThreadPool::GetSharedPool(), operation.windowSize).PowerSpectralDensity(data));
+		if (!density)
+			density.reset(new LibPlot2D::Dataset2D(0));
+		return density;
+	}
+
+	default:
+		break;
+	}
+
+	return std::unique_ptr<LibPlot2D::Dataset2D>(new LibPlot2D::Dataset2D(data));
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		ApplyFilter
+//
+// Description:		Filters the curves in place.  Filters are second order
+//					with a damping ratio of one.  Curves with the same length
+//					and sample rate (normally all of them) share one filter
+//					and are processed together.
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		curves		= const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>>&
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::ApplyFilter(const Operation &operation,
+	const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves, std::string &error)
+{
+	std::map<std::pair<double, unsigned int>, std::vector<double*>> groups;
+	for (const auto& curve : curves)
+	{
+		const unsigned int count(curve->GetNumberOfPoints());
+		if (count < 2 || curve->GetXData(count - 1) <= curve->GetXData(0))
+			continue;
+
+		const double sampleRate((count - 1) / (curve->GetXData(count - 1) - curve->GetXData(0)));
+		groups[std::make_pair(sampleRate, count)].push_back(curve->GetYPointer());
+	}
+
+	const double wc(2.0 * M_PI * operation.frequency);
+	const double zeta(1.0);
+	std::vector<double> numerator, denominator;
+	denominator.push_back(1.0);
+	denominator.push_back(2.0 * zeta * wc);
+	denominator.push_back(wc * wc);
+	if (operation.type == Operation::Type::LowPass)
+		numerator.push_back(wc * wc);
+	else
+	{
+		numerator.push_back(1.0);
+		numerator.push_back(0.0);
+		numerator.push_back(0.0);
+	}
+
+	for (const auto& group : groups)
+	{
+		BiquadFilter filter(ThreadPool::GetSharedPool());
+		if (!filter.Design(group.first.first, numerator, denominator, error))
+			return false;
+		filter.Apply(group.second, group.first.second, operation.zeroPhase);
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		Evaluate
+//
+// Description:		Computes a derived channel from a file's columns.  The
+//					expression runs over the columns in place (on the pool),
+//					writing straight into the new dataset.
+//
+// Input Arguments:
+//		expression	= const CompiledExpression&
+//		columns		= const std::vector<SharedColumn>&, time column first
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>, nullptr if the expression
+//		refers to a column the file doesn't have
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> BatchProcessor::Evaluate(
+	const CompiledExpression &expression, const std::vector<SharedColumn> &columns,
+	std::string &error)
+{
+	std::vector<const double*> data(columns.size());
+	for (const auto& column : expression.GetColumns())
+	{
+		if (column >= columns.size() || !columns[column].GetData())
+		{
+			error = "no channel " + std::to_string(column);
+			return nullptr;
+		}
+
+		data[column] = columns[column].GetData();
+	}
+
+	const unsigned int count(static_cast<unsigned int>(columns.front().GetSize()));
+	std::unique_ptr<LibPlot2D::Dataset2D> result(new LibPlot2D::Dataset2D(count));
+	memcpy(result->GetXPointer(), columns.front().GetData(), sizeof(double) * count);
+	expression.Evaluate(data, 0, count, result->GetYPointer());
+	return result;
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		WriteCSV
+//
+// Description:		Writes the processed curves.  Curves that share their
+//					x-data share a single x column; otherwise each curve gets
+//					its own.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		names		= const wxArrayString&
+//		curves		= const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::WriteCSV(const wxString &fileName, const wxArrayString &names,
+	const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves) const
+{
+	std::ofstream file(fileName.fn_str());
+	if (!file.is_open())
+		return false;
+
+	file.precision(std::numeric_limits<double>::digits10);
+
+	bool sharedX(true);
+	unsigned int rowCount(0);
+	unsigned int c;
+	for (c = 0; c < curves.size(); ++c)
+	{
+		rowCount = std::max(rowCount, curves[c]->GetNumberOfPoints());
+		sharedX = sharedX && curves[c]->GetNumberOfPoints() == curves.front()->GetNumberOfPoints()
+			&& std::equal(curves[c]->GetXPointer(), curves[c]->GetXPointer()
+			+ curves[c]->GetNumberOfPoints(), curves.front()->GetXPointer());
+	}
+
+	const bool frequencyDomain(std::find_if(mOperations.begin(), mOperations.end(),
+		[](const Operation &operation)
+	{
+		return operation.type == Operation::Type::FFT || operation.type == Operation::Type::PSD;
+	}) != mOperations.end());
+	const std::string xName(frequencyDomain ? "Frequency [Hz]" : "Time");
+
+	if (sharedX)
+		file << xName;
+	for (c = 0; c < curves.size(); ++c)
+	{
+		const std::string name(names[c].ToUTF8());
+		if (c > 0 || sharedX)
+			file << ',';
+		if (!sharedX)
+			file << name << ' ' << xName << ',';
+		file << name;
+	}
+	file << '\n';
+
+	unsigned int r;
+	for (r = 0; r < rowCount; ++r)
+	{
+		if (sharedX)
+			file << curves.front()->GetXData(r);
+		for (c = 0; c < curves.size(); ++c)
+		{
+			if (c > 0 || sharedX)
+				file << ',';
+			if (r >= curves[c]->GetNumberOfPoints())
+			{
+				if (!sharedX)
+					file << ',';
+				continue;
+			}
+
+			if (!sharedX)
+				file << curves[c]->GetXData(r) << ',';
+			file << curves[c]->GetYData(r);
+		}
+		file << '\n';
+	}
+
+	return static_cast<bool>(file);
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		WriteSpectrogram
+//
+// Description:		Writes the spectrogram of each curve, one row per time
+//					slice and frequency, with a PSD column for each curve.
+//					All curves must have the same length and sample rate.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		names		= const wxArrayString&
+//		curves		= const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>>&
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BatchProcessor::WriteSpectrogram(const wxString &fileName, const wxArrayString &names,
+	const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves, std::string &error)
+{
+	const SpectralAnalysis analysis(ThreadPool::GetSharedPool());
+	std::vector<SpectralAnalysis::Spectrogram> spectrograms(curves.size());
+	unsigned int c;
+	for (c = 0; c < curves.size(); ++c)
+	{
+		if (!analysis.ComputeSpectrogram(curves[c]->GetYPointer(),
+			curves[c]->GetNumberOfPoints(), SpectralAnalysis::GetSampleRate(*curves[c]),
+			SpectralAnalysis::defaultSliceCount, spectrograms[c]))
+		{
+			error = "too few samples for a spectrogram of " + std::string(names[c].ToUTF8());
+			return false;
+		}
+		else if (spectrograms[c].time != spectrograms.front().time ||
+			spectrograms[c].frequency != spectrograms.front().frequency)
+		{
+			error = "channels must have the same sample rate for a spectrogram";
+			return false;
+		}
+	}
+
+	std::ofstream file(fileName.fn_str());
+	if (!file.is_open())
+	{
+		error = "failed to write spectrogram";
+		return false;
+	}
+
+	file.precision(std::numeric_limits<double>::digits10);
+	file << "Time [sec],Frequency [Hz]";
+	for (c = 0; c < curves.size(); ++c)
+		file << ',' << names[c].ToUTF8().data();
+	file << '\n';
+
+	if (curves.empty())
+		return static_cast<bool>(file);
+
+	const std::vector<double> &time(spectrograms.front().time);
+	const std::vector<double> &frequency(spectrograms.front().frequency);
+	size_t t, k;
+	for (t = 0; t < time.size(); ++t)
+	{
+		for (k = 0; k < frequency.size(); ++k)
+		{
+			file << time[t] << ',' << frequency[k];
+			for (c = 0; c < curves.size(); ++c)
+				file << ',' << spectrograms[c].density[t * frequency.size() + k];
+			file << '\n';
+		}
+	}
+
+	if (!file)
+		error = "failed to write spectrogram";
+	return static_cast<bool>(file);
+}
+
+//==========================================================================
+// Class:			BatchProcessor
+// Function:		GetOutputFileName
+//
+// Description:		Returns the name of an output file, which is named after
+//					the input file.
+//
+// Input Arguments:
+//		directory		= const wxString&
+//		inputFileName	= const wxString&
+//		extension		= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString BatchProcessor::GetOutputFileName(const wxString &directory,
+	const wxString &inputFileName, const wxString &extension)
+{
+	return directory + wxFileName::GetPathSeparator()
+		+ wxFileName(inputFileName).GetName() + _T(".") + extension;
+}
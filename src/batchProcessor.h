@@ -0,0 +1,124 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  batchProcessor.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Command-line mode which loads files, applies a chain of signal
+//				 operations to the selected channels and exports the results as
+//				 CSV and/or PNG, without creating any windows.
+// History:
+
+#ifndef BATCH_PROCESSOR_H_
+#define BATCH_PROCESSOR_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <memory>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/cmdline.h>
+
+// Local headers
+#include "utilities/sharedColumn.h"
+
+// Local forward declarations
+class DelimitedFileLoader;
+class CompiledExpression;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Headless processing of data files
+class BatchProcessor
+{
+public:
+	// True if the arguments request batch mode, in which case no GUI may be
+	// initialized
+	static bool IsBatchMode(const int &argc, wxChar **argv);
+
+	// Returns the exit code for the process
+	int Run(const int &argc, wxChar **argv);
+
+private:
+	static const wxCmdLineEntryDesc mCommandLineDescription[];
+	static const int mProcessingError;
+	static const int mUsageError;
+	static const long mDefaultImageWidth;
+	static const long mDefaultImageHeight;
+
+	struct Operation
+	{
+		enum class Type
+		{
+			LowPass,
+			HighPass,
+			Derivative,
+			Integral,
+			RMS,
+			FFT,
+			PSD
+		};
+
+		Type type;
+		double frequency;// [Hz], filters only
+		bool zeroPhase;// Filters only
+		size_t windowSize;// [samples], PSD only
+	};
+
+	wxArrayString mFiles;
+	wxArrayString mChannels;// Empty for all
+	std::vector<Operation> mOperations;
+
+	// Computed from the file's columns, then processed like the channels
+	struct DerivedChannel
+	{
+		wxString name;
+		std::shared_ptr<const CompiledExpression> expression;
+	};
+
+	std::vector<DerivedChannel> mDerivedChannels;
+	wxString mPNGDirectory;
+	wxString mCSVDirectory;
+	wxString mSpectrogramDirectory;
+	wxString mTraceFileName;
+	long mImageWidth = mDefaultImageWidth;
+	long mImageHeight = mDefaultImageHeight;
+
+	bool ReadCommandLine(const wxCmdLineParser &parser);
+	static bool ParseOperations(const wxString &chain, std::vector<Operation> &operations);
+	static bool ParseDerivedChannels(const wxString &list,
+		std::vector<DerivedChannel> &channels, std::string &error);
+
+	bool ProcessFile(DelimitedFileLoader &loader, const wxString &fileName,
+		std::string &error) const;
+	bool SelectChannels(const wxArrayString &descriptions,
+		std::vector<unsigned int> &channels, std::string &error) const;
+	static std::unique_ptr<LibPlot2D::Dataset2D> Apply(const Operation &operation,
+		const LibPlot2D::Dataset2D &data);
+	static bool ApplyFilter(const Operation &operation,
+		const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves, std::string &error);
+	static std::unique_ptr<LibPlot2D::Dataset2D> Evaluate(const CompiledExpression &expression,
+		const std::vector<SharedColumn> &columns, std::string &error);
+
+	bool WriteCSV(const wxString &fileName, const wxArrayString &names,
+		const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves) const;
+	static bool WriteSpectrogram(const wxString &fileName, const wxArrayString &names,
+		const std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> &curves,
+		std::string &error);
+	static wxString GetOutputFileName(const wxString &directory,
+		const wxString &inputFileName, const wxString &extension);
+};
+
+#endif// BATCH_PROCESSOR_H_
@@ -0,0 +1,104 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  benchMain.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Entry point for the benchmark executable (built by "make bench").
+// History:
+
+// Standard C++ headers
+#include <iostream>
+#include <fstream>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/cmdline.h>
+
+// Local headers
+#include "bench/benchmark.h"
+#include "utilities/threadPool.h"
+
+//==========================================================================
+// Class:			None
+// Function:		main
+//
+// Description:		Runs the benchmark and writes the results as JSON to
+//					stdout or to the specified file.
+//
+// Input Arguments:
+//		argc	= int
+//		argv	= char*[]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, zero for success
+//
+//==========================================================================
+int main(int argc, char* argv[])
+{
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk())
+	{
+		std::cerr << "Failed to initialize wxWidgets" << std::endl;
+		return 1;
+	}
+
+	const wxCmdLineEntryDesc description[] = {
+		{ wxCMD_LINE_OPTION, "m", "max-exponent", "largest signal has 10^N points (default 8)",
+			wxCMD_LINE_VAL_NUMBER, 0 },
+		{ wxCMD_LINE_OPTION, "o", "output", "file to which the JSON is written (default stdout)",
+			wxCMD_LINE_VAL_STRING, 0 },
+		{ wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE,
+			wxCMD_LINE_OPTION_HELP },
+		{ wxCMD_LINE_NONE, nullptr, nullptr, nullptr, wxCMD_LINE_VAL_NONE, 0 }
+	};
+
+	wxCmdLineParser parser(description, argc, argv);
+	const int parseResult(parser.Parse());
+	if (parseResult == -1)
+		return 0;
+	else if (parseResult != 0)
+		return 2;
+
+	long maxExponent(8);
+	parser.Found(_T("m"), &maxExponent);
+	if (maxExponent < static_cast<long>(Benchmark::minExponent) || maxExponent > 9)
+	{
+		std::cerr << "max-exponent must be between " << Benchmark::minExponent
+			<< " and 9" << std::endl;
+		return 2;
+	}
+
+	// Timings are meaningless if the parser is wrong
+	if (!Benchmark::CheckParser() || !Benchmark::CheckConversion())
+		return 1;
+
+	Benchmark benchmark(ThreadPool::GetSharedPool(), static_cast<unsigned int>(maxExponent));
+	benchmark.Run();
+
+	wxString outputFileName;
+	if (!parser.Found(_T("o"), &outputFileName))
+	{
+		benchmark.WriteJSON(std::cout);
+		return 0;
+	}
+
+	std::ofstream file(outputFileName.ToUTF8().data());
+	benchmark.WriteJSON(file);
+	if (!file.good())
+	{
+		std::cerr << "Failed to write " << outputFileName.ToUTF8().data() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
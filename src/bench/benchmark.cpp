@@ -0,0 +1,846 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  benchmark.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Times file parsing, the signal operations and off-screen
+//				 rendering on synthetic signals of increasing length, and
+//				 reports the results as JSON.
+// History:
+
+// Standard C++ headers
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+
+// wxWidgets headers
+#include <wx/filename.h>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+#include <lp2d/utilities/signals/derivative.h>
+#include <lp2d/utilities/signals/integral.h>
+#include <lp2d/utilities/signals/rms.h>
+#include <lp2d/utilities/signals/fft.h>
+#include <lp2d/utilities/signals/filter.h>
+
+// Local headers
+#include "bench/benchmark.h"
+#include "parser/delimitedFileLoader.h"
+#include "parser/delimitedParser.h"
+#include "parser/customFormatMatcher.h"
+#include "renderer/decimationPyramid.h"
+#include "renderer/softwareRenderer.h"
+#include "signals/signalOperations.h"
+#include "signals/compiledExpression.h"
+#include "signals/biquadFilter.h"
+#include "signals/spectralAnalysis.h"
+#include "signals/vectorKernels.h"
+#include "utilities/threadPool.h"
+
+#ifndef LP2D_VERSION
+#define LP2D_VERSION "unknown"
+#endif
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for Benchmark class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const unsigned int Benchmark::minExponent(4);
+const double Benchmark::mMinimumTime(0.5);// [sec]
+const unsigned int Benchmark::mMinimumRepetitions(3);
+const unsigned int Benchmark::mImageWidth(1920);// [pixels]
+const unsigned int Benchmark::mImageHeight(1080);// [pixels]
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		Benchmark
+//
+// Description:		Constructor for Benchmark class.
+//
+// Input Arguments:
+//		pool		= ThreadPool&
+//		maxExponent	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Benchmark::Benchmark(ThreadPool &pool, const unsigned int &maxExponent)
+	: mPool(pool), mMaxExponent(maxExponent)
+{
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		CheckParser
+//
+// Description:		Parses text with blank lines (including lines of tabs
+//					and spaces, which are delimiters too) with each delimiter,
+//					and compares the rows written with the rows counted.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if every case passed
+//
+//==========================================================================
+bool Benchmark::CheckParser()
+{
+	const char delimiters[] = { ',', ';', '\t', ' ' };
+	const double expectedX[] = { 1.0, 3.0, 5.0, 7.0 };
+	const size_t expectedRows(sizeof(expectedX) / sizeof(expectedX[0]));
+	const double guard(-12345.0);
+	bool passed(true);
+	for (const auto& delimiter : delimiters)
+	{
+		// Blank lines of tabs and spaces contain the delimiter when it is one of those
+		const std::string d(1, delimiter);
+		const std::string text("1" + d + "2\n"
+			"\n"
+			"\t\n"
+			" \t \r\n"
+			"3" + d + "4\r\n"
+			"\t\t\n"
+			"5" + d + "6\n"
+			"  \n"
+			"7" + d + "8\n"
+			"\t");
+
+		DelimitedParser::Layout layout;
+		layout.delimiter = delimiter;
+		layout.columnCount = 2;
+
+		// Sized from the count like the loaders' columns, with one more value to
+		// detect rows written past the end
+		const size_t rows(DelimitedParser::CountRows(text.data(), text.data() + text.size()));
+		std::vector<double> x(rows + 1, guard), y(rows + 1, guard);
+		double* const columns[] = { x.data(), y.data() };
+		DelimitedParser::ParseRows(text.data(), text.data() + text.size(), layout, columns);
+
+		bool rowsMatch(rows == expectedRows && x[rows] == guard && y[rows] == guard);
+		size_t i;
+		for (i = 0; i < expectedRows && rowsMatch; ++i)
+			rowsMatch = x[i] == expectedX[i] && y[i] == expectedX[i] + 1.0;
+
+		if (rowsMatch)
+			continue;
+
+		std::cerr << "DelimitedParser check failed with delimiter '"
+			<< (delimiter == '\t' ? std::string("\\t") : d) << "': counted " << rows
+			<< " rows (expected " << expectedRows << ")" << std::endl;
+		passed = false;
+	}
+
+	return passed;
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		CheckConversion
+//
+// Description:		Converts random 17 significant digit values (the most
+//					needed to round-trip a double), random values short
+//					enough for ToDouble()'s fast path and the values at the
+//					edges of that path, and compares them bit for bit with
+//					strtod.  Each is tried with a decimal comma, too.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if every value matched
+//
+//==========================================================================
+bool Benchmark::CheckConversion()
+{
+	std::vector<std::string> values = {
+		"0", "-0", "-0.0", "+0.0", "0.1", "-2.5", "1e-5", "1E5", "123.456e-2",
+		"9007199254740991", "9007199254740992", "9007199254740993",// 2^53 - 1, 2^53, 2^53 + 1
+		"18014398509481985", "9007199254740992.5",
+		"1e22", "1e23", "-1e22", "1e-22", "1e-23", "4.5e22", "123456789e15",
+		"9999999999999999999", "99999999999999999999", "0.30000000000000004",
+		"1.7976931348623157e308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+		"1e400", "1e-400" };
+
+	std::mt19937_64 generator(42);
+	char buffer[32];
+	unsigned int i;
+	for (i = 0; i < 100000; ++i)
+	{
+		// Any finite double, printed with enough digits to identify it
+		uint64_t bits(generator());
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		if (std::isfinite(value))
+		{
+			snprintf(buffer, sizeof(buffer), "%.17g", value);
+			values.push_back(buffer);
+		}
+
+		// Up to 15 digits with a decimal point and exponent in the exact range
+		const uint64_t mantissa(generator() % 1000000000000000ULL);
+		const int exponent(static_cast<int>(generator() % 45) - 22);
+		snprintf(buffer, sizeof(buffer), "%s%llue%d", generator() % 2 == 0 ? "-" : "",
+			static_cast<unsigned long long>(mantissa), exponent);
+		values.push_back(buffer);
+		snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(generator() % 10),
+			static_cast<double>(mantissa) * 1e-6);
+		values.push_back(buffer);
+	}
+
+	unsigned int failures(0);
+	for (const auto& text : values)
+	{
+		std::string commaText(text);
+		std::replace(commaText.begin(), commaText.end(), '.', ',');
+		if (!ConvertsLikeStrtod(text, '.') || !ConvertsLikeStrtod(commaText, ',') ||
+			!ConvertsLikeStrtod(" " + text + "\t", '.'))
+			++failures;
+
+		// Only the first few are described
+		if (failures > 10)
+			break;
+	}
+
+	return failures == 0;
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		ConvertsLikeStrtod
+//
+// Description:		Compares one conversion with strtod.  The text must use
+//					the C locale's decimal point, apart from the separator
+//					being tested.
+//
+// Input Arguments:
+//		text				= const std::string&
+//		decimalSeparator	= const char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the values are identical (including the sign of zero)
+//
+//==========================================================================
+bool Benchmark::ConvertsLikeStrtod(const std::string &text, const char &decimalSeparator)
+{
+	std::string cText(text);
+	std::replace(cText.begin(), cText.end(), decimalSeparator, '.');
+	const double expected(strtod(cText.c_str(), nullptr));
+
+	double value(0.0);
+	const bool converted(DelimitedParser::ToDouble(text.data(),
+		text.data() + text.size(), decimalSeparator, value));
+	if (converted && memcmp(&value, &expected, sizeof(value)) == 0)
+		return true;
+
+	std::cerr << std::setprecision(17) << "DelimitedParser::ToDouble() check failed for '"
+		<< text << "': got ";
+	if (converted)
+		std::cerr << value;
+	else
+		std::cerr << "no value";
+	std::cerr << ", strtod gives " << expected << std::endl;
+	return false;
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		Run
+//
+// Description:		Runs every case at every signal length.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::Run()
+{
+	mResults.clear();
+
+	size_t count(1);
+	unsigned int exponent;
+	for (exponent = 0; exponent < minExponent; ++exponent)
+		count *= 10;
+
+	for (exponent = minExponent; exponent <= mMaxExponent; ++exponent, count *= 10)
+	{
+		std::cerr << "Generating " << count << " points" << std::endl;
+		std::unique_ptr<LibPlot2D::Dataset2D> data(CreateSignal(count));
+
+		TimeParse(*data);
+		TimeConversion(*data);
+		TimeOperations(*data);
+		TimeRender(*data);
+	}
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		WriteJSON
+//
+// Description:		Writes the results.
+//
+// Input Arguments:
+//		out	= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::WriteJSON(std::ostream &out) const
+{
+	out << "{\n";
+	out << "  \"lp2dVersion\": \"" << Escape(LP2D_VERSION) << "\",\n";
+	out << "  \"threads\": " << mPool.GetThreadCount() << ",\n";
+	out << "  \"avx2\": " << (VectorKernels::UsingAVX2() ? "true" : "false") << ",\n";
+	out << "  \"results\": [";
+
+	out << std::setprecision(6);
+	unsigned int i;
+	for (i = 0; i < mResults.size(); ++i)
+	{
+		const Result& result(mResults[i]);
+		out << (i == 0 ? "\n" : ",\n");
+		out << "    { \"name\": \"" << Escape(result.name)
+			<< "\", \"variant\": \"" << Escape(result.variant)
+			<< "\", \"points\": " << result.points
+			<< ", \"repetitions\": " << result.repetitions
+			<< ", \"bestSeconds\": " << result.bestTime
+			<< ", \"meanSeconds\": " << result.meanTime
+			<< ", \"pointsPerSecond\": " << result.points / result.bestTime;
+		if (result.bytes > 0)
+			out << ", \"megabytesPerSecond\": " << result.bytes / result.bestTime / 1.0e6;
+		out << " }";
+	}
+
+	out << "\n  ]\n}\n";
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		CreateSignal
+//
+// Description:		Creates a noisy sum of two sine waves, sampled at
+//					1 kHz with some jitter.
+//
+// Input Arguments:
+//		count	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> Benchmark::CreateSignal(const size_t &count)
+{
+	std::unique_ptr<LibPlot2D::Dataset2D> data(
+		new LibPlot2D::Dataset2D(static_cast<unsigned int>(count)));
+	double* x(data->GetXPointer());
+	double* y(data->GetYPointer());
+
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> noise(-1.0, 1.0);
+	const double dt(0.001);// [sec]
+	const double f1(5.0 * 2.0 * M_PI);// [rad/sec]
+	const double f2(60.0 * 2.0 * M_PI);// [rad/sec]
+
+	size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		x[i] = (i + 0.1 * noise(generator)) * dt;
+		y[i] = 2.0 * sin(f1 * x[i]) + 0.5 * sin(f2 * x[i]) + 0.1 * noise(generator);
+	}
+
+	return data;
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		TimeParse
+//
+// Description:		Times loading the signal from a CSV file.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::TimeParse(const LibPlot2D::Dataset2D &data)
+{
+	const wxString fileName(wxFileName(wxFileName::GetTempDir(),
+		_T("DataPlotterBench.csv")).GetFullPath());
+	{
+		std::ofstream file(fileName.ToUTF8().data());
+		file << "Time,Signal\n" << std::setprecision(9);
+		unsigned int i;
+		for (i = 0; i < data.GetNumberOfPoints(); ++i)
+			file << data.GetXData(i) << ',' << data.GetYData(i) << '\n';
+	}
+
+	CustomFormatMatcher formats;
+	DelimitedFileLoader loader(mPool, formats);
+	wxArrayString fileList;
+	fileList.Add(fileName);
+
+	Time("parse", "csv", data.GetNumberOfPoints(), [&loader, &fileList]()
+	{
+		wxArrayString failedFiles;
+		loader.Load(fileList, failedFiles);
+	});
+
+	wxRemoveFile(fileName);
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		TimeConversion
+//
+// Description:		Times converting the signal from text already in memory,
+//					both the way we used to (finding each token and passing
+//					it to strtod()) and with DelimitedParser.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::TimeConversion(const LibPlot2D::Dataset2D &data)
+{
+	const size_t count(data.GetNumberOfPoints());
+	std::ostringstream stream;
+	stream << std::setprecision(9);
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		stream << data.GetXData(i) << ',' << data.GetYData(i) << '\n';
+	const std::string text(stream.str());
+
+	std::string decimalCommaText(text);
+	for (auto& c : decimalCommaText)
+	{
+		if (c == ',')
+			c = ';';
+		else if (c == '.')
+			c = ',';
+	}
+
+	std::vector<double> x(count), y(count);
+	double* const columns[] = { x.data(), y.data() };
+	Time("convert", "strtod", count, [&text, &columns]()
+	{
+		const char* p(text.data());
+		const char* end(p + text.size());
+		size_t row(0);
+		char buffer[64];
+		while (p < end)
+		{
+			const char* lineEnd(static_cast<const char*>(memchr(p, '\n', end - p)));
+			if (!lineEnd)
+				lineEnd = end;
+
+			unsigned int c;
+			for (c = 0; c < 2 && p < lineEnd; ++c)
+			{
+				const char* tokenEnd(static_cast<const char*>(memchr(p, ',', lineEnd - p)));
+				if (!tokenEnd)
+					tokenEnd = lineEnd;
+
+				const size_t length(std::min<size_t>(tokenEnd - p, sizeof(buffer) - 1));
+				memcpy(buffer, p, length);
+				buffer[length] = '\0';
+				columns[c][row] = strtod(buffer, nullptr);
+				p = tokenEnd + 1;
+			}
+
+			++row;
+			p = lineEnd + 1;
+		}
+	}, text.size());
+
+	DelimitedParser::Layout layout;
+	layout.columnCount = 2;
+	Time("convert", "DelimitedParser", count, [&text, &layout, &columns]()
+	{
+		DelimitedParser::ParseRows(text.data(), text.data() + text.size(), layout, columns);
+	}, text.size());
+
+	DelimitedParser::Layout decimalCommaLayout;
+	decimalCommaLayout.delimiter = ';';
+	decimalCommaLayout.decimalSeparator = ',';
+	decimalCommaLayout.columnCount = 2;
+	Time("convert", "DelimitedParser (decimal comma)", count,
+		[&decimalCommaText, &decimalCommaLayout, &columns]()
+	{
+		DelimitedParser::ParseRows(decimalCommaText.data(),
+			decimalCommaText.data() + decimalCommaText.size(), decimalCommaLayout, columns);
+	}, decimalCommaText.size());
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		TimeOperations
+//
+// Description:		Times the LibPlot2D signal operations, and our own
+//					versions of those we have.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::TimeOperations(const LibPlot2D::Dataset2D &data)
+{
+	const size_t count(data.GetNumberOfPoints());
+	Time("fft", "lp2d", count, [&data]()
+	{
+		LibPlot2D::FastFourierTransform::ComputeFFT(data);
+	});
+
+	const SpectralAnalysis analysis(ThreadPool::GetSharedPool());
+	Time("psd", "SpectralAnalysis", count, [&analysis, &data]()
+	{
+		analysis.PowerSpectralDensity(data);
+	});
+
+	Time("lowpass", "lp2d", count, [&data, count]()
+	{
+		const double sampleRate((count - 1) / (data.GetXData(count - 1) - data.GetXData(0)));
+		const double wc(2.0 * M_PI * sampleRate * 0.05);
+		const std::vector<double> numerator(1, wc * wc);
+		std::vector<double> denominator;
+		denominator.push_back(1.0);
+		denominator.push_back(2.0 * wc);
+		denominator.push_back(wc * wc);
+
+		LibPlot2D::Filter filter(sampleRate, numerator, denominator, data.GetYData(0));
+		LibPlot2D::Dataset2D result(data);
+		double* y(result.GetYPointer());
+		size_t i;
+		for (i = 0; i < count; ++i)
+			y[i] = filter.Apply(y[i]);
+	});
+
+	// The same filter on several channels, as when filtering a whole file
+	const double sampleRate((count - 1) / (data.GetXData(count - 1) - data.GetXData(0)));
+	const double wc(2.0 * M_PI * sampleRate * 0.05);
+	const std::vector<double> numerator(1, wc * wc);
+	std::vector<double> denominator;
+	denominator.push_back(1.0);
+	denominator.push_back(2.0 * wc);
+	denominator.push_back(wc * wc);
+
+	const size_t channelCount(16);
+	std::vector<std::vector<double>> channels(channelCount,
+		std::vector<double>(data.GetYPointer(), data.GetYPointer() + count));
+	Time("lowpass (16 channels)", "lp2d", count * channelCount,
+		[&channels, &numerator, &denominator, sampleRate]()
+	{
+		for (auto& channel : channels)
+		{
+			LibPlot2D::Filter filter(sampleRate, numerator, denominator, channel.front());
+			for (auto& value : channel)
+				value = filter.Apply(value);
+		}
+	});
+
+	BiquadFilter filter(mPool);
+	std::string designError;
+	filter.Design(sampleRate, numerator, denominator, designError);
+	std::vector<double*> channelPointers;
+	for (auto& channel : channels)
+		channelPointers.push_back(channel.data());
+
+	Time("lowpass", "BiquadFilter", count, [&filter, &data]()
+	{
+		filter.Apply(data, false);
+	});
+
+	Time("lowpass (16 channels)", "BiquadFilter", count * channelCount,
+		[&filter, &channelPointers, count]()
+	{
+		filter.Apply(channelPointers, count, false);
+	});
+
+	Time("lowpass (16 channels, zero phase)", "BiquadFilter", count * channelCount,
+		[&filter, &channelPointers, count]()
+	{
+		filter.Apply(channelPointers, count, true);
+	});
+
+	Time("rms", "lp2d", count, [&data]()
+	{
+		LibPlot2D::RootMeanSquare::ComputeTimeHistory(data);
+	});
+
+	Time("integral", "lp2d", count, [&data]()
+	{
+		LibPlot2D::DiscreteIntegral::ComputeTimeHistory(data);
+	});
+
+	Time("derivative", "lp2d", count, [&data]()
+	{
+		LibPlot2D::DiscreteDerivative::ComputeTimeHistory(data);
+	});
+
+	const SignalOperations operations(mPool);
+	Time("rms", "SignalOperations", count, [&operations, &data]()
+	{
+		operations.RootMeanSquare(data);
+	});
+
+	Time("integral", "SignalOperations", count, [&operations, &data]()
+	{
+		operations.Integral(data);
+	});
+
+	Time("derivative", "SignalOperations", count, [&operations, &data]()
+	{
+		operations.Derivative(data);
+	});
+
+	// y^2 - 2y + 1, with a full-length temporary per step vs. compiled
+	Time("expression", "SignalOperations", count, [&operations, &data]()
+	{
+		operations.Subtract(*operations.Multiply(data, data),
+			*operations.ScaleAndOffset(data, 2.0, -1.0));
+	});
+
+	CompiledExpression expression(mPool);
+	std::string error;
+	expression.Compile("[1]*[1]-2*[1]+1", error);
+	const std::vector<const double*> columns({ data.GetXPointer(), data.GetYPointer() });
+	std::vector<double> result(count);
+	Time("expression", "CompiledExpression", count, [&expression, &columns, &result, count]()
+	{
+		expression.Evaluate(columns, 0, count, result.data());
+	});
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		TimeRender
+//
+// Description:		Times off-screen rendering of the signal, both with
+//					every point drawn and decimated to the image width the
+//					way the plot draws large curves.  Also times finding
+//					the y-range of part of the signal with and without the
+//					decimation pyramid.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::TimeRender(const LibPlot2D::Dataset2D &data)
+{
+	const size_t count(data.GetNumberOfPoints());
+	Time("render", "full", count, [&data]()
+	{
+		SoftwareRenderer renderer(mImageWidth, mImageHeight);
+		renderer.AddCurve(data);
+		renderer.Render();
+	});
+
+	std::unique_ptr<DecimationPyramid> pyramid;
+	Time("decimationPyramid", "build", count, [this, &data, &pyramid, count]()
+	{
+		pyramid.reset(new DecimationPyramid(data.GetXPointer(),
+			data.GetYPointer(), count, mPool));
+	});
+
+	// Y-range of the middle third, as when fitting the y-axis to a zoomed view
+	const double rangeMin(data.GetXData(static_cast<unsigned int>(count / 3)));
+	const double rangeMax(data.GetXData(static_cast<unsigned int>(2 * count / 3)));
+	Time("yRange", "scan", count, [&data, count, rangeMin, rangeMax]()
+	{
+		double yMin(std::numeric_limits<double>::max());
+		double yMax(std::numeric_limits<double>::lowest());
+		unsigned int i;
+		for (i = 0; i < count; ++i)
+		{
+			if (data.GetXData(i) < rangeMin || data.GetXData(i) > rangeMax)
+				continue;
+			yMin = std::min(yMin, data.GetYData(i));
+			yMax = std::max(yMax, data.GetYData(i));
+		}
+	});
+
+	Time("yRange", "decimationPyramid", count, [&pyramid, rangeMin, rangeMax]()
+	{
+		double yMin, yMax;
+		pyramid->GetYRange(rangeMin, rangeMax, yMin, yMax);
+	});
+
+	Time("render", "decimated", count, [&data, &pyramid, count]()
+	{
+		std::vector<double> x, y;
+		pyramid->Decimate(data.GetXData(0), data.GetXData(count - 1), mImageWidth, x, y);
+
+		LibPlot2D::Dataset2D decimated(static_cast<unsigned int>(x.size()));
+		std::copy(x.begin(), x.end(), decimated.GetXPointer());
+		std::copy(y.begin(), y.end(), decimated.GetYPointer());
+
+		SoftwareRenderer renderer(mImageWidth, mImageHeight);
+		renderer.AddCurve(decimated);
+		renderer.Render();
+	});
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		Time
+//
+// Description:		Calls the function repeatedly and records the timing.
+//
+// Input Arguments:
+//		name		= const std::string&
+//		variant		= const std::string&
+//		points		= const size_t&
+//		function	= const std::function<void()>&
+//		bytes		= const size_t&, size of the text being read (if any)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Benchmark::Time(const std::string &name, const std::string &variant,
+	const size_t &points, const std::function<void()> &function,
+	const size_t &bytes)
+{
+	std::cerr << "  " << name << " (" << variant << ")" << std::flush;
+
+	Result result;
+	result.name = name;
+	result.variant = variant;
+	result.points = points;
+	result.bytes = bytes;
+	result.repetitions = 0;
+	result.bestTime = std::numeric_limits<double>::max();
+
+	double totalTime(0.0);
+	while (result.repetitions < mMinimumRepetitions || totalTime < mMinimumTime)
+	{
+		const auto start(std::chrono::steady_clock::now());
+		function();
+		const double elapsed(std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count());
+
+		result.bestTime = std::min(result.bestTime, elapsed);
+		totalTime += elapsed;
+		++result.repetitions;
+	}
+
+	result.meanTime = totalTime / result.repetitions;
+	mResults.push_back(result);
+
+	std::cerr << ":  " << result.bestTime << " sec" << std::endl;
+}
+
+//==========================================================================
+// Class:			Benchmark
+// Function:		Escape
+//
+// Description:		Escapes a string for use in JSON.
+//
+// Input Arguments:
+//		s	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string Benchmark::Escape(const std::string &s)
+{
+	std::ostringstream escaped;
+	for (const auto& c : s)
+	{
+		if (c == '"' || c == '\\')
+			escaped << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+				<< static_cast<int>(c) << std::dec;
+		else
+			escaped << c;
+	}
+
+	return escaped.str();
+}
@@ -0,0 +1,98 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  benchmark.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Times file parsing, the signal operations and off-screen
+//				 rendering on synthetic signals of increasing length, and
+//				 reports the results as JSON.
+// History:
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <ostream>
+
+// Local forward declarations
+class ThreadPool;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Performance benchmark
+class Benchmark
+{
+public:
+	// Signals have 10^4 to 10^maxExponent points
+	Benchmark(ThreadPool &pool, const unsigned int &maxExponent);
+
+	// Checks that DelimitedParser writes exactly the rows it counts (the
+	// column sizes depend on it); a description of any failure is written to
+	// std::cerr
+	static bool CheckParser();
+
+	// Checks that DelimitedParser::ToDouble() gives exactly the same values
+	// as strtod, with either decimal separator
+	static bool CheckConversion();
+
+	// Progress is written to std::cerr
+	void Run();
+	void WriteJSON(std::ostream &out) const;
+
+	static const unsigned int minExponent;
+
+private:
+	static const double mMinimumTime;// [sec]
+	static const unsigned int mMinimumRepetitions;
+	static const unsigned int mImageWidth;// [pixels]
+	static const unsigned int mImageHeight;// [pixels]
+
+	ThreadPool &mPool;
+	const unsigned int mMaxExponent;
+
+	struct Result
+	{
+		std::string name;
+		std::string variant;
+		size_t points;
+		size_t bytes;// Zero unless text is being read
+		unsigned int repetitions;
+		double bestTime;// [sec]
+		double meanTime;// [sec]
+	};
+
+	std::vector<Result> mResults;
+
+	static std::unique_ptr<LibPlot2D::Dataset2D> CreateSignal(const size_t &count);
+
+	void TimeParse(const LibPlot2D::Dataset2D &data);
+	void TimeConversion(const LibPlot2D::Dataset2D &data);
+	void TimeOperations(const LibPlot2D::Dataset2D &data);
+	void TimeRender(const LibPlot2D::Dataset2D &data);
+
+	// Calls function repeatedly (at least mMinimumRepetitions times and for
+	// at least mMinimumTime) and records the timing
+	void Time(const std::string &name, const std::string &variant,
+		const size_t &points, const std::function<void()> &function,
+		const size_t &bytes = 0);
+
+	static std::string Escape(const std::string &s);
+	static bool ConvertsLikeStrtod(const std::string &text, const char &decimalSeparator);
+};
+
+#endif// BENCHMARK_H_
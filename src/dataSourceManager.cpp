@@ -0,0 +1,3802 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dataSourceManager.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Decides how each data file is loaded and keeps track of where
+//				 the curves came from so they can be reloaded.  Very long curves
+//				 are handed to the plot in decimated form.
+// History:
+
+// Standard C++ headers
+#include <cstring>
+#include <algorithm>
+#include <set>
+#include <limits>
+#include <cmath>
+#include <chrono>
+#include <numeric>
+
+// wxWidgets headers
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/clipbrd.h>
+#include <wx/dataobj.h>
+#include <wx/progdlg.h>
+#include <wx/choicdlg.h>
+
+// LibPlot2D headers
+#include <lp2d/gui/guiInterface.h>
+#include <lp2d/renderer/plotRenderer.h>
+#include <lp2d/utilities/dataset2D.h>
+#include <lp2d/parser/customFileFormat.h>
+
+// Local headers
+#include "dataSourceManager.h"
+#include "signals/compiledExpression.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for DataSourceManager class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const unsigned int DataSourceManager::mInitialPixelColumns(2048);
+const wxString DataSourceManager::mCustomFormatsFileName(_T("CustomFormats.xml"));// Same file LibPlot2D reads
+const wxString DataSourceManager::mCustomFormatsCacheName(_T("customFormats.cache"));
+const wxString DataSourceManager::mColumnCacheDirectoryName(_T("DataPlotter"));
+const size_t DataSourceManager::mMaxStreamRows(1 << 16);
+const size_t DataSourceManager::mPasteProgressSize(4 << 20);
+const size_t DataSourceManager::mOutOfCoreBucketSize(1024);
+const double DataSourceManager::mDisplayPadding(1.0);// [view widths either side]
+const double DataSourceManager::mViewWidthTolerance(1.0e-6);// [fraction of view width]
+const unsigned int DataSourceManager::mUnparsedColumnCount(32);
+const size_t DataSourceManager::mAllRowsKept(std::numeric_limits<size_t>::max());
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		DataSourceManager
+//
+// Description:		Constructor for DataSourceManager class.  Starts
+//					reading the custom formats and registering LibPlot2D's
+//					file types on the pool.  Both read files from the user's
+//					home directory, which can be slow to reach; anything
+//					needing them waits for them.  The idle handler is woken
+//					when each finishes.
+//
+// Input Arguments:
+//		owner					= wxEvtHandler&
+//		plotInterface			= LibPlot2D::GuiInterface&
+//		decimationPointLimit	= const unsigned long long&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DataSourceManager::DataSourceManager(wxEvtHandler &owner,
+	LibPlot2D::GuiInterface &plotInterface,
+	const unsigned long long &decimationPointLimit) : mOwner(owner),
+	mPlotInterface(plotInterface), mLoader(ThreadPool::GetSharedPool(), mFormats),
+	mDecimationPointLimit(decimationPointLimit), mCustomDefinitionsExist(false),
+	mLoadProgress(0.0), mCancelLoad(false)
+{
+	ThreadPool& pool(ThreadPool::GetSharedPool());
+	mFormatsLoaded = pool.Enqueue([this]()
+	{
+		LoadCustomFormats(mFormats);
+		SetUpColumnCache(mLoader);
+		mOwner.CallAfter([this]()
+		{
+			LoadWaitingFiles();
+		});
+		wxWakeUpIdle();
+		return PerfMonitor::GetSharedMonitor().GetTime();
+	}).share();
+
+	// Only LibPlot2D's own loading and pasting use these, and they wait for it
+	mFileTypesRegistered = pool.Enqueue([this]()
+	{
+		mPlotInterface.RegisterAllBuiltInFileTypes();
+		mCustomDefinitionsExist = LibPlot2D::CustomFileFormat::CustomDefinitionsExist();
+		wxWakeUpIdle();
+		return PerfMonitor::GetSharedMonitor().GetTime();
+	}).share();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		~DataSourceManager
+//
+// Description:		Destructor for DataSourceManager class.  Waits for the
+//					start-up tasks and any reload or (cancelled) load that
+//					is still running on the pool.  Also defined
+//					here so Dataset2D is a complete type where the curves
+//					are freed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DataSourceManager::~DataSourceManager()
+{
+	WaitForFormats();
+	WaitForFileTypes();
+
+	if (mPendingReload.valid())
+		mPendingReload.wait();
+
+	if (mPendingLoad.valid())
+	{
+		CancelLoad();
+		mPendingLoad.wait();
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		IsStartupComplete
+//
+// Description:		Checks whether the custom formats have been read and
+//					LibPlot2D's file types have been registered.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::IsStartupComplete() const
+{
+	return AreFormatsLoaded() &&
+		mFileTypesRegistered.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AreFormatsLoaded
+//
+// Description:		Checks whether the custom formats have been read.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::AreFormatsLoaded() const
+{
+	return mFormatsLoaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadWaitingFiles
+//
+// Description:		Loads the files opened before the custom formats had
+//					been read.  Queued on the GUI thread by the start-up
+//					task just before it finishes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::LoadWaitingFiles()
+{
+	WaitForFormats();// Only until the start-up task returns
+
+	std::vector<std::pair<wxArrayString, wxWindow*>> waitingFiles;
+	waitingFiles.swap(mWaitingFiles);
+	for (const auto& files : waitingFiles)
+		LoadFiles(files.first, files.second);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadCustomFormats
+//
+// Description:		Loads the custom file format definitions.  The compiled
+//					form is cached in the user data directory and only
+//					rebuilt when the XML changes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		formats	= CustomFormatMatcher&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::LoadCustomFormats(CustomFormatMatcher &formats)
+{
+	const wxString cacheDirectory(wxStandardPaths::Get().GetUserDataDir());
+	if (!wxFileName::DirExists(cacheDirectory))
+		wxFileName::Mkdir(cacheDirectory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+	formats.Load(mCustomFormatsFileName, cacheDirectory
+		+ wxFileName::GetPathSeparator() + mCustomFormatsCacheName);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		SetUpColumnCache
+//
+// Description:		Points the loader at the user's cache directory, where
+//					binary copies of large parsed files are kept.  If the
+//					directory can't be created, files are always parsed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		loader	= DelimitedFileLoader&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::SetUpColumnCache(DelimitedFileLoader &loader)
+{
+	const wxString cacheDirectory(wxStandardPaths::Get().GetUserDir(wxStandardPaths::Dir_Cache)
+		+ wxFileName::GetPathSeparator() + mColumnCacheDirectoryName);
+	if (!wxFileName::DirExists(cacheDirectory) &&
+		!wxFileName::Mkdir(cacheDirectory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return;
+
+	loader.SetCacheDirectory(cacheDirectory);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadFiles
+//
+// Description:		Loads the specified files.  Plain delimited files go
+//					through the parallel loader; anything else (and anything
+//					the parallel loader can't make sense of) is passed on to
+//					LibPlot2D.
+//
+// Input Arguments:
+//		fileList	= const wxArrayString&
+//		parent		= wxWindow*, for error messages (may be null)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if at least one file was loaded
+//
+//==========================================================================
+bool DataSourceManager::LoadFiles(const wxArrayString &fileList, wxWindow* parent)
+{
+	if (!AreFormatsLoaded())
+	{
+		mWaitingFiles.push_back(std::make_pair(fileList, parent));
+		return true;
+	}
+
+	std::vector<LoadRequest> requests;
+	wxArrayString interfaceList;
+	bool loadedAny(false);
+	for (const auto& fileName : fileList)
+	{
+		if (SessionSnapshot::IsSnapshot(fileName))
+		{
+			wxString error;
+			if (RestoreSession(fileName, error))
+				loadedAny = true;
+			else if (parent)
+				wxMessageBox(error, _T("Open Session"), wxICON_ERROR, parent);
+		}
+		else if (!mLoader.CanLoad(fileName))
+			interfaceList.Add(fileName);
+		else
+			requests.push_back({ fileName, GetInitialMask(fileName), false });
+	}
+
+	if (StartLoad(requests))
+		loadedAny = true;
+
+	if (interfaceList.IsEmpty())
+		return loadedAny;
+
+	if (LoadInterfaceFiles(interfaceList))
+		loadedAny = true;
+
+	return loadedAny;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		GetInitialMask
+//
+// Description:		Chooses the columns to parse when a file is opened.
+//					Only the time column of very wide files is parsed; the
+//					others are listed, and each is parsed when its curve is
+//					switched on (see ParseCurve()).
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		DelimitedFileLoader::ColumnMask, empty for all columns
+//
+//==========================================================================
+DelimitedFileLoader::ColumnMask DataSourceManager::GetInitialMask(const wxString &fileName) const
+{
+	wxArrayString descriptions;
+	if (!mLoader.ReadDescriptions(fileName, descriptions) ||
+		descriptions.GetCount() <= mUnparsedColumnCount)
+		return DelimitedFileLoader::ColumnMask();
+
+	return DelimitedFileLoader::ColumnMask(descriptions.GetCount(), false);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ParseCurve
+//
+// Description:		Starts parsing the column of a curve which was listed
+//					without its data, on a worker thread like a load.  The
+//					curve is filled in when it is done.  Does nothing for
+//					other curves.
+//
+// Input Arguments:
+//		index	= const unsigned int&, in the plot list
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ParseCurve(const unsigned int &index)
+{
+	if (index >= mPlotInterface.GetCurveCount())
+		return;
+
+	const SourceFile* file;
+	const Curve* curve(FindCurve(&mPlotInterface.GetDataset(index), &file));
+	if (!curve || IsParsed(*file, *curve))
+		return;
+
+	LoadRequest request;
+	request.fileName = file->fileName;
+	request.mask.assign(curve->column + 1, false);// Later columns aren't selected
+	request.mask.back() = true;
+	request.addColumns = true;
+
+	// Files which are still loading get the column once they have finished
+	StartLoad(std::vector<LoadRequest>(1, request));
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		TakeUnparsedCurves
+//
+// Description:		Finds the curves which have been listed without their
+//					data since the last call.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<unsigned int>, indices in the plot list
+//
+//==========================================================================
+std::vector<unsigned int> DataSourceManager::TakeUnparsedCurves()
+{
+	std::vector<unsigned int> curves;
+	if (mNewUnparsedCurves.empty())
+		return curves;
+
+	unsigned int i;
+	for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+	{
+		if (mNewUnparsedCurves.find(&mPlotInterface.GetDataset(i)) != mNewUnparsedCurves.end())
+			curves.push_back(i);
+	}
+
+	mNewUnparsedCurves.clear();
+	return curves;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		Paste
+//
+// Description:		Loads delimited numeric text from the clipboard.  The
+//					clipboard's bytes are requested as a raw buffer (rather
+//					than converted to a wxString) and parsed in place.
+//					Anything else is pasted by LibPlot2D, once its file
+//					types have been registered.
+//
+// Input Arguments:
+//		parent	= wxWindow*, for the progress dialog
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::Paste(wxWindow* parent)
+{
+	wxCustomDataObject text(wxDF_TEXT);
+	bool haveText;
+	{
+		wxClipboardLocker lock;
+		haveText = lock && wxTheClipboard->IsSupported(wxDF_TEXT) &&
+			wxTheClipboard->GetData(text);
+	}
+
+	if (haveText)
+	{
+		const char* data(static_cast<const char*>(text.GetData()));
+		size_t size(text.GetSize());
+		while (size > 0 && data[size - 1] == '\0')
+			--size;
+
+		if (LoadText(data, size, parent))
+			return;
+	}
+
+	WaitForFileTypes();
+	mPlotInterface.Paste();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadText
+//
+// Description:		Loads delimited numeric text dropped onto the window.
+//					Anything else is passed on to LibPlot2D, once its file
+//					types have been registered.
+//
+// Input Arguments:
+//		text	= const wxString&
+//		parent	= wxWindow*, for the progress dialog
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::LoadText(const wxString &text, wxWindow* parent)
+{
+	const std::string data(text.ToUTF8());
+	if (LoadText(data.c_str(), data.size(), parent))
+		return;
+
+	WaitForFileTypes();
+	mPlotInterface.LoadText(text);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadText
+//
+// Description:		Parses delimited numeric text in place, showing progress
+//					for large amounts of text.  Text isn't matched against
+//					the custom formats, so this doesn't wait for them.
+//
+// Input Arguments:
+//		data	= const char*
+//		size	= size_t
+//		parent	= wxWindow*, for the progress dialog
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if the text isn't delimited numeric data (true if the
+//		user cancelled)
+//
+//==========================================================================
+bool DataSourceManager::LoadText(const char* data, const size_t &size, wxWindow* parent)
+{
+	wxBusyCursor wait;
+	std::unique_ptr<wxProgressDialog> progressDialog;
+	if (size >= mPasteProgressSize)
+		progressDialog.reset(new wxProgressDialog(_T("Paste"), _T("Reading pasted data..."),
+			100, parent, wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_AUTO_HIDE));
+
+	bool cancelled(false);
+	DelimitedFileLoader::LoadedFile file;
+	if (!mLoader.LoadBuffer(data, size, wxEmptyString, file,
+		[&progressDialog, &cancelled](const double &fraction)
+	{
+		if (progressDialog)
+			cancelled = !progressDialog->Update(static_cast<int>(fraction * 100.0));
+		return !cancelled;
+	}))
+		return cancelled;
+
+	AddCurves(file);
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ReloadData
+//
+// Description:		Reloads all previously loaded files.  Files LibPlot2D
+//					loaded are loaded again straight away; ours are checked
+//					for changes on a worker thread and the results are
+//					applied when it finishes.  If a load or reload is still
+//					running, the reload is done again once it finishes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ReloadData()
+{
+	if (mPendingReload.valid() || mPendingLoad.valid())
+	{
+		mReloadQueued = true;// Files may have changed since it started
+		return;
+	}
+
+	mReloadQueued = false;
+
+	if (!mInterfaceFiles.IsEmpty())
+		ReloadInterfaceFiles();
+
+	if (mSourceFiles.empty())
+		return;
+
+	auto jobs(std::make_shared<std::vector<ReloadJob>>());
+	for (const auto& file : mSourceFiles)
+	{
+		if (file.fileName.IsEmpty())
+			continue;
+
+		ReloadJob job;
+		job.fileName = file.fileName;
+		job.state = file.state;
+		job.outOfCore = file.outOfCore;
+		job.mask = file.mask;
+		jobs->push_back(std::move(job));
+	}
+
+	if (jobs->empty())
+		return;
+
+	mPendingReload = ThreadPool::GetSharedPool().Enqueue([this, jobs]()
+	{
+		CheckFiles(*jobs);
+		mOwner.CallAfter([this, jobs]()
+		{
+			ApplyReload(*jobs);
+		});
+	});
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ReloadInterfaceFiles
+//
+// Description:		Loads the files opened by mPlotInterface again, replacing
+//					only the curves they added.  Other curves (ours, the
+//					results of LibPlot2D's operations, pasted data) are left
+//					as they are.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ReloadInterfaceFiles()
+{
+	ForgetRemovedCurves();
+
+	unsigned int i(mPlotInterface.GetCurveCount());
+	while (i > 0)
+	{
+		--i;
+		const LibPlot2D::Dataset2D* display(&mPlotInterface.GetDataset(i));
+		if (mInterfaceCurves.find(display) != mInterfaceCurves.end() && !IsOwnCurve(display))
+			mPlotInterface.RemoveCurve(i);
+	}
+
+	mInterfaceCurves.clear();
+	const wxArrayString fileList(mInterfaceFiles);
+	LoadInterfaceFiles(fileList);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		LoadInterfaceFiles
+//
+// Description:		Has mPlotInterface load the specified files, and records
+//					them and the curves they add so they can be reloaded.
+//
+// Input Arguments:
+//		fileList	= const wxArrayString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the files were loaded
+//
+//==========================================================================
+bool DataSourceManager::LoadInterfaceFiles(const wxArrayString &fileList)
+{
+	WaitForFileTypes();
+
+	const unsigned int firstCurve(mPlotInterface.GetCurveCount());
+	const bool loaded(mPlotInterface.LoadFiles(fileList));
+
+	unsigned int i;
+	for (i = firstCurve; i < mPlotInterface.GetCurveCount(); ++i)
+		mInterfaceCurves.insert(&mPlotInterface.GetDataset(i));
+
+	if (!loaded)
+		return false;
+
+	for (const auto& fileName : fileList)
+	{
+		if (mInterfaceFiles.Index(fileName) == wxNOT_FOUND)
+			mInterfaceFiles.Add(fileName);
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		IsOwnCurve
+//
+// Description:		Checks whether the specified curve comes from one of our
+//					files or streams (rather than from mPlotInterface's).
+//
+// Input Arguments:
+//		display	= const LibPlot2D::Dataset2D*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::IsOwnCurve(const LibPlot2D::Dataset2D* display) const
+{
+	if (FindCurve(display))
+		return true;
+
+	for (const auto& stream : mStreams)
+	{
+		if (std::any_of(stream.curves.begin(), stream.curves.end(),
+			[display](const Curve &curve)
+		{
+			return curve.display == display;
+		}))
+			return true;
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ReloadFiles
+//
+// Description:		Removes the specified files and loads them again from
+//					scratch, for files whose layout has changed.  Curves
+//					derived from them are removed with them; other files are
+//					kept as they are.
+//
+// Input Arguments:
+//		fileNames	= const std::vector<wxString>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ReloadFiles(const std::vector<wxString> &fileNames)
+{
+	std::vector<LoadRequest> requests;
+	for (const auto& fileName : fileNames)
+	{
+		auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+			[&fileName](const SourceFile &f)
+		{
+			return !f.loading && f.fileName == fileName;
+		}));
+
+		if (file == mSourceFiles.end())
+			continue;
+
+		requests.push_back({ file->fileName, file->mask, false });
+		for (const auto& curve : file->curves)
+			RemoveCurve(curve);
+		mSourceFiles.erase(file);
+	}
+
+	// Curves derived from the removed files (directly or through other
+	// derived curves) can no longer be computed
+	bool removedAny(true);
+	while (removedAny)
+	{
+		ForgetRemovedCurves();
+		removedAny = false;
+		for (const auto& file : mSourceFiles)
+		{
+			for (const auto& curve : file.curves)
+			{
+				if (!curve.expression || std::all_of(curve.operands.begin(),
+					curve.operands.end(), [this](const LibPlot2D::Dataset2D* operand)
+				{
+					return !operand || FindCurve(operand);
+				}))
+					continue;
+
+				RemoveCurve(curve);
+				removedAny = true;
+			}
+		}
+	}
+
+	StartLoad(requests);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		CheckFiles
+//
+// Description:		Runs on a worker thread.  Parses the rows appended to
+//					each file, or the whole file if it was modified some
+//					other way.  Files used from their caches are always
+//					parsed again in full, since appending to them would
+//					copy every column into memory.  Touches nothing but the
+//					jobs.
+//
+// Input Arguments:
+//		jobs	= std::vector<ReloadJob>&
+//
+// Output Arguments:
+//		jobs	= std::vector<ReloadJob>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::CheckFiles(std::vector<ReloadJob> &jobs)
+{
+	for (auto& job : jobs)
+	{
+		try
+		{
+			job.result = mLoader.LoadTail(job.fileName, job.state, job.tail);
+			if (job.result == DelimitedFileLoader::TailResult::Appended && job.outOfCore)
+				job.result = DelimitedFileLoader::TailResult::Modified;
+
+			if (job.result == DelimitedFileLoader::TailResult::Modified)
+			{
+				wxArrayString fileList, failedFiles;
+				fileList.Add(job.fileName);
+				job.reloaded = mLoader.Load(fileList, failedFiles, nullptr, nullptr,
+					std::vector<DelimitedFileLoader::ColumnMask>(1, job.mask));
+			}
+		}
+		catch (const std::exception&)
+		{
+			job.result = DelimitedFileLoader::TailResult::Failed;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ApplyReload
+//
+// Description:		Runs on the GUI thread once CheckFiles has finished.
+//					Applies the new data to the curves that are still
+//					plotted.
+//
+// Input Arguments:
+//		jobs	= std::vector<ReloadJob>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ApplyReload(std::vector<ReloadJob> &jobs)
+{
+	mPendingReload.get();
+	ForgetRemovedCurves();
+
+	std::vector<wxString> replacedFiles;
+	for (auto& job : jobs)
+	{
+		auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+			[&job](const SourceFile &f)
+		{
+			return !f.loading && f.fileName == job.fileName;
+		}));
+
+		if (file == mSourceFiles.end())
+			continue;
+
+		if (job.result == DelimitedFileLoader::TailResult::Appended)
+			AppendRows(*file, job.tail);
+		else if (job.result == DelimitedFileLoader::TailResult::Modified &&
+			(job.reloaded.empty() || !ReplaceData(*file, job.reloaded.front())))
+			replacedFiles.push_back(job.fileName);
+	}
+
+	UpdateDerivedCurves();
+	if (!replacedFiles.empty())
+		ReloadFiles(replacedFiles);
+
+	if (mReloadQueued)
+		ReloadData();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AppendRows
+//
+// Description:		Adds newly parsed rows to the end of a file's curves.
+//
+// Input Arguments:
+//		file	= SourceFile&
+//		tail	= const DelimitedFileLoader::LoadedTail&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::AppendRows(SourceFile &file,
+	const DelimitedFileLoader::LoadedTail &tail)
+{
+	const size_t oldRowCount(GetRowCount(file));
+	const std::vector<double>& time(tail.columns.front());
+	size_t keptTimeCount(file.time.GetSize()
+		- std::min<size_t>(tail.replacedRows, file.time.GetSize()));
+	// The pyramids can't be used once the times go backwards
+	if (file.time.GetSize() > 0 && !time.empty() &&
+		((keptTimeCount > 0 && !(time.front() >= file.time.GetData()[keptTimeCount - 1])) ||
+		!DecimationPyramid::IsMonotonic(time.data(), time.size(), ThreadPool::GetSharedPool())))
+	{
+		StopDecimating(file);
+		keptTimeCount = 0;
+	}
+
+	const size_t timeCount(keptTimeCount + time.size());
+	if (file.time.GetSize() > 0)
+	{
+		file.time.Resize(timeCount);
+		memcpy(file.time.GetWritableData() + keptTimeCount, time.data(),
+			sizeof(double) * time.size());
+	}
+
+	for (auto& curve : file.curves)
+	{
+		if (curve.expression || !IsParsed(file, curve))
+			continue;
+
+		const std::vector<double>& y(tail.columns[curve.column + 1]);
+		if (curve.pyramid)
+		{
+			curve.y.Resize(timeCount);
+			memcpy(curve.y.GetWritableData() + keptTimeCount, y.data(), sizeof(double) * y.size());
+			curve.pyramid->Update(file.time.GetData(), curve.y.GetData(),
+				timeCount, keptTimeCount, ThreadPool::GetSharedPool());
+			continue;
+		}
+
+		LibPlot2D::Dataset2D& data(*curve.display);
+		const unsigned int keptCount(data.GetNumberOfPoints()
+			- std::min(tail.replacedRows, data.GetNumberOfPoints()));
+
+		data.Resize(keptCount + static_cast<unsigned int>(time.size()));
+		memcpy(data.GetXPointer() + keptCount, time.data(), sizeof(double) * time.size());
+		memcpy(data.GetYPointer() + keptCount, y.data(), sizeof(double) * y.size());
+	}
+
+	file.state = tail.state;
+	file.rowIndex.clear();// Rebuilt if more columns are loaded
+	MarkChanged(file, oldRowCount - std::min<size_t>(tail.replacedRows, oldRowCount));
+
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ReplaceData
+//
+// Description:		Replaces the data in a file's curves with the result of
+//					parsing the file again.
+//
+// Input Arguments:
+//		file	= SourceFile&
+//		loaded	= DelimitedFileLoader::LoadedFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if the file's columns changed (so the curves can't be kept)
+//
+//==========================================================================
+bool DataSourceManager::ReplaceData(SourceFile &file,
+	DelimitedFileLoader::LoadedFile &loaded)
+{
+	if (loaded.state.layout.columnCount != file.state.layout.columnCount)
+		return false;
+
+	FillCurves(file, loaded);
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		StartLoad
+//
+// Description:		Starts loading files through the parallel loader on a
+//					worker thread.  Each file's curves are added (empty) as
+//					soon as its columns are known; FinishLoad() fills them
+//					in.  Columns of files which are already loaded are
+//					parsed after the new files, and their curves are filled
+//					in when they are done.  Files requested while a load
+//					is running are loaded when it finishes.
+//
+// Input Arguments:
+//		requests	= const std::vector<LoadRequest>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if there was anything to load
+//
+//==========================================================================
+bool DataSourceManager::StartLoad(const std::vector<LoadRequest> &requests)
+{
+	if (requests.empty())
+		return false;
+
+	if (mPendingLoad.valid())
+	{
+		mQueuedLoads.insert(mQueuedLoads.end(), requests.begin(), requests.end());
+		return true;
+	}
+
+	wxArrayString fileList;
+	std::vector<DelimitedFileLoader::ColumnMask> masks;
+	auto addedColumns(std::make_shared<std::vector<DelimitedFileLoader::LoadedFile>>());
+	std::vector<DelimitedFileLoader::ColumnMask> addedMasks;
+	for (const auto& request : requests)
+	{
+		auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+			[&request](const SourceFile &f)
+		{
+			return request.addColumns && !f.loading && f.fileName == request.fileName;
+		}));
+
+		if (request.addColumns && file == mSourceFiles.end())
+			continue;// Removed in the meantime
+		else if (file == mSourceFiles.end())
+		{
+			fileList.Add(request.fileName);
+			masks.push_back(request.mask);
+			continue;
+		}
+
+		DelimitedFileLoader::LoadedFile loaded;
+		loaded.fileName = file->fileName;
+		loaded.state = file->state;
+		loaded.mask = file->mask;
+		loaded.rowIndex = file->rowIndex;
+		loaded.columns.resize(file->state.layout.columnCount);
+		loaded.columns.front() = file->time;// Parsed again if the curves aren't decimated
+		addedColumns->push_back(std::move(loaded));
+		addedMasks.push_back(request.mask);
+	}
+
+	mLoadProgress = 0.0;
+	mCancelLoad = false;
+	mPendingLoad = ThreadPool::GetSharedPool().Enqueue([this, fileList, masks,
+		addedColumns, addedMasks]()
+	{
+		auto loadedFiles(std::make_shared<std::vector<DelimitedFileLoader::LoadedFile>>());
+		auto failedFiles(std::make_shared<wxArrayString>());
+
+		// Each file that gets columns added counts the same as all the new files
+		const double stageCount((fileList.IsEmpty() ? 0.0 : 1.0) + addedColumns->size());
+		double stage(0.0);
+		auto progress([this, &stage, stageCount](const double &fraction)
+		{
+			mLoadProgress = (stage + fraction) / stageCount;
+			return !mCancelLoad;
+		});
+
+		try
+		{
+			if (!fileList.IsEmpty())
+			{
+				*loadedFiles = mLoader.Load(fileList, *failedFiles, progress,
+					[this, &fileList, &masks](const wxString &fileName, const wxArrayString &descriptions)
+				{
+					const int index(fileList.Index(fileName));
+					const DelimitedFileLoader::ColumnMask mask(index == wxNOT_FOUND ?
+						DelimitedFileLoader::ColumnMask() : masks[index]);
+					mOwner.CallAfter([this, fileName, descriptions, mask]()
+					{
+						AddEmptyCurves(fileName, descriptions, mask);
+					});
+				}, masks);
+				stage += 1.0;
+			}
+
+			size_t i;
+			for (i = 0; i < addedColumns->size() && !mCancelLoad; ++i)
+			{
+				if (!mLoader.LoadColumns((*addedColumns)[i], addedMasks[i], progress))
+					(*addedColumns)[i].columns.clear();
+				stage += 1.0;
+			}
+
+			if (mCancelLoad)
+				addedColumns->clear();
+		}
+		catch (const std::exception&)
+		{
+			loadedFiles->clear();
+			*failedFiles = fileList;
+			addedColumns->clear();
+		}
+
+		mOwner.CallAfter([this, loadedFiles, failedFiles, addedColumns]()
+		{
+			FinishLoad(*loadedFiles, *failedFiles, *addedColumns);
+		});
+	});
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		CancelLoad
+//
+// Description:		Stops the background load (and any loads queued behind
+//					it).  The curves it added are removed when it stops.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::CancelLoad()
+{
+	mCancelLoad = true;
+	mQueuedLoads.clear();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FinishLoad
+//
+// Description:		Runs on the GUI thread once a background load has
+//					finished.  Fills in the curves of the files which were
+//					loaded, removes those of files which weren't and hands
+//					files that aren't delimited numeric data to LibPlot2D.
+//					Fills in the curves of columns which were parsed for
+//					files that were already loaded; if a file changed in the
+//					meantime, its new columns are dropped and it is reloaded
+//					instead.
+//
+// Input Arguments:
+//		loadedFiles		= std::vector<DelimitedFileLoader::LoadedFile>&
+//		failedFiles		= const wxArrayString&
+//		addedColumns	= std::vector<DelimitedFileLoader::LoadedFile>&, files
+//						  without columns are the ones which changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FinishLoad(std::vector<DelimitedFileLoader::LoadedFile> &loadedFiles,
+	const wxArrayString &failedFiles,
+	std::vector<DelimitedFileLoader::LoadedFile> &addedColumns)
+{
+	mPendingLoad.get();
+	ForgetRemovedCurves();
+
+	for (auto& loaded : loadedFiles)
+	{
+		auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+			[&loaded](const SourceFile &f)
+		{
+			return f.loading && f.fileName == loaded.fileName;
+		}));
+
+		if (file == mSourceFiles.end())
+			continue;
+
+		FillCurves(*file, loaded);
+		file->loading = false;
+	}
+
+	bool reload(false);
+	for (auto& added : addedColumns)
+	{
+		auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+			[&added](const SourceFile &f)
+		{
+			return !f.loading && f.fileName == added.fileName;
+		}));
+
+		if (file != mSourceFiles.end() && (added.columns.empty() || !FillColumnCurves(*file, added)))
+			reload = true;
+	}
+
+	// Whatever is still loading failed or was cancelled
+	for (const auto& file : mSourceFiles)
+	{
+		if (!file.loading)
+			continue;
+
+		for (const auto& curve : file.curves)
+			RemoveCurve(curve);
+	}
+
+	mSourceFiles.erase(std::remove_if(mSourceFiles.begin(), mSourceFiles.end(),
+		[](const SourceFile &file)
+	{
+		return file.loading;
+	}), mSourceFiles.end());
+
+	UpdateDerivedCurves();
+	if (!failedFiles.IsEmpty())
+	{
+		LoadInterfaceFiles(failedFiles);
+	}
+
+	std::vector<LoadRequest> queuedLoads;
+	queuedLoads.swap(mQueuedLoads);
+	if (reload || mReloadQueued)
+		ReloadData();
+	StartLoad(queuedLoads);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AddCurves
+//
+// Description:		Hands the data from a loaded file to the plot.
+//
+// Input Arguments:
+//		file	= DelimitedFileLoader::LoadedFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::AddCurves(DelimitedFileLoader::LoadedFile &file)
+{
+	AddEmptyCurves(file.fileName, file.descriptions, file.mask);
+	FillCurves(mSourceFiles.back(), file);
+	mSourceFiles.back().loading = false;
+	UpdateDerivedCurves();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AddEmptyCurves
+//
+// Description:		Adds a curve for each column of a file which is still
+//					being loaded.  The curves of columns which mask doesn't
+//					select stay empty until they are parsed.
+//
+// Input Arguments:
+//		fileName		= const wxString&
+//		descriptions	= const wxArrayString&
+//		mask			= const DelimitedFileLoader::ColumnMask&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::AddEmptyCurves(const wxString &fileName,
+	const wxArrayString &descriptions, const DelimitedFileLoader::ColumnMask &mask)
+{
+	SourceFile source;
+	source.fileName = fileName;
+	source.loading = true;
+	source.mask = mask;
+	source.id = ++mLastFileId;
+
+	unsigned int i;
+	for (i = 0; i < descriptions.GetCount(); ++i)
+	{
+		Curve curve;
+		curve.column = i;
+
+		std::unique_ptr<LibPlot2D::Dataset2D> display(new LibPlot2D::Dataset2D);
+		curve.display = display.get();
+		if (!IsParsed(source, curve))
+			mNewUnparsedCurves.insert(curve.display);
+		source.curves.push_back(std::move(curve));
+		mPlotInterface.AddCurve(std::move(display), descriptions[i]);
+	}
+
+	mSourceFiles.push_back(std::move(source));
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FillColumnCurves
+//
+// Description:		Fills in the curves of columns which were parsed after
+//					the rest of the file.
+//
+// Input Arguments:
+//		file	= SourceFile&
+//		loaded	= DelimitedFileLoader::LoadedFile&, has only the new columns
+//				  (and the time column)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if the file has changed since the columns were requested
+//
+//==========================================================================
+bool DataSourceManager::FillColumnCurves(SourceFile &file,
+	DelimitedFileLoader::LoadedFile &loaded)
+{
+	const size_t rowCount(GetRowCount(file));
+	if (loaded.state.size != file.state.size ||
+		loaded.state.parsedLength != file.state.parsedLength ||
+		(rowCount > 0 && rowCount != loaded.columns.front().GetSize()))
+		return false;
+
+	for (auto& curve : file.curves)
+	{
+		if (IsParsed(file, curve) || curve.column + 1 >= loaded.columns.size() ||
+			loaded.columns[curve.column + 1].GetSize() == 0)
+			continue;
+
+		SetCurveData(file, curve, loaded.columns.front().GetData(),
+			loaded.columns[curve.column + 1]);
+		if (curve.column >= file.mask.size())
+			file.mask.resize(curve.column + 1, false);
+		file.mask[curve.column] = true;
+	}
+
+	if (file.rowIndex.empty())
+		file.rowIndex = std::move(loaded.rowIndex);
+
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		IsParsed
+//
+// Description:		Checks whether a curve has its data; curves of columns
+//					which haven't been parsed are empty.
+//
+// Input Arguments:
+//		file	= const SourceFile&, the file the curve belongs to
+//		curve	= const Curve&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::IsParsed(const SourceFile &file, const Curve &curve)
+{
+	return curve.expression || file.mask.empty() ||
+		(curve.column < file.mask.size() && file.mask[curve.column]);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		GetRowCount
+//
+// Description:		Finds the number of rows a file's curves have.
+//
+// Input Arguments:
+//		file	= const SourceFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t, zero if none of the file's curves have their data
+//
+//==========================================================================
+size_t DataSourceManager::GetRowCount(const SourceFile &file)
+{
+	if (file.time.GetSize() > 0)
+		return file.time.GetSize();
+
+	auto curve(std::find_if(file.curves.begin(), file.curves.end(),
+		[&file](const Curve &c)
+	{
+		return IsParsed(file, c);
+	}));
+
+	return curve == file.curves.end() ? 0 :
+		static_cast<size_t>(curve->display->GetNumberOfPoints());
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FillCurves
+//
+// Description:		Gives a file's curves their data.  Large curves (and
+//					all curves from files which are used from their caches,
+//					so the full data is never copied) are decimated; files
+//					used from their caches get coarser pyramids to save
+//					memory.  Other curves, and curves whose times aren't
+//					monotonic, get a copy of the data.
+//
+// Input Arguments:
+//		file		= SourceFile&
+//		loaded		= DelimitedFileLoader::LoadedFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FillCurves(SourceFile &file, DelimitedFileLoader::LoadedFile &loaded)
+{
+	// Derived curves needn't be computed again over rows which a reload left as they were
+	const size_t keptRows(file.loading ? 0 : CountUnchangedRows(file, loaded));
+
+	file.state = loaded.state;
+	file.outOfCore = loaded.outOfCore;
+	file.mask = loaded.mask;
+	file.rowIndex = std::move(loaded.rowIndex);
+
+	file.time = ShouldDecimate(loaded.columns.front(), loaded.outOfCore) ?
+		loaded.columns.front() : SharedColumn();
+
+	for (auto& curve : file.curves)
+	{
+		if (!curve.expression && IsParsed(file, curve))
+			SetCurveData(file, curve, loaded.columns.front().GetData(),
+				loaded.columns[curve.column + 1]);
+	}
+
+	MarkChanged(file, keptRows);
+
+	mDisplayChanged = true;
+
+	// Force the next update to match the new curves to the view
+	mDecimatedPixelColumns = 0;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ShouldDecimate
+//
+// Description:		Decides whether a file's curves are decimated:  they are
+//					if they're large (or the file is used from its cache) and
+//					the times never decrease, since the pyramids rely on that
+//					to find the view.  Other curves are drawn in full, as
+//					curves which aren't plotted against time often are.
+//
+// Input Arguments:
+//		time		= const SharedColumn&
+//		outOfCore	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::ShouldDecimate(const SharedColumn &time, const bool &outOfCore) const
+{
+	return (time.GetSize() > mDecimationPointLimit || outOfCore) &&
+		DecimationPyramid::IsMonotonic(time.GetData(), time.GetSize(),
+		ThreadPool::GetSharedPool());
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		StopDecimating
+//
+// Description:		Gives each of a file's decimated curves a copy of its
+//					full data instead, for when rows are appended whose
+//					times aren't in order.
+//
+// Input Arguments:
+//		file	= SourceFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::StopDecimating(SourceFile &file)
+{
+	const SharedColumn time(file.time);
+	file.time = SharedColumn();
+	for (auto& curve : file.curves)
+	{
+		if (curve.pyramid)
+			SetCurveData(file, curve, time.GetData(), SharedColumn(curve.y));
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		SetCurveData
+//
+// Description:		Gives a curve its data.  If the file's curves are
+//					decimated (the file keeps the time column), the curve
+//					keeps the values and its display is decimated from them;
+//					otherwise the display gets a copy of the data.
+//
+// Input Arguments:
+//		file	= const SourceFile&, the file the curve belongs to
+//		curve	= Curve&
+//		time	= const double*, as many values as values has
+//		values	= const SharedColumn&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::SetCurveData(const SourceFile &file, Curve &curve,
+	const double* time, const SharedColumn &values)
+{
+	const size_t pointCount(values.GetSize());
+	if (file.time.GetSize() == 0)
+	{
+		curve.y = SharedColumn();
+		curve.pyramid.reset();
+		curve.display->Resize(static_cast<unsigned int>(pointCount));
+		memcpy(curve.display->GetXPointer(), time, sizeof(double) * pointCount);
+		memcpy(curve.display->GetYPointer(), values.GetData(), sizeof(double) * pointCount);
+		return;
+	}
+
+	curve.y = values;
+	curve.pyramid.reset(new DecimationPyramid(file.time.GetData(),
+		curve.y.GetData(), pointCount, ThreadPool::GetSharedPool(),
+		file.outOfCore ? mOutOfCoreBucketSize : DecimationPyramid::defaultBaseBucketSize));
+	FillDisplay(curve, file.time.GetData()[0],
+		file.time.GetData()[pointCount - 1], mInitialPixelColumns);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		RemoveCurve
+//
+// Description:		Removes a curve's display dataset from the plot.
+//
+// Input Arguments:
+//		curve	= const Curve&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::RemoveCurve(const Curve &curve)
+{
+	unsigned int i;
+	for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+	{
+		if (&mPlotInterface.GetDataset(i) != curve.display)
+			continue;
+
+		mPlotInterface.RemoveCurve(i);
+		return;
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AddDerivedCurve
+//
+// Description:		Compiles the expression and adds a curve for it to the
+//					file its first operand comes from.  Operands from other
+//					files are resampled onto that file's time base, either
+//					by linear interpolation or by holding the most recent
+//					sample.
+//
+// Input Arguments:
+//		expression	= const wxString&
+//		parent		= wxWindow*, for asking how to resample (may be null)
+//
+// Output Arguments:
+//		error		= wxString&
+//
+// Return Value:
+//		bool, true if the curve was added
+//
+//==========================================================================
+bool DataSourceManager::AddDerivedCurve(const wxString &expression, wxString &error,
+	wxWindow* parent)
+{
+	ForgetRemovedCurves();
+
+	std::shared_ptr<CompiledExpression> compiled(
+		std::make_shared<CompiledExpression>(ThreadPool::GetSharedPool()));
+	std::string compileError;
+	if (!compiled->Compile(std::string(expression.ToUTF8()), compileError))
+	{
+		error = wxString::FromUTF8(compileError.c_str());
+		return false;
+	}
+
+	Curve curve;
+	curve.column = 0;
+	curve.expression = compiled;
+	curve.expressionText = expression;
+
+	SourceFile* target(nullptr);
+	bool aligned(false);
+	for (const auto& reference : compiled->GetColumns())
+	{
+		if (reference == 0)
+			continue;
+		else if (reference > mPlotInterface.GetCurveCount())
+		{
+			error = wxString::Format(_T("There is no curve %u."), reference);
+			return false;
+		}
+
+		const LibPlot2D::Dataset2D* operand(&mPlotInterface.GetDataset(reference - 1));
+		const SourceFile* file;
+		const Curve* operandCurve(FindCurve(operand, &file));
+		if (!operandCurve || file->loading)
+		{
+			error = _T("Expressions may only refer to curves from delimited files which have finished loading.");
+			return false;
+		}
+		else if (!IsParsed(*file, *operandCurve))
+		{
+			error = wxString::Format(_T("Curve %u hasn't been read yet; switch it on first."), reference);
+			return false;
+		}
+
+		// Found a const pointer, but it points into mSourceFiles
+		if (!target)
+			target = &mSourceFiles[file - mSourceFiles.data()];
+		else if (file != target)
+			aligned = true;
+
+		curve.operands.resize(reference + 1, nullptr);
+		curve.operands[reference] = operand;
+	}
+
+	if (!target)
+	{
+		error = _T("The expression must refer to at least one curve.");
+		return false;
+	}
+
+	if (aligned && parent)
+	{
+		wxArrayString choices;
+		choices.Add(_T("Linear interpolation"));
+		choices.Add(_T("Hold the most recent sample"));
+		wxSingleChoiceDialog dialog(parent, _T("Curves from other files are resampled at the times of the first curve's file using:"),
+			_T("Resample Curves"), choices);
+		if (dialog.ShowModal() != wxID_OK)
+			return false;
+
+		curve.alignment = dialog.GetSelection() == 0 ?
+			Resampler::Method::Linear : Resampler::Method::ZeroOrderHold;
+	}
+
+	std::unique_ptr<LibPlot2D::Dataset2D> display(new LibPlot2D::Dataset2D);
+	curve.display = display.get();
+	if (!ComputeDerivedCurve(*target, curve, 0))
+	{
+		error = _T("The curves have no data.");
+		return false;
+	}
+
+	target->curves.push_back(std::move(curve));
+	mPlotInterface.AddCurve(std::move(display), expression);
+
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AddOperationCurves
+//
+// Description:		Computes the derivative, integral or RMS of each of the
+//					specified curves from its full data and adds the
+//					results as new curves.  Decimated curves' columns are
+//					used where they are (the results share their times), so
+//					those of files used from their caches are read straight
+//					from the mapped cache, a block at a time; other curves
+//					are used from their displays.
+//
+// Input Arguments:
+//		operation	= const SignalOperations::Operation&
+//		curves		= const std::vector<unsigned int>&, indices in the plot list
+//		names		= const wxArrayString&, one for each curve
+//
+// Output Arguments:
+//		error		= wxString&
+//
+// Return Value:
+//		bool, true if any curves were added
+//
+//==========================================================================
+bool DataSourceManager::AddOperationCurves(const SignalOperations::Operation &operation,
+	const std::vector<unsigned int> &curves, const wxArrayString &names, wxString &error)
+{
+	ForgetRemovedCurves();
+
+	std::vector<DelimitedFileLoader::LoadedFile> results;
+	std::vector<SharedColumn> sources;// Keeps the decimated curves' values
+	std::vector<SignalOperations::ArrayData> data;
+	results.reserve(curves.size());
+	sources.reserve(curves.size());
+
+	size_t i;
+	for (i = 0; i < curves.size(); ++i)
+	{
+		if (curves[i] >= mPlotInterface.GetCurveCount())
+			continue;
+
+		const LibPlot2D::Dataset2D& display(mPlotInterface.GetDataset(curves[i]));
+		SharedColumn time, values;
+		const double* y(display.GetYPointer());
+		if (FindDecimatedData(&display, time, values))
+			y = values.GetData();
+		else
+		{
+			time = SharedColumn(display.GetNumberOfPoints());
+			memcpy(time.GetWritableData(), display.GetXPointer(),
+				sizeof(double) * time.GetSize());
+		}
+
+		if (time.GetSize() == 0)
+			continue;
+
+		DelimitedFileLoader::LoadedFile result;
+		result.descriptions.Add(names[i]);
+		result.columns.push_back(time);
+		result.columns.push_back(SharedColumn(time.GetSize()));
+		data.push_back({ time.GetData(), y, time.GetSize(),
+			result.columns.back().GetWritableData() });
+		results.push_back(std::move(result));
+		sources.push_back(std::move(values));
+	}
+
+	if (results.empty())
+	{
+		error = _T("The selected curves have no data.");
+		return false;
+	}
+
+	{
+		wxBusyCursor wait;
+		SignalOperations(ThreadPool::GetSharedPool()).Apply(operation, data);
+	}
+
+	for (auto& result : results)
+		AddCurves(result);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FindDecimatedData
+//
+// Description:		Finds the full data of a decimated curve (from one of
+//					our files or streams).  A stream's columns are copied,
+//					since the stream goes on appending to them.
+//
+// Input Arguments:
+//		display	= const LibPlot2D::Dataset2D*
+//
+// Output Arguments:
+//		time	= SharedColumn&
+//		values	= SharedColumn&
+//
+// Return Value:
+//		bool, false if the curve isn't decimated
+//
+//==========================================================================
+bool DataSourceManager::FindDecimatedData(const LibPlot2D::Dataset2D* display,
+	SharedColumn &time, SharedColumn &values) const
+{
+	const SourceFile* file;
+	const Curve* curve(FindCurve(display, &file));
+	if (curve)
+	{
+		if (!curve->pyramid)
+			return false;
+
+		time = file->time;
+		values = curve->y;
+		return true;
+	}
+
+	for (const auto& stream : mStreams)
+	{
+		for (const auto& streamCurve : stream.curves)
+		{
+			if (streamCurve.display != display)
+				continue;
+
+			const size_t count(streamCurve.pyramid->GetPointCount());
+			time = SharedColumn(count);
+			values = SharedColumn(count);
+			memcpy(time.GetWritableData(), stream.time.GetData(), sizeof(double) * count);
+			memcpy(values.GetWritableData(), streamCurve.y.GetData(), sizeof(double) * count);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FindCurve
+//
+// Description:		Finds the curve (from one of our files) with the
+//					specified display dataset.
+//
+// Input Arguments:
+//		display	= const LibPlot2D::Dataset2D*
+//
+// Output Arguments:
+//		file	= const SourceFile**, the file the curve belongs to (optional)
+//
+// Return Value:
+//		const Curve*, null if the display isn't one of our files' curves
+//
+//==========================================================================
+const DataSourceManager::Curve* DataSourceManager::FindCurve(
+	const LibPlot2D::Dataset2D* display, const SourceFile** file) const
+{
+	for (const auto& f : mSourceFiles)
+	{
+		for (const auto& curve : f.curves)
+		{
+			if (curve.display != display)
+				continue;
+
+			if (file)
+				*file = &f;
+			return &curve;
+		}
+	}
+
+	return nullptr;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		MarkChanged
+//
+// Description:		Records that a file's data has changed, so that the
+//					derived curves which depend on it are computed again by
+//					the next UpdateDerivedCurves().  The versions the file had
+//					before its first change are kept, so resampled curves
+//					which were up to date then can be partly reused.
+//
+// Input Arguments:
+//		file		= SourceFile&
+//		keptRows	= const size_t&, number of leading rows which are
+//					  unchanged; mAllRowsKept if only derived curves changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::MarkChanged(SourceFile &file, const size_t &keptRows)
+{
+	auto change(mChangedFiles.find(file.id));
+	if (change == mChangedFiles.end())
+	{
+		FileChange newChange;
+		newChange.keptRows = mAllRowsKept;
+		newChange.dataVersion = file.dataVersion;
+		newChange.timeVersion = file.timeVersion;
+		change = mChangedFiles.insert(std::make_pair(file.id, newChange)).first;
+		++file.dataVersion;
+	}
+
+	if (keptRows >= change->second.keptRows)
+		return;
+
+	if (change->second.timeVersion == file.timeVersion)
+		++file.timeVersion;
+	change->second.keptRows = keptRows;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		GetKeptRows
+//
+// Description:		Returns the number of leading rows of a file which are
+//					unchanged since the derived curves were last brought up
+//					to date.
+//
+// Input Arguments:
+//		file	= const SourceFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t, mAllRowsKept if the file hasn't changed
+//
+//==========================================================================
+size_t DataSourceManager::GetKeptRows(const SourceFile &file) const
+{
+	auto change(mChangedFiles.find(file.id));
+	if (change == mChangedFiles.end())
+		return mAllRowsKept;
+	return change->second.keptRows;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		CountUnchangedRows
+//
+// Description:		Compares a file's curves with the data it was loaded
+//					again with, to find how many leading rows are the same.
+//
+// Input Arguments:
+//		file	= const SourceFile&
+//		loaded	= const DelimitedFileLoader::LoadedFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t DataSourceManager::CountUnchangedRows(const SourceFile &file,
+	const DelimitedFileLoader::LoadedFile &loaded)
+{
+	if (loaded.columns.empty() ||
+		loaded.state.layout.timeScale != file.state.layout.timeScale)
+		return 0;
+
+	const bool decimated(file.time.GetSize() > 0);
+	size_t keptRows(mAllRowsKept);
+	for (const auto& curve : file.curves)
+	{
+		if (!IsParsed(file, curve) || curve.expression ||
+			curve.column + 1 >= loaded.columns.size())
+			continue;
+
+		const SharedColumn& column(loaded.columns[curve.column + 1]);
+		if (decimated)
+			keptRows = std::min(keptRows, CountEqualValues(curve.y.GetData(),
+				curve.y.GetSize(), column.GetData(), column.GetSize()));
+		else
+		{
+			const size_t count(curve.display->GetNumberOfPoints());
+			if (keptRows == mAllRowsKept)// Check the times once
+				keptRows = CountEqualValues(curve.display->GetXPointer(), count,
+					loaded.columns.front().GetData(), loaded.columns.front().GetSize());
+			keptRows = std::min(keptRows, CountEqualValues(curve.display->GetYPointer(),
+				count, column.GetData(), column.GetSize()));
+		}
+
+		if (keptRows == 0)
+			return 0;
+	}
+
+	if (keptRows == mAllRowsKept)
+		return 0;
+	else if (decimated)
+		keptRows = std::min(keptRows, CountEqualValues(file.time.GetData(),
+			file.time.GetSize(), loaded.columns.front().GetData(),
+			loaded.columns.front().GetSize()));
+
+	return keptRows;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		CountEqualValues
+//
+// Description:		Returns the number of leading values which are the same
+//					in both arrays (compared bit for bit, so NaNs match).
+//
+// Input Arguments:
+//		a		= const double*
+//		aCount	= const size_t&
+//		b		= const double*
+//		bCount	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t DataSourceManager::CountEqualValues(const double* a, const size_t &aCount,
+	const double* b, const size_t &bCount)
+{
+	const size_t count(std::min(aCount, bCount));
+	const size_t blockSize(1024);
+	size_t i(0);
+	while (i + blockSize <= count && memcmp(a + i, b + i, sizeof(double) * blockSize) == 0)
+		i += blockSize;
+	while (i < count && memcmp(a + i, b + i, sizeof(double)) == 0)
+		++i;
+	return i;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		UpdateDerivedCurves
+//
+// Description:		Computes the derived curves which depend (directly or
+//					through other derived curves) on files which have changed
+//					since the last update, over the rows which changed.
+//					Curves are computed a level of the dependency graph at a
+//					time; those within a level don't depend on each other,
+//					so they are evaluated in parallel.  Derived curves whose
+//					operands have been removed are removed too.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::UpdateDerivedCurves()
+{
+	if (mChangedFiles.empty())
+		return;
+
+	PerfMonitor::ScopedTimer timer("Derived curves");
+	std::vector<DerivedNode> nodes;
+	std::vector<std::vector<size_t>> levels;
+	BuildDerivedGraph(nodes, levels);
+
+	for (const auto& level : levels)
+	{
+		for (const auto& n : level)
+			FindKeptRows(nodes, n);
+	}
+
+	// Derived curves are themselves operands, so their files have changed too
+	for (const auto& node : nodes)
+	{
+		if (node.keptRows != mAllRowsKept)
+			MarkChanged(*node.file, mAllRowsKept);
+	}
+
+	bool removedAny(false);
+	std::vector<DerivedJob> jobs;
+	for (const auto& level : levels)
+	{
+		jobs.clear();
+		for (const auto& n : level)
+		{
+			DerivedNode& node(nodes[n]);
+			const bool inputRemoved(std::find_if(node.inputs.begin(), node.inputs.end(),
+				[&nodes](const size_t &input)
+			{
+				return nodes[input].removed;
+			}) != node.inputs.end());
+
+			if (!inputRemoved && node.keptRows == mAllRowsKept)
+				continue;
+
+			Curve& curve(node.file->curves[node.curve]);
+			jobs.push_back(DerivedJob());
+			if (!inputRemoved && PrepareDerivedCurve(*node.file, curve, node.keptRows, jobs.back()))
+				continue;
+
+			jobs.pop_back();
+			RemoveCurve(curve);
+			curve.display = nullptr;
+			node.removed = true;
+			removedAny = true;
+		}
+
+		ThreadPool::GetSharedPool().ParallelFor(jobs.size(), 1,
+			[this, &jobs](const size_t &begin, const size_t &end)
+		{
+			size_t i;
+			for (i = begin; i < end; ++i)
+				EvaluateDerivedCurve(jobs[i]);
+		});
+
+		for (const auto& job : jobs)
+			FinishDerivedCurve(job);
+	}
+
+	if (removedAny)
+	{
+		for (auto& file : mSourceFiles)
+			file.curves.erase(std::remove_if(file.curves.begin(), file.curves.end(),
+				[](const Curve &curve)
+			{
+				return !curve.display;
+			}), file.curves.end());
+	}
+
+	mChangedFiles.clear();
+	mDisplayChanged = true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		BuildDerivedGraph
+//
+// Description:		Builds the graph of derived curves (from files which
+//					aren't loading) and sorts them into levels, each of which
+//					only depends on the levels before it.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		nodes	= std::vector<DerivedNode>&
+//		levels	= std::vector<std::vector<size_t>>&, indices in nodes
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::BuildDerivedGraph(std::vector<DerivedNode> &nodes,
+	std::vector<std::vector<size_t>> &levels)
+{
+	std::map<const LibPlot2D::Dataset2D*, size_t> nodeIndices;
+	for (auto& file : mSourceFiles)
+	{
+		if (file.loading)
+			continue;
+
+		size_t i;
+		for (i = 0; i < file.curves.size(); ++i)
+		{
+			if (!file.curves[i].expression)
+				continue;
+
+			nodeIndices[file.curves[i].display] = nodes.size();
+			DerivedNode node;
+			node.file = &file;
+			node.curve = i;
+			nodes.push_back(node);
+		}
+	}
+
+	std::vector<size_t> pendingInputs(nodes.size(), 0);
+	std::vector<std::vector<size_t>> dependents(nodes.size());
+	size_t n;
+	for (n = 0; n < nodes.size(); ++n)
+	{
+		for (const auto& operand : nodes[n].file->curves[nodes[n].curve].operands)
+		{
+			auto input(nodeIndices.find(operand));
+			if (!operand || input == nodeIndices.end())
+				continue;
+
+			nodes[n].inputs.push_back(input->second);
+			dependents[input->second].push_back(n);
+			++pendingInputs[n];
+		}
+	}
+
+	std::vector<size_t> ready;
+	for (n = 0; n < nodes.size(); ++n)
+	{
+		if (pendingInputs[n] == 0)
+			ready.push_back(n);
+	}
+
+	while (!ready.empty())
+	{
+		levels.push_back(ready);
+		ready.clear();
+		for (const auto& input : levels.back())
+		{
+			for (const auto& dependent : dependents[input])
+			{
+				if (--pendingInputs[dependent] == 0)
+					ready.push_back(dependent);
+			}
+		}
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FindKeptRows
+//
+// Description:		Finds how many leading rows of a derived curve are
+//					unaffected by the changes to its operands (whose own
+//					kept rows must be known already).  Expressions are
+//					element-wise, so a row is unaffected if its operands'
+//					values are.  For operands from other files, these are
+//					the rows before the time of the operand's first changed
+//					sample, since resampling only uses the samples either
+//					side of each time.
+//
+// Input Arguments:
+//		nodes	= std::vector<DerivedNode>&
+//		n		= const size_t&, index of the node to update
+//
+// Output Arguments:
+//		nodes	= std::vector<DerivedNode>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FindKeptRows(std::vector<DerivedNode> &nodes, const size_t &n) const
+{
+	DerivedNode& node(nodes[n]);
+	const SourceFile& file(*node.file);
+	node.keptRows = GetKeptRows(file);
+
+	// Operands from this file first, since their rows line up with the curve's
+	// (and unless the curves are decimated, they provide the times)
+	const double* time(file.time.GetData());
+	size_t count(file.time.GetSize());
+
+	struct OtherOperand
+	{
+		const SourceFile* file;
+		const Curve* curve;
+		size_t keptRows;
+	};
+	std::vector<OtherOperand> otherOperands;
+
+	for (const auto& operand : file.curves[node.curve].operands)
+	{
+		if (!operand)
+			continue;
+
+		OtherOperand other;
+		other.curve = FindCurve(operand, &other.file);
+		if (!other.curve)
+		{
+			node.keptRows = 0;// Has been removed, so this curve will be too
+			return;
+		}
+		else if (other.file->loading)
+		{
+			node.keptRows = mAllRowsKept;// Computed again when it finishes loading
+			return;
+		}
+
+		other.keptRows = GetKeptRows(*other.file);
+		if (other.curve->expression)
+		{
+			auto input(std::find_if(node.inputs.begin(), node.inputs.end(),
+				[&nodes, &operand](const size_t &i)
+			{
+				return nodes[i].file->curves[nodes[i].curve].display == operand;
+			}));
+			other.keptRows = nodes[*input].keptRows;
+		}
+
+		if (other.file != &file)
+		{
+			if (other.keptRows != mAllRowsKept)
+				otherOperands.push_back(other);
+			continue;
+		}
+
+		node.keptRows = std::min(node.keptRows, other.keptRows);
+		if (!time)
+		{
+			time = other.curve->display->GetXPointer();
+			count = other.curve->display->GetNumberOfPoints();
+		}
+	}
+
+	for (const auto& other : otherOperands)
+	{
+		const bool decimated(other.file->time.GetSize() > 0);
+		const double* otherTime(decimated ? other.file->time.GetData() :
+			other.curve->display->GetXPointer());
+		const size_t otherCount(decimated ? other.file->time.GetSize() :
+			other.curve->display->GetNumberOfPoints());
+		const size_t keptRows(std::min(other.keptRows, otherCount));
+		if (keptRows == 0 || !time)
+		{
+			node.keptRows = 0;
+			return;
+		}
+
+		// Rows of ours before the other file's first changed sample are unaffected
+		const double changedTime(otherTime[keptRows - 1]);
+		const double timeScale(file.state.layout.timeScale / other.file->state.layout.timeScale);
+		const size_t end(std::min(node.keptRows, count));
+		size_t row(0);
+		while (row < end && time[row] * timeScale < changedTime)
+			++row;
+
+		if (row < count)
+			node.keptRows = row;
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ComputeDerivedCurve
+//
+// Description:		Evaluates a derived curve's expression over its
+//					operands' data (in place, on the pool).  Only the rows
+//					after keptRows are computed again.
+//
+// Input Arguments:
+//		file		= const SourceFile&
+//		curve		= Curve&
+//		keptRows	= const size_t&
+//
+// Output Arguments:
+//		curve		= Curve&
+//
+// Return Value:
+//		bool, false if an operand is no longer plotted
+//
+//==========================================================================
+bool DataSourceManager::ComputeDerivedCurve(const SourceFile &file, Curve &curve,
+	const size_t &keptRows)
+{
+	DerivedJob job;
+	if (!PrepareDerivedCurve(file, curve, keptRows, job))
+		return false;
+
+	EvaluateDerivedCurve(job);
+	FinishDerivedCurve(job);
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		PrepareDerivedCurve
+//
+// Description:		Finds a derived curve's operands and sizes its storage,
+//					ready for EvaluateDerivedCurve().  Operands from other
+//					files are resampled at this file's times.  Like the
+//					file's other curves, the result is decimated if they are.
+//
+// Input Arguments:
+//		file		= const SourceFile&
+//		curve		= Curve&
+//		keptRows	= const size_t&, leading rows which needn't be computed again
+//
+// Output Arguments:
+//		curve		= Curve&
+//		job			= DerivedJob&
+//
+// Return Value:
+//		bool, false if an operand is no longer plotted
+//
+//==========================================================================
+bool DataSourceManager::PrepareDerivedCurve(const SourceFile &file, Curve &curve,
+	const size_t &keptRows, DerivedJob &job)
+{
+	const bool decimate(file.time.GetSize() > 0);
+	const double* time(file.time.GetData());
+	size_t count(file.time.GetSize());
+
+	// Operands from this file come first, since (unless the curves are
+	// decimated) they provide the times
+	std::vector<const double*> columns(curve.operands.size(), nullptr);
+	std::vector<const SourceFile*> operandFiles(curve.operands.size(), nullptr);
+	std::vector<const Curve*> operands(curve.operands.size(), nullptr);
+	size_t i;
+	for (i = 1; i < curve.operands.size(); ++i)
+	{
+		if (!curve.operands[i])
+			continue;
+
+		operands[i] = FindCurve(curve.operands[i], &operandFiles[i]);
+		if (!operands[i])
+			return false;
+		else if (operandFiles[i] != &file)
+			continue;
+		else if (decimate)
+			columns[i] = operands[i]->y.GetData();
+		else
+		{
+			columns[i] = operands[i]->display->GetYPointer();
+			time = operands[i]->display->GetXPointer();
+			count = operands[i]->display->GetNumberOfPoints();
+		}
+	}
+
+	if (count == 0)
+		return false;
+	columns.front() = time;
+
+	for (i = 1; i < curve.operands.size(); ++i)
+	{
+		if (operands[i] && !columns[i])
+			columns[i] = AlignColumn(*operandFiles[i], *operands[i], file, time, count,
+				curve.alignment, keptRows);
+	}
+
+	job.file = &file;
+	job.curve = &curve;
+	job.columns = std::move(columns);
+	job.count = count;
+
+	if (!decimate)
+	{
+		job.firstRow = curve.pyramid ? 0 :
+			std::min<size_t>(keptRows, curve.display->GetNumberOfPoints());
+		curve.y = SharedColumn();
+		curve.pyramid.reset();
+		curve.display->Resize(static_cast<unsigned int>(count));
+		return true;
+	}
+
+	job.firstRow = curve.pyramid ? std::min(keptRows, curve.y.GetSize()) : 0;
+	curve.y.Resize(count);
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		EvaluateDerivedCurve
+//
+// Description:		Evaluates a prepared derived curve from job.firstRow on
+//					and updates (or builds) its pyramid.  May be called on
+//					any thread, for several curves at once.
+//
+// Input Arguments:
+//		job	= const DerivedJob&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::EvaluateDerivedCurve(const DerivedJob &job) const
+{
+	Curve& curve(*job.curve);
+	const double* time(job.columns.front());
+	if (job.file->time.GetSize() == 0)
+	{
+		memcpy(curve.display->GetXPointer() + job.firstRow, time + job.firstRow,
+			sizeof(double) * (job.count - job.firstRow));
+		curve.expression->Evaluate(job.columns, job.firstRow, job.count,
+			curve.display->GetYPointer());
+		return;
+	}
+
+	curve.expression->Evaluate(job.columns, job.firstRow, job.count,
+		curve.y.GetWritableData());
+	if (job.firstRow > 0)
+		curve.pyramid->Update(time, curve.y.GetData(), job.count, job.firstRow,
+			ThreadPool::GetSharedPool());
+	else
+		curve.pyramid.reset(new DecimationPyramid(time, curve.y.GetData(), job.count,
+			ThreadPool::GetSharedPool(), job.file->outOfCore ?
+			mOutOfCoreBucketSize : DecimationPyramid::defaultBaseBucketSize));
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FinishDerivedCurve
+//
+// Description:		Gives a derived curve with a new pyramid its display data.
+//
+// Input Arguments:
+//		job	= const DerivedJob&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FinishDerivedCurve(const DerivedJob &job)
+{
+	if (job.file->time.GetSize() == 0 || job.firstRow > 0)
+		return;
+
+	const double* time(job.columns.front());
+	FillDisplay(*job.curve, time[0], time[job.count - 1], mInitialPixelColumns);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AlignColumn
+//
+// Description:		Returns a curve from one file resampled at the times of
+//					another.  The result is cached until the source file's
+//					data or the target file's times change.  If the cached
+//					values were up to date before the changes which the
+//					derived curves are being updated for, only the rows
+//					after keptRows are resampled.
+//
+// Input Arguments:
+//		source		= const SourceFile&
+//		curve		= const Curve&, from source
+//		target		= const SourceFile&
+//		targetTime	= const double*
+//		targetCount	= const size_t&
+//		method		= const Resampler::Method&
+//		keptRows	= const size_t&, leading rows of the result which the
+//					  changes left as they were
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const double*, targetCount values
+//
+//==========================================================================
+const double* DataSourceManager::AlignColumn(const SourceFile &source, const Curve &curve,
+	const SourceFile &target, const double* targetTime, const size_t &targetCount,
+	const Resampler::Method &method, const size_t &keptRows)
+{
+	AlignedColumn& aligned(mAlignedColumns[std::make_tuple(curve.display, target.id, method)]);
+	if (aligned.sourceVersion == source.dataVersion && aligned.targetVersion == target.timeVersion
+		&& aligned.values.GetSize() == targetCount && targetCount > 0)
+		return aligned.values.GetData();
+
+	auto sourceChange(mChangedFiles.find(source.id));
+	auto targetChange(mChangedFiles.find(target.id));
+	const unsigned long long previousSourceVersion(sourceChange == mChangedFiles.end() ?
+		source.dataVersion : sourceChange->second.dataVersion);
+	const unsigned long long previousTargetVersion(targetChange == mChangedFiles.end() ?
+		target.timeVersion : targetChange->second.timeVersion);
+
+	size_t firstRow(0);
+	if (aligned.sourceVersion == previousSourceVersion &&
+		aligned.targetVersion == previousTargetVersion && aligned.values.GetSize() > 0)
+		firstRow = std::min(std::min(keptRows, aligned.values.GetSize()), targetCount);
+
+	const bool decimated(source.time.GetSize() > 0);
+	const double* sourceTime(decimated ? source.time.GetData() : curve.display->GetXPointer());
+	const double* sourceValues(decimated ? curve.y.GetData() : curve.display->GetYPointer());
+	const size_t sourceCount(decimated ? curve.y.GetSize() : curve.display->GetNumberOfPoints());
+
+	aligned.sourceVersion = source.dataVersion;
+	aligned.targetVersion = target.timeVersion;
+	aligned.values.Resize(targetCount);
+	Resampler(ThreadPool::GetSharedPool()).Resample(sourceTime, sourceValues, sourceCount,
+		targetTime + firstRow, targetCount - firstRow,
+		target.state.layout.timeScale / source.state.layout.timeScale, method,
+		aligned.values.GetWritableData() + firstRow);
+
+	return aligned.values.GetData();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ForgetAlignedColumns
+//
+// Description:		Drops resampled curves which no derived curve uses.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ForgetAlignedColumns()
+{
+	std::set<AlignmentKey> used;
+	for (const auto& file : mSourceFiles)
+	{
+		for (const auto& curve : file.curves)
+		{
+			for (const auto& operand : curve.operands)
+			{
+				if (operand)
+					used.insert(std::make_tuple(operand, file.id, curve.alignment));
+			}
+		}
+	}
+
+	auto aligned(mAlignedColumns.begin());
+	while (aligned != mAlignedColumns.end())
+	{
+		if (used.find(aligned->first) == used.end())
+			aligned = mAlignedColumns.erase(aligned);
+		else
+			++aligned;
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		SaveSession
+//
+// Description:		Writes a snapshot of the session.  Derived curves are
+//					only saved if all of their operands are (so those using
+//					curves from files which are saved by name are lost).
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		renderer	= LibPlot2D::PlotRenderer&, for the view
+//
+// Output Arguments:
+//		error		= wxString&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DataSourceManager::SaveSession(const wxString &fileName,
+	LibPlot2D::PlotRenderer &renderer, wxString &error)
+{
+	if (mPendingLoad.valid())
+	{
+		error = _T("The session can't be saved until loading has finished.");
+		return false;
+	}
+
+	PerfMonitor::ScopedTimer timer("Save session");
+	ForgetRemovedCurves();
+
+	auto getCount([](const SourceFile &file, const Curve &curve)
+	{
+		if (file.time.GetSize() > 0)
+			return curve.y.GetSize();
+		return static_cast<size_t>(curve.display->GetNumberOfPoints());
+	});
+
+	std::set<const LibPlot2D::Dataset2D*> saved;
+	for (const auto& file : mSourceFiles)
+	{
+		for (const auto& curve : file.curves)
+		{
+			if (!file.outOfCore && !curve.expression &&
+				getCount(file, curve) == GetRowCount(file))
+				saved.insert(curve.display);
+		}
+	}
+
+	bool addedAny(true);
+	while (addedAny)
+	{
+		addedAny = false;
+		for (const auto& file : mSourceFiles)
+		{
+			for (const auto& curve : file.curves)
+			{
+				if (file.outOfCore || !curve.expression ||
+					saved.find(curve.display) != saved.end() ||
+					getCount(file, curve) != GetRowCount(file) ||
+					std::find_if(curve.operands.begin(), curve.operands.end(),
+					[&saved](const LibPlot2D::Dataset2D* operand)
+				{
+					return operand && saved.find(operand) == saved.end();
+				}) != curve.operands.end())
+					continue;
+
+				saved.insert(curve.display);
+				addedAny = true;
+			}
+		}
+	}
+
+	std::map<const LibPlot2D::Dataset2D*, uint32_t> plotIndices;
+	unsigned int i;
+	for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+		plotIndices[&mPlotInterface.GetDataset(i)] = i;
+
+	SessionSnapshot snapshot(ThreadPool::GetSharedPool());
+	std::map<const LibPlot2D::Dataset2D*, std::pair<uint32_t, uint32_t>> locations;// File and curve
+	std::vector<std::tuple<uint32_t, uint32_t, const Curve*>> derivedCurves;// File, curve
+	for (const auto& file : mSourceFiles)
+	{
+		if (file.outOfCore)
+		{
+			SessionSnapshot::File reference;
+			reference.fileName = std::string(file.fileName.ToUTF8());
+			reference.mask = file.mask;
+			snapshot.referencedFiles.push_back(reference);
+			continue;
+		}
+
+		SessionSnapshot::File savedFile;
+		savedFile.fileName = std::string(file.fileName.ToUTF8());
+		savedFile.state = file.state;
+		savedFile.mask = file.mask;
+		for (const auto& curve : file.curves)
+		{
+			if (saved.find(curve.display) == saved.end())
+				continue;
+
+			const bool decimated(file.time.GetSize() > 0);
+			if (savedFile.curves.empty())
+				savedFile.time = snapshot.AddColumn(decimated ?
+					file.time.GetData() : curve.display->GetXPointer(), GetRowCount(file));
+
+			SessionSnapshot::Curve savedCurve;
+			savedCurve.plotIndex = plotIndices[curve.display];
+			savedCurve.column = curve.column;
+			savedCurve.values = snapshot.AddColumn(decimated ?
+				curve.y.GetData() : curve.display->GetYPointer(), getCount(file, curve));
+			if (curve.expression)
+			{
+				savedCurve.name = std::string(curve.expressionText.ToUTF8());
+				savedCurve.expression = savedCurve.name;
+				savedCurve.alignment = curve.alignment == Resampler::Method::ZeroOrderHold ? 1 : 0;
+			}
+			else if (curve.column + 1 < file.state.layout.headings.size())
+				savedCurve.name = file.state.layout.headings[curve.column + 1];
+
+			const auto location(std::make_pair(static_cast<uint32_t>(snapshot.files.size()),
+				static_cast<uint32_t>(savedFile.curves.size())));
+			locations[curve.display] = location;
+			if (curve.expression)
+				derivedCurves.push_back(std::make_tuple(location.first, location.second, &curve));
+			savedFile.curves.push_back(savedCurve);
+		}
+
+		if (!savedFile.curves.empty())
+			snapshot.files.push_back(savedFile);
+	}
+
+	// Operands can only be located once every curve has been placed
+	for (const auto& derived : derivedCurves)
+	{
+		const Curve& curve(*std::get<2>(derived));
+		SessionSnapshot::Curve& savedCurve(
+			snapshot.files[std::get<0>(derived)].curves[std::get<1>(derived)]);
+		uint32_t reference;
+		for (reference = 1; reference < curve.operands.size(); ++reference)
+		{
+			if (!curve.operands[reference])
+				continue;
+
+			const auto& location(locations[curve.operands[reference]]);
+			savedCurve.operands.push_back({ reference, location.first, location.second });
+		}
+	}
+
+	for (const auto& interfaceFile : mInterfaceFiles)
+		snapshot.interfaceFiles.push_back(std::string(interfaceFile.ToUTF8()));
+
+	snapshot.view.xMin = renderer.GetXMin();
+	snapshot.view.xMax = renderer.GetXMax();
+	snapshot.view.leftYMin = renderer.GetLeftYMin();
+	snapshot.view.leftYMax = renderer.GetLeftYMax();
+	snapshot.view.rightYMin = renderer.GetRightYMin();
+	snapshot.view.rightYMax = renderer.GetRightYMax();
+
+	if (!snapshot.Write(fileName))
+	{
+		error = wxString::Format(_T("Couldn't write %s."), fileName);
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		RestoreSession
+//
+// Description:		Adds the curves from a snapshot (in their original order
+//					in the plot list) and starts decompressing their data on
+//					the pool.  Each file's curves are filled in as soon as
+//					its columns have been read; anything still loading when
+//					the task finishes (damaged or cancelled) is removed, as
+//					after a load.  Files which were saved by name are loaded
+//					once the rest of the session has been restored.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		error		= wxString&
+//
+// Return Value:
+//		bool, true if the session is being restored
+//
+//==========================================================================
+bool DataSourceManager::RestoreSession(const wxString &fileName, wxString &error)
+{
+	if (mPendingLoad.valid())
+	{
+		error = _T("A session can't be opened until loading has finished.");
+		return false;
+	}
+
+	auto snapshot(std::make_shared<SessionSnapshot>(ThreadPool::GetSharedPool()));
+	if (!snapshot->Open(fileName))
+	{
+		error = wxString::Format(_T("%s is damaged or was saved by a different version."), fileName);
+		return false;
+	}
+
+	// Expressions are checked before anything is added
+	std::vector<std::vector<std::shared_ptr<CompiledExpression>>> expressions(snapshot->files.size());
+	size_t i, j;
+	for (i = 0; i < snapshot->files.size(); ++i)
+	{
+		for (const auto& savedCurve : snapshot->files[i].curves)
+		{
+			expressions[i].push_back(nullptr);
+			if (savedCurve.expression.empty())
+				continue;
+
+			std::shared_ptr<CompiledExpression> compiled(
+				std::make_shared<CompiledExpression>(ThreadPool::GetSharedPool()));
+			std::string compileError;
+			if (!compiled->Compile(savedCurve.expression, compileError))
+			{
+				error = wxString::Format(_T("%s is damaged."), fileName);
+				return false;
+			}
+
+			for (const auto& reference : compiled->GetColumns())
+			{
+				if (reference > 0 && std::find_if(savedCurve.operands.begin(),
+					savedCurve.operands.end(), [reference](const SessionSnapshot::Operand &operand)
+				{
+					return operand.reference == reference;
+				}) == savedCurve.operands.end())
+				{
+					error = wxString::Format(_T("%s is damaged."), fileName);
+					return false;
+				}
+			}
+
+			expressions[i].back() = compiled;
+		}
+	}
+
+	ForgetRemovedCurves();
+	const size_t firstFile(mSourceFiles.size());
+	std::vector<std::tuple<uint32_t, std::unique_ptr<LibPlot2D::Dataset2D>, wxString>> displays;
+	for (i = 0; i < snapshot->files.size(); ++i)
+	{
+		const SessionSnapshot::File& savedFile(snapshot->files[i]);
+		SourceFile source;
+		source.fileName = wxString::FromUTF8(savedFile.fileName.c_str());
+		source.state = savedFile.state;
+		source.mask = savedFile.mask;
+		source.loading = true;
+		source.id = ++mLastFileId;
+
+		for (j = 0; j < savedFile.curves.size(); ++j)
+		{
+			const SessionSnapshot::Curve& savedCurve(savedFile.curves[j]);
+			Curve curve;
+			curve.column = savedCurve.column;
+			curve.expression = expressions[i][j];
+			if (curve.expression)
+			{
+				curve.expressionText = wxString::FromUTF8(savedCurve.expression.c_str());
+				curve.alignment = savedCurve.alignment == 1 ?
+					Resampler::Method::ZeroOrderHold : Resampler::Method::Linear;
+			}
+
+			std::unique_ptr<LibPlot2D::Dataset2D> display(new LibPlot2D::Dataset2D);
+			curve.display = display.get();
+			source.curves.push_back(std::move(curve));
+			displays.push_back(std::make_tuple(savedCurve.plotIndex, std::move(display),
+				wxString::FromUTF8(savedCurve.name.c_str())));
+		}
+
+		// Columns which hadn't been parsed are listed again after the rest
+		for (j = 0; j < savedFile.mask.size(); ++j)
+		{
+			if (savedFile.mask[j])
+				continue;
+
+			Curve curve;
+			curve.column = j;
+
+			std::unique_ptr<LibPlot2D::Dataset2D> display(new LibPlot2D::Dataset2D);
+			curve.display = display.get();
+			mNewUnparsedCurves.insert(curve.display);
+			source.curves.push_back(std::move(curve));
+			displays.push_back(std::make_tuple(std::numeric_limits<uint32_t>::max(),
+				std::move(display), j + 1 < savedFile.state.layout.headings.size() ?
+				wxString::FromUTF8(savedFile.state.layout.headings[j + 1].c_str()) : wxString()));
+		}
+
+		mSourceFiles.push_back(std::move(source));
+	}
+
+	for (i = 0; i < snapshot->files.size(); ++i)
+	{
+		for (j = 0; j < snapshot->files[i].curves.size(); ++j)
+		{
+			Curve& curve(mSourceFiles[firstFile + i].curves[j]);
+			for (const auto& operand : snapshot->files[i].curves[j].operands)
+			{
+				if (curve.operands.size() <= operand.reference)
+					curve.operands.resize(operand.reference + 1, nullptr);
+				curve.operands[operand.reference] =
+					mSourceFiles[firstFile + operand.file].curves[operand.curve].display;
+			}
+		}
+	}
+
+	std::stable_sort(displays.begin(), displays.end(),
+		[](const std::tuple<uint32_t, std::unique_ptr<LibPlot2D::Dataset2D>, wxString> &a,
+		const std::tuple<uint32_t, std::unique_ptr<LibPlot2D::Dataset2D>, wxString> &b)
+	{
+		return std::get<0>(a) < std::get<0>(b);
+	});
+
+	for (auto& display : displays)
+		mPlotInterface.AddCurve(std::move(std::get<1>(display)), std::get<2>(display));
+
+	for (const auto& reference : snapshot->referencedFiles)
+		mQueuedLoads.push_back({ wxString::FromUTF8(reference.fileName.c_str()),
+			reference.mask, false });
+
+	if (!snapshot->interfaceFiles.empty())
+	{
+		wxArrayString interfaceList;
+		for (const auto& interfaceFile : snapshot->interfaceFiles)
+			interfaceList.Add(wxString::FromUTF8(interfaceFile.c_str()));
+
+		LoadInterfaceFiles(interfaceList);
+	}
+
+	std::vector<unsigned int> ids;
+	std::vector<std::vector<const LibPlot2D::Dataset2D*>> curveDisplays;
+	for (i = firstFile; i < mSourceFiles.size(); ++i)
+	{
+		ids.push_back(mSourceFiles[i].id);
+		curveDisplays.push_back(std::vector<const LibPlot2D::Dataset2D*>());
+		for (const auto& curve : mSourceFiles[i].curves)
+			curveDisplays.back().push_back(curve.display);
+	}
+
+	mRestoredView = snapshot->view;
+	mRestoreView = true;
+	mLoadProgress = 0.0;
+	mCancelLoad = false;
+	mPendingLoad = ThreadPool::GetSharedPool().Enqueue([this, snapshot, ids, curveDisplays]()
+	{
+		PerfMonitor::ScopedTimer timer("Restore session");
+
+		uint64_t totalValues(0);
+		uint64_t readValues(0);
+		for (const auto& file : snapshot->files)
+			totalValues += (file.curves.size() + 1) * snapshot->GetColumnSize(file.time);
+
+		try
+		{
+			size_t f;
+			for (f = 0; f < snapshot->files.size() && !mCancelLoad; ++f)
+			{
+				const SessionSnapshot::File& file(snapshot->files[f]);
+				SharedColumn time(static_cast<size_t>(snapshot->GetColumnSize(file.time)));
+				bool read(snapshot->ReadColumn(file.time, time.GetWritableData()));
+
+				RestoredValues values;
+				size_t c;
+				for (c = 0; c < file.curves.size() && read && !mCancelLoad; ++c)
+				{
+					SharedColumn column(static_cast<size_t>(
+						snapshot->GetColumnSize(file.curves[c].values)));
+					read = snapshot->ReadColumn(file.curves[c].values, column.GetWritableData());
+					values.push_back(std::make_pair(curveDisplays[f][c], column));
+
+					readValues += column.GetSize();
+					mLoadProgress = static_cast<double>(readValues) / std::max<uint64_t>(totalValues, 1);
+				}
+
+				if (!read || mCancelLoad)
+					continue;// Removed as a failed load
+
+				const unsigned int id(ids[f]);
+				mOwner.CallAfter([this, id, time, values]()
+				{
+					FillRestoredFile(id, time, values);
+				});
+			}
+		}
+		catch (const std::exception&)
+		{
+			// Whatever hasn't been filled in is removed
+		}
+
+		mOwner.CallAfter([this]()
+		{
+			std::vector<DelimitedFileLoader::LoadedFile> loadedFiles;
+			std::vector<DelimitedFileLoader::LoadedFile> addedColumns;
+			FinishLoad(loadedFiles, wxArrayString(), addedColumns);
+		});
+	});
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FillRestoredFile
+//
+// Description:		Runs on the GUI thread.  Gives the curves of a file from
+//					a restored session their data.  Derived curves get their
+//					saved results rather than being computed again.
+//
+// Input Arguments:
+//		id		= const unsigned int&, of the file
+//		time	= const SharedColumn&
+//		values	= const RestoredValues&, for each curve's display
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FillRestoredFile(const unsigned int &id, const SharedColumn &time,
+	const RestoredValues &values)
+{
+	ForgetRemovedCurves();
+	auto file(std::find_if(mSourceFiles.begin(), mSourceFiles.end(),
+		[&id](const SourceFile &f)
+	{
+		return f.loading && f.id == id;
+	}));
+
+	if (file == mSourceFiles.end())
+		return;
+
+	file->time = ShouldDecimate(time, false) ? time : SharedColumn();
+	for (auto& curve : file->curves)
+	{
+		auto value(std::find_if(values.begin(), values.end(),
+			[&curve](const std::pair<const LibPlot2D::Dataset2D*, SharedColumn> &v)
+		{
+			return v.first == curve.display;
+		}));
+
+		if (value != values.end())
+			SetCurveData(*file, curve, time.GetData(), value->second);
+	}
+
+	++file->dataVersion;
+	++file->timeVersion;
+	file->loading = false;
+
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ApplyRestoredView
+//
+// Description:		Sets the view to the one saved with the restored
+//					session.  Axes which had no range are left alone.
+//
+// Input Arguments:
+//		renderer	= LibPlot2D::PlotRenderer&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ApplyRestoredView(LibPlot2D::PlotRenderer &renderer)
+{
+	mRestoreView = false;
+
+	if (mRestoredView.xMax > mRestoredView.xMin)
+		renderer.SetXLimits(mRestoredView.xMin, mRestoredView.xMax);
+	if (mRestoredView.leftYMax > mRestoredView.leftYMin)
+		renderer.SetLeftYLimits(mRestoredView.leftYMin, mRestoredView.leftYMax);
+	if (mRestoredView.rightYMax > mRestoredView.rightYMin)
+		renderer.SetRightYLimits(mRestoredView.rightYMin, mRestoredView.rightYMax);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		UpdateDisplay
+//
+// Description:		Rebuilds the decimated curves to suit the renderer's
+//					current range and size, and redraws if anything has
+//					changed.  Does nothing otherwise, so it is cheap enough
+//					to call when idle.  The curves are decimated over the
+//					view plus mDisplayPadding view widths either side, at the
+//					same resolution, so panning within that range leaves the
+//					curve data (and whatever the renderer has built from it)
+//					unchanged.
+//
+// Input Arguments:
+//		renderer	= LibPlot2D::PlotRenderer&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::UpdateDisplay(LibPlot2D::PlotRenderer &renderer)
+{
+	// Idle events arrive during a command's dialogs; its data must stay in place
+	if (!mExpandedCurves.empty())
+		return;
+
+	if (mRestoreView && !mPendingLoad.valid())
+		ApplyRestoredView(renderer);
+
+	if (mSourceFiles.empty() && mStreams.empty() && !mDisplayChanged)
+		return;
+
+	const double xMin(renderer.GetXMin());
+	const double xMax(renderer.GetXMax());
+	const unsigned int pixelColumns(static_cast<unsigned int>(
+		std::max(renderer.GetSize().GetWidth(), 1)));
+	const double viewWidth(xMax - xMin);
+	if (xMin < mDecimatedXMin || xMax > mDecimatedXMax ||
+		std::abs(viewWidth - mDecimatedViewWidth) > mViewWidthTolerance * viewWidth ||
+		pixelColumns != mDecimatedPixelColumns)
+	{
+		PerfMonitor::ScopedTimer timer("Decimate");
+		const double padding(mDisplayPadding * viewWidth);
+		const double paddedXMin(xMin - padding);
+		const double paddedXMax(xMax + padding);
+		const unsigned int paddedPixelColumns(static_cast<unsigned int>(
+			pixelColumns * (1.0 + 2.0 * mDisplayPadding)));
+
+		ForgetRemovedCurves();
+		for (const auto& file : mSourceFiles)
+		{
+			for (const auto& curve : file.curves)
+			{
+				if (!curve.pyramid)
+					continue;
+
+				FillDisplay(curve, paddedXMin, paddedXMax, paddedPixelColumns);
+				mDisplayChanged = true;
+			}
+		}
+
+		for (const auto& stream : mStreams)
+		{
+			for (const auto& curve : stream.curves)
+			{
+				FillDisplay(curve, paddedXMin, paddedXMax, paddedPixelColumns);
+				mDisplayChanged = true;
+			}
+		}
+
+		mDecimatedXMin = paddedXMin;
+		mDecimatedXMax = paddedXMax;
+		mDecimatedViewWidth = viewWidth;
+		mDecimatedPixelColumns = pixelColumns;
+	}
+
+	if (!mDisplayChanged)
+		return;
+
+	PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+	if (monitor.IsEnabled())
+	{
+		unsigned long long pointCount(0);
+		unsigned int i;
+		for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+			pointCount += mPlotInterface.GetDataset(i).GetNumberOfPoints();
+
+		// Every curve is handed to the renderer again, each point as an x-y
+		// pair; what the renderer actually uploads isn't visible from here
+		monitor.RecordCounter("Vertex data handed to renderer (estimate) [bytes]",
+			static_cast<double>(pointCount * 2 * sizeof(double)));
+	}
+
+	PerfMonitor::ScopedTimer timer("Upload curves");
+	renderer.UpdateDisplay();
+	mDisplayChanged = false;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		StartStreams
+//
+// Description:		Starts following the specified paths.  Each one gets its
+//					own producer thread; the rows are collected on the GUI
+//					thread by ReadStreams().
+//
+// Input Arguments:
+//		pathList	= const wxArrayString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if at least one path could be opened
+//
+//==========================================================================
+bool DataSourceManager::StartStreams(const wxArrayString &pathList)
+{
+	bool startedAny(false);
+	for (const auto& path : pathList)
+	{
+		Stream stream;
+		stream.source.reset(new StreamSource(path));
+		if (!stream.source->Start())
+			continue;
+
+		mStreams.push_back(std::move(stream));
+		startedAny = true;
+	}
+
+	return startedAny;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		StopStreams
+//
+// Description:		Stops all of the producer threads.  The curves remain
+//					(and remain decimated) until they are removed.  Rows
+//					still in the ring buffers are collected by the next
+//					call to ReadStreams().
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::StopStreams()
+{
+	for (auto& stream : mStreams)
+		stream.source->Stop();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		IsStreaming
+//
+// Description:		Checks to see if any stream is still running.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DataSourceManager::IsStreaming() const
+{
+	return std::any_of(mStreams.begin(), mStreams.end(), [](const Stream &stream)
+	{
+		return !stream.source->IsFinished();
+	});
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ReadStreams
+//
+// Description:		Moves rows from the streams' ring buffers into their
+//					curves.  Only the pyramid buckets covering the new rows
+//					are recomputed.  Called on a timer from the GUI thread.
+//
+// Input Arguments:
+//		renderer	= LibPlot2D::PlotRenderer&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ReadStreams(LibPlot2D::PlotRenderer &renderer)
+{
+	// Rows wait in the sources while a command uses the full data
+	if (mStreams.empty() || !mExpandedCurves.empty())
+		return;
+
+	ForgetRemovedCurves();
+	const double previousEnd(GetStreamEnd());
+
+	bool received(false);
+	for (auto& stream : mStreams)
+	{
+		// Streams that have ended are emptied completely, as there won't be
+		// another chance
+		const bool finished(stream.source->IsFinished());
+		size_t rowCount;
+		while ((rowCount = stream.source->ReadRows(mStreamRows, mMaxStreamRows)) > 0)
+		{
+			if (stream.curvesAdded)
+				AppendStreamRows(stream, rowCount);
+			else
+				AddStreamCurves(stream, rowCount);
+
+			received = true;
+			if (!finished)
+				break;
+		}
+	}
+
+	if (!received)
+		return;
+
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+
+	const double xMin(renderer.GetXMin());
+	const double xMax(renderer.GetXMax());
+	const double shift(GetStreamEnd() - previousEnd);
+	if (previousEnd != previousEnd)// NaN - this is the first data
+		renderer.AutoScale();
+	else if (previousEnd >= xMin && previousEnd <= xMax && shift > 0.0)
+		renderer.SetXLimits(xMin + shift, xMax + shift);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		RemoveFailedStreams
+//
+// Description:		Removes the streams which ended without ever becoming
+//					ready (could not be read, or no delimited numeric data
+//					arrived).  These have no curves, so nothing else would
+//					show that they failed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxArrayString, paths of the removed streams
+//
+//==========================================================================
+wxArrayString DataSourceManager::RemoveFailedStreams()
+{
+	wxArrayString failedPaths;
+	mStreams.erase(std::remove_if(mStreams.begin(), mStreams.end(),
+		[&failedPaths](const Stream &stream)
+	{
+		// A ready stream may still have rows waiting to be read
+		if (stream.curvesAdded || stream.source->IsReady() ||
+			!stream.source->IsFinished())
+			return false;
+
+		failedPaths.Add(stream.source->GetPath());
+		return true;
+	}), mStreams.end());
+
+	return failedPaths;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AddStreamCurves
+//
+// Description:		Creates a stream's curves from its first rows and adds
+//					them to the plot.
+//
+// Input Arguments:
+//		stream		= Stream&
+//		rowCount	= const size_t&, number of rows in mStreamRows
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::AddStreamCurves(Stream &stream, const size_t &rowCount)
+{
+	const DelimitedParser::Layout& layout(stream.source->GetLayout());
+	unsigned int c;
+	for (c = 1; c < layout.columnCount; ++c)
+	{
+		Curve curve;
+		curve.column = c - 1;
+		curve.pyramid.reset(new DecimationPyramid(nullptr, nullptr, 0,
+			ThreadPool::GetSharedPool()));
+		curve.display = nullptr;
+		stream.curves.push_back(std::move(curve));
+	}
+
+	AppendStreamRows(stream, rowCount);
+
+	for (auto& curve : stream.curves)
+	{
+		std::unique_ptr<LibPlot2D::Dataset2D> display(new LibPlot2D::Dataset2D);
+		curve.display = display.get();
+		FillDisplay(curve, stream.time.GetData()[0],
+			stream.time.GetData()[stream.time.GetSize() - 1], mInitialPixelColumns);
+
+		mPlotInterface.AddCurve(std::move(display), wxString::FromUTF8(
+			layout.headings[curve.column + 1].c_str()));
+	}
+
+	stream.curvesAdded = true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		AppendStreamRows
+//
+// Description:		Appends rows from mStreamRows to a stream's curves.
+//
+// Input Arguments:
+//		stream		= Stream&
+//		rowCount	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::AppendStreamRows(Stream &stream, const size_t &rowCount)
+{
+	if (stream.curves.empty())
+		return;// All of its curves have been removed
+
+	const unsigned int columnCount(stream.source->GetLayout().columnCount);
+	const size_t oldCount(stream.time.GetSize());
+	const size_t newCount(oldCount + rowCount);
+	stream.time.Resize(newCount);
+
+	double* x(stream.time.GetWritableData() + oldCount);
+	const double* row(mStreamRows.data());
+	size_t r;
+	for (r = 0; r < rowCount; ++r, row += columnCount)
+		x[r] = row[0];
+
+	for (auto& curve : stream.curves)
+	{
+		curve.y.Resize(newCount);
+		double* y(curve.y.GetWritableData() + oldCount);
+		row = mStreamRows.data();
+		for (r = 0; r < rowCount; ++r, row += columnCount)
+			y[r] = row[curve.column + 1];
+
+		curve.pyramid->Update(stream.time.GetData(), curve.y.GetData(),
+			newCount, oldCount, ThreadPool::GetSharedPool());
+	}
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		GetStreamEnd
+//
+// Description:		Returns the largest x-value received from any stream.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, NaN if no rows have been received
+//
+//==========================================================================
+double DataSourceManager::GetStreamEnd() const
+{
+	double end(std::numeric_limits<double>::quiet_NaN());
+	for (const auto& stream : mStreams)
+	{
+		if (stream.curves.empty() || stream.time.GetSize() == 0)
+			continue;
+
+		const double last(stream.time.GetData()[stream.time.GetSize() - 1]);
+		if (end != end || last > end)
+			end = last;
+	}
+
+	return end;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ForgetRemovedCurves
+//
+// Description:		Drops curves whose display datasets have been removed
+//					from the plot (and therefore deleted), along with any
+//					finished streams that no longer have curves.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ForgetRemovedCurves()
+{
+	std::set<const LibPlot2D::Dataset2D*> plotted;
+	unsigned int i;
+	for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+		plotted.insert(&mPlotInterface.GetDataset(i));
+
+	auto isRemoved([&plotted](const Curve &curve)
+	{
+		return plotted.find(curve.display) == plotted.end();
+	});
+
+	for (auto& file : mSourceFiles)
+		file.curves.erase(std::remove_if(file.curves.begin(),
+			file.curves.end(), isRemoved), file.curves.end());
+
+	for (auto& stream : mStreams)
+		stream.curves.erase(std::remove_if(stream.curves.begin(),
+			stream.curves.end(), isRemoved), stream.curves.end());
+
+	for (auto curves : { &mInterfaceCurves, &mNewUnparsedCurves })
+	{
+		for (auto curve = curves->begin(); curve != curves->end();)
+		{
+			if (plotted.find(*curve) == plotted.end())
+				curve = curves->erase(curve);
+			else
+				++curve;
+		}
+	}
+
+	// Streams which have ended are of no further use once their curves are gone
+	mStreams.erase(std::remove_if(mStreams.begin(), mStreams.end(), [](const Stream &stream)
+	{
+		return stream.curvesAdded && stream.curves.empty() && stream.source->IsFinished();
+	}), mStreams.end());
+
+	ForgetAlignedColumns();
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ExpandDecimatedCurves
+//
+// Description:		Copies the full data of every decimated curve into its
+//					display, so LibPlot2D's operations see all of it.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		error	= wxString&
+//
+// Return Value:
+//		bool, false if some curves are too large to copy
+//
+//==========================================================================
+bool DataSourceManager::ExpandDecimatedCurves(wxString &error)
+{
+	std::vector<unsigned int> curves(mPlotInterface.GetCurveCount());
+	std::iota(curves.begin(), curves.end(), 0);
+	return ExpandDecimatedCurves(curves, error);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ExpandDecimatedCurves
+//
+// Description:		Copies the full data of the specified curves (those
+//					which are decimated) into their displays.  Other curves
+//					are left as they are.
+//
+// Input Arguments:
+//		curves	= const std::vector<unsigned int>&, indices in the plot list
+//
+// Output Arguments:
+//		error	= wxString&
+//
+// Return Value:
+//		bool, false if some of the curves are too large to copy
+//
+//==========================================================================
+bool DataSourceManager::ExpandDecimatedCurves(const std::vector<unsigned int> &curves,
+	wxString &error)
+{
+	ForgetRemovedCurves();
+
+	std::set<const LibPlot2D::Dataset2D*> displays;
+	for (const auto& i : curves)
+	{
+		if (i < mPlotInterface.GetCurveCount())
+			displays.insert(&mPlotInterface.GetDataset(i));
+	}
+
+	auto isExpanded([&displays](const Curve &curve)
+	{
+		return curve.pyramid && displays.find(curve.display) != displays.end();
+	});
+
+	for (const auto& file : mSourceFiles)
+	{
+		if (file.time.GetSize() == 0 ||
+			std::none_of(file.curves.begin(), file.curves.end(), isExpanded))
+			continue;
+		else if (file.outOfCore ||
+			file.time.GetSize() > std::numeric_limits<unsigned int>::max())
+		{
+			error = _T("Curves from ") + wxFileName(file.fileName).GetFullName()
+				+ _T(" are too large to copy, so this can't be done with them.");
+			return false;
+		}
+	}
+
+	for (const auto& file : mSourceFiles)
+	{
+		for (const auto& curve : file.curves)
+		{
+			if (!isExpanded(curve))
+				continue;
+
+			ExpandDisplay(curve, file.time.GetData());
+			mExpandedCurves.insert(curve.display);
+		}
+	}
+
+	for (const auto& stream : mStreams)
+	{
+		for (const auto& curve : stream.curves)
+		{
+			if (!isExpanded(curve))
+				continue;
+
+			ExpandDisplay(curve, stream.time.GetData());
+			mExpandedCurves.insert(curve.display);
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		RestoreDecimatedCurves
+//
+// Description:		Decimates the curves expanded by ExpandDecimatedCurves()
+//					again (over their whole range until the next update
+//					matches them to the view).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::RestoreDecimatedCurves()
+{
+	if (mExpandedCurves.empty())
+		return;
+
+	ForgetRemovedCurves();
+	auto wasExpanded([this](const Curve &curve)
+	{
+		return curve.pyramid && curve.pyramid->GetPointCount() > 0 &&
+			mExpandedCurves.find(curve.display) != mExpandedCurves.end();
+	});
+
+	for (const auto& file : mSourceFiles)
+	{
+		for (const auto& curve : file.curves)
+		{
+			if (wasExpanded(curve))
+				FillDisplay(curve, file.time.GetData()[0],
+					file.time.GetData()[curve.pyramid->GetPointCount() - 1],
+					mInitialPixelColumns);
+		}
+	}
+
+	for (const auto& stream : mStreams)
+	{
+		for (const auto& curve : stream.curves)
+		{
+			if (wasExpanded(curve))
+				FillDisplay(curve, stream.time.GetData()[0],
+					stream.time.GetData()[curve.pyramid->GetPointCount() - 1],
+					mInitialPixelColumns);
+		}
+	}
+
+	mExpandedCurves.clear();
+	mDisplayChanged = true;
+	mDecimatedPixelColumns = 0;
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		ExpandDisplay
+//
+// Description:		Copies a decimated curve's full data into its display.
+//
+// Input Arguments:
+//		curve	= const Curve&
+//		time	= const double*, at least as many values as the curve has
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::ExpandDisplay(const Curve &curve, const double* time)
+{
+	const size_t count(curve.pyramid->GetPointCount());
+	curve.display->Resize(static_cast<unsigned int>(count));
+	memcpy(curve.display->GetXPointer(), time, sizeof(double) * count);
+	memcpy(curve.display->GetYPointer(), curve.y.GetData(), sizeof(double) * count);
+}
+
+//==========================================================================
+// Class:			DataSourceManager
+// Function:		FillDisplay
+//
+// Description:		Replaces the contents of a curve's display dataset with
+//					the decimated data for the specified view.
+//
+// Input Arguments:
+//		curve			= const Curve&
+//		xMin			= const double&
+//		xMax			= const double&
+//		pixelColumns	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataSourceManager::FillDisplay(const Curve &curve,
+	const double &xMin, const double &xMax, const unsigned int &pixelColumns)
+{
+	curve.pyramid->Decimate(xMin, xMax, pixelColumns, mDecimatedX, mDecimatedY);
+
+	curve.display->Resize(static_cast<unsigned int>(mDecimatedX.size()));
+	memcpy(curve.display->GetXPointer(), mDecimatedX.data(), sizeof(double) * mDecimatedX.size());
+	memcpy(curve.display->GetYPointer(), mDecimatedY.data(), sizeof(double) * mDecimatedY.size());
+}
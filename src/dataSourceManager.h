@@ -0,0 +1,420 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dataSourceManager.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Decides how each data file is loaded and keeps track of where
+//				 the curves came from so they can be reloaded.  Very long curves
+//				 are handed to the plot in decimated form.
+// History:
+
+#ifndef DATA_SOURCE_MANAGER_H_
+#define DATA_SOURCE_MANAGER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <future>
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <set>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "parser/delimitedFileLoader.h"
+#include "parser/customFormatMatcher.h"
+#include "parser/streamSource.h"
+#include "parser/sessionSnapshot.h"
+#include "renderer/decimationPyramid.h"
+#include "signals/resampler.h"
+#include "signals/signalOperations.h"
+#include "utilities/sharedColumn.h"
+
+// Local forward declarations
+class CompiledExpression;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class GuiInterface;
+class PlotRenderer;
+class Dataset2D;
+}
+
+// Class for loading data files and tracking their origin
+class DataSourceManager
+{
+public:
+	// Curves with more than decimationPointLimit points are decimated.  Work
+	// finished in the background is handed back to the GUI thread through owner.
+	// The custom formats are read and LibPlot2D's file types are registered
+	// on the pool, so the window can be shown in the meantime.
+	DataSourceManager(wxEvtHandler &owner, LibPlot2D::GuiInterface &plotInterface,
+		const unsigned long long &decimationPointLimit);
+	~DataSourceManager();
+
+	// True once the background set-up has finished; the times are then
+	// available [usec, on PerfMonitor's clock]
+	bool IsStartupComplete() const;
+	long long GetFormatsLoadedTime() const { return mFormatsLoaded.get(); }
+	long long GetFileTypesRegisteredTime() const { return mFileTypesRegistered.get(); }
+	bool CustomDefinitionsExist() const { return mCustomDefinitionsExist; }
+
+	// Plain delimited files are parsed in the background; their curves are
+	// added as soon as their columns are known and filled in when the parse
+	// finishes.  Anything else is loaded by LibPlot2D straight away.
+	// Only the time column of very wide files is parsed; their curves are
+	// listed empty until ParseCurve() is called for them.  Session snapshots are restored.  Files opened before the custom
+	// formats have been read are loaded once they have.  Returns true if at
+	// least one file was (or is being) loaded.
+	bool LoadFiles(const wxArrayString &fileList, wxWindow* parent = nullptr);
+
+	bool IsLoading() const { return mPendingLoad.valid(); }
+	double GetLoadProgress() const { return mLoadProgress; }// Fraction completed
+	void CancelLoad();
+
+	// Parses the column of a curve which was listed empty, in the background
+	// like a load (by index in the plot list)
+	void ParseCurve(const unsigned int &index);
+
+	// Curves listed empty since the last call (by index in the plot list),
+	// which should be switched off until they are parsed
+	std::vector<unsigned int> TakeUnparsedCurves();
+
+	// Parses delimited numeric text from the clipboard.  Anything else is
+	// passed on to LibPlot2D.  Large pastes show progress (parented by
+	// parent) and can be cancelled.
+	void Paste(wxWindow* parent);
+
+	// The same for dropped text
+	void LoadText(const wxString &text, wxWindow* parent);
+
+	// Files we parsed ourselves are checked on a worker thread; rows appended
+	// since the last load are added to the existing curves, and only files
+	// which were otherwise modified are parsed again.  Only the derived curves
+	// which depend on changed data are computed again, and only from the
+	// first row which changed.  Files opened by LibPlot2D are loaded again
+	// in full, replacing only their own curves.
+	void ReloadData();
+
+	// Adds a curve computed by an expression in which [n] is the nth curve in
+	// the plot list and [0] is time.  The curves must come from files that we
+	// parsed.  The new curve uses the time base of the first curve's file;
+	// curves from other files are resampled onto it (if parent is given, the
+	// user chooses how).  The curve is computed again whenever its operands'
+	// data changes.  Returns false (with a description in error, unless the
+	// user cancelled) otherwise.
+	bool AddDerivedCurve(const wxString &expression, wxString &error,
+		wxWindow* parent = nullptr);
+
+	// Adds a curve for the derivative, integral or RMS of each of the
+	// specified curves (by index in the plot list, named by names), computed
+	// from their full data (not just the decimated points), concurrently.
+	// The results of long curves are decimated like their sources.  Curves
+	// from files used from their caches are read from the mapped cache (only
+	// the results are held in memory).  Returns false (with a description in
+	// error) if there is nothing to compute.
+	bool AddOperationCurves(const SignalOperations::Operation &operation,
+		const std::vector<unsigned int> &curves, const wxArrayString &names,
+		wxString &error);
+
+	// Rebuilds the decimated curves if the view has moved outside the range
+	// they cover (they cover some distance either side of the view, so small
+	// pans don't change the data) or has been zoomed, and redraws if a reload
+	// has changed any data
+	void UpdateDisplay(LibPlot2D::PlotRenderer &renderer);
+
+	// LibPlot2D's curve operations (FFT, filters, etc.), export and copy read the curves' datasets, which only hold the
+	// decimated points of long curves.  These give decimated curves their full
+	// data while such a command runs, and decimate them again afterwards.
+	// Curves from files used from their caches are too large to copy; if
+	// there are any, returns false (with a description in error) instead.
+	// Commands which only use some curves should only expand those (by
+	// index in the plot list).
+	bool ExpandDecimatedCurves(wxString &error);
+	bool ExpandDecimatedCurves(const std::vector<unsigned int> &curves, wxString &error);
+	void RestoreDecimatedCurves();
+
+	// Follows growing files, FIFOs or UNIX sockets; returns true if at least
+	// one could be opened
+	bool StartStreams(const wxArrayString &pathList);
+	void StopStreams();
+	bool IsStreaming() const;
+
+	// Appends the rows received since the last call; if the view showed the
+	// end of the data, it is scrolled to keep showing it
+	void ReadStreams(LibPlot2D::PlotRenderer &renderer);
+
+	// Forgets the streams that ended before sending a header or any rows;
+	// returns their paths so they can be reported
+	wxArrayString RemoveFailedStreams();
+
+	// Saves the files we parsed with all of their curves (derived curves
+	// with their results, so they needn't be computed again), the files
+	// LibPlot2D loaded and the view.  Files used from their caches are only
+	// saved by name; they are loaded again on restore.  Returns false (with a
+	// description in error) on failure.
+	bool SaveSession(const wxString &fileName, LibPlot2D::PlotRenderer &renderer,
+		wxString &error);
+
+	// Adds the snapshot's curves straight away; their data is decompressed
+	// in the background like a load, and the view is restored when it has
+	// all arrived.  Returns false (with a description in error) on failure.
+	bool RestoreSession(const wxString &fileName, wxString &error);
+
+	// Set-up shared with other users of the loader (batch mode)
+	static void LoadCustomFormats(CustomFormatMatcher &formats);
+	static void SetUpColumnCache(DelimitedFileLoader &loader);
+
+private:
+	static const unsigned int mInitialPixelColumns;
+	static const wxString mCustomFormatsFileName;
+	static const wxString mCustomFormatsCacheName;
+	static const wxString mColumnCacheDirectoryName;
+	static const size_t mMaxStreamRows;
+	static const size_t mPasteProgressSize;
+	static const size_t mOutOfCoreBucketSize;
+	static const double mDisplayPadding;
+	static const double mViewWidthTolerance;
+	static const unsigned int mUnparsedColumnCount;// Files with more data columns are parsed as needed
+	static const size_t mAllRowsKept;
+
+	wxEvtHandler &mOwner;
+	LibPlot2D::GuiInterface &mPlotInterface;
+	CustomFormatMatcher mFormats;// Must be declared before mLoader
+	DelimitedFileLoader mLoader;
+
+	const unsigned long long mDecimationPointLimit;
+
+	// Decimated curves keep the full data here, with the time column shared
+	// by every curve from the same source; other curves only have the
+	// display dataset
+	struct Curve
+	{
+		unsigned int column;// Index of the data column (time column not counted)
+		SharedColumn y;// Only for decimated curves
+		std::unique_ptr<DecimationPyramid> pyramid;
+		LibPlot2D::Dataset2D* display;// Owned by mPlotInterface
+
+		// Only for derived curves, which have no column
+		std::shared_ptr<const CompiledExpression> expression;
+		wxString expressionText;// Also the curve's name
+		std::vector<const LibPlot2D::Dataset2D*> operands;// Displays of the curves [n] refers to
+		Resampler::Method alignment = Resampler::Method::Linear;// For operands from other files
+	};
+
+	struct SourceFile
+	{
+		wxString fileName;// Empty for pasted data
+		DelimitedFileLoader::FileState state;
+		SharedColumn time;// Only if the curves are decimated
+		std::vector<Curve> curves;
+		bool outOfCore = false;// Always decimated
+		bool loading = false;// Curves are empty until the background load finishes
+		DelimitedFileLoader::ColumnMask mask;// Columns which were parsed; empty for all
+		std::vector<DelimitedParser::Chunk> rowIndex;// Only if some columns weren't parsed
+		unsigned int id;// Unique, unlike the index in mSourceFiles
+		unsigned long long dataVersion = 0;// Incremented whenever any curve's data changes
+		unsigned long long timeVersion = 0;// Incremented whenever the times change
+	};
+
+	std::vector<SourceFile> mSourceFiles;// Files loaded by mLoader
+	unsigned int mLastFileId = 0;
+
+	// Files whose data changed since the derived curves were last brought up
+	// to date (by ID), with the versions they had before the change
+	struct FileChange
+	{
+		size_t keptRows;// Leading rows which are unchanged; mAllRowsKept if only derived curves changed
+		unsigned long long dataVersion;
+		unsigned long long timeVersion;
+	};
+
+	std::map<unsigned int, FileChange> mChangedFiles;
+
+	// Derived curve in the graph of which curves are computed from which.  The
+	// operands which are derived curves are the node's inputs; the others are
+	// parsed columns.  Derived curves can only refer to curves which already
+	// exist, so the graph has no cycles.
+	struct DerivedNode
+	{
+		SourceFile* file;
+		size_t curve;// Index in file->curves
+		std::vector<size_t> inputs;
+		size_t keptRows = 0;// Leading rows which are up to date; mAllRowsKept if all are
+		bool removed = false;
+	};
+
+	// Work for computing one derived curve, prepared on the GUI thread so that
+	// curves which don't depend on each other can be evaluated together
+	struct DerivedJob
+	{
+		const SourceFile* file;
+		Curve* curve;
+		std::vector<const double*> columns;// [0] is time
+		size_t count;
+		size_t firstRow;
+	};
+
+	// Curves resampled onto the time base of another file, for derived curves
+	// which refer to several files.  Kept until the curve or the other file's
+	// times change, or no derived curve needs them.
+	struct AlignedColumn
+	{
+		unsigned long long sourceVersion = 0;// Source file's dataVersion
+		unsigned long long targetVersion = 0;// Target file's timeVersion
+		SharedColumn values;
+	};
+
+	typedef std::tuple<const LibPlot2D::Dataset2D*, unsigned int, Resampler::Method>
+		AlignmentKey;// Display of the curve, ID of the target file and method
+	std::map<AlignmentKey, AlignedColumn> mAlignedColumns;
+	wxArrayString mInterfaceFiles;// Files loaded by mPlotInterface
+	std::set<const LibPlot2D::Dataset2D*> mInterfaceCurves;// Curves those files added
+	std::set<const LibPlot2D::Dataset2D*> mNewUnparsedCurves;// For TakeUnparsedCurves()
+
+	struct ReloadJob
+	{
+		wxString fileName;
+		DelimitedFileLoader::FileState state;
+		bool outOfCore;
+		DelimitedFileLoader::ColumnMask mask;
+		DelimitedFileLoader::TailResult result;
+		DelimitedFileLoader::LoadedTail tail;
+		std::vector<DelimitedFileLoader::LoadedFile> reloaded;// Only if Modified
+	};
+
+	struct Stream
+	{
+		std::unique_ptr<StreamSource> source;
+		SharedColumn time;
+		std::vector<Curve> curves;// Always decimated; empty until the layout is known
+		bool curvesAdded = false;
+	};
+
+	std::vector<Stream> mStreams;
+	std::vector<double> mStreamRows;// Scratch space
+
+	// Returns the time at which it finished
+	std::shared_future<long long> mFormatsLoaded;// Guards mFormats and mLoader
+	std::shared_future<long long> mFileTypesRegistered;// Guards mPlotInterface's file types
+	bool mCustomDefinitionsExist;// Set with mFileTypesRegistered
+
+	void WaitForFormats() const { mFormatsLoaded.wait(); }
+	void WaitForFileTypes() const { mFileTypesRegistered.wait(); }
+	bool AreFormatsLoaded() const;
+
+	// Files opened before the custom formats were read; loaded on the GUI
+	// thread once they have been
+	std::vector<std::pair<wxArrayString, wxWindow*>> mWaitingFiles;
+	void LoadWaitingFiles();
+
+	std::future<void> mPendingReload;
+	bool mReloadQueued = false;// Requested while a load or reload was running
+
+	std::future<void> mPendingLoad;
+	std::atomic<double> mLoadProgress;
+	std::atomic<bool> mCancelLoad;
+
+	struct LoadRequest
+	{
+		wxString fileName;
+		DelimitedFileLoader::ColumnMask mask;// Empty for all columns
+		bool addColumns;// True to parse more columns of a file which is already loaded
+	};
+
+	std::vector<LoadRequest> mQueuedLoads;// Requested while a load was running
+	bool mDisplayChanged = false;
+	std::set<const LibPlot2D::Dataset2D*> mExpandedCurves;// Decimated curves whose displays hold the full data
+
+	SessionSnapshot::View mRestoredView;
+	bool mRestoreView = false;// Once the session being restored has finished loading
+
+	// Range covered by the decimated curves and the view they were made for
+	double mDecimatedXMin = 0.0;
+	double mDecimatedXMax = 0.0;
+	double mDecimatedViewWidth = 0.0;
+	unsigned int mDecimatedPixelColumns = 0;
+
+	std::vector<double> mDecimatedX;// Scratch space
+	std::vector<double> mDecimatedY;
+
+	DelimitedFileLoader::ColumnMask GetInitialMask(const wxString &fileName) const;
+	bool LoadText(const char* data, const size_t &size, wxWindow* parent);
+	bool StartLoad(const std::vector<LoadRequest> &requests);
+	void FinishLoad(std::vector<DelimitedFileLoader::LoadedFile> &loadedFiles,
+		const wxArrayString &failedFiles,
+		std::vector<DelimitedFileLoader::LoadedFile> &addedColumns);
+	void AddCurves(DelimitedFileLoader::LoadedFile &file);
+	void AddEmptyCurves(const wxString &fileName, const wxArrayString &descriptions,
+		const DelimitedFileLoader::ColumnMask &mask);
+	bool FillColumnCurves(SourceFile &file, DelimitedFileLoader::LoadedFile &loaded);
+	void FillCurves(SourceFile &file, DelimitedFileLoader::LoadedFile &loaded);
+	static bool IsParsed(const SourceFile &file, const Curve &curve);
+	static size_t GetRowCount(const SourceFile &file);
+	bool ShouldDecimate(const SharedColumn &time, const bool &outOfCore) const;
+	void StopDecimating(SourceFile &file);
+	void SetCurveData(const SourceFile &file, Curve &curve, const double* time,
+		const SharedColumn &values);
+
+	typedef std::vector<std::pair<const LibPlot2D::Dataset2D*, SharedColumn>> RestoredValues;
+	void FillRestoredFile(const unsigned int &id, const SharedColumn &time,
+		const RestoredValues &values);
+	void ApplyRestoredView(LibPlot2D::PlotRenderer &renderer);
+	void RemoveCurve(const Curve &curve);
+	const Curve* FindCurve(const LibPlot2D::Dataset2D* display,
+		const SourceFile** file = nullptr) const;
+	bool FindDecimatedData(const LibPlot2D::Dataset2D* display, SharedColumn &time,
+		SharedColumn &values) const;
+
+	void MarkChanged(SourceFile &file, const size_t &keptRows);
+	size_t GetKeptRows(const SourceFile &file) const;
+	static size_t CountUnchangedRows(const SourceFile &file,
+		const DelimitedFileLoader::LoadedFile &loaded);
+	static size_t CountEqualValues(const double* a, const size_t &aCount,
+		const double* b, const size_t &bCount);
+
+	void UpdateDerivedCurves();
+	void BuildDerivedGraph(std::vector<DerivedNode> &nodes,
+		std::vector<std::vector<size_t>> &levels);
+	void FindKeptRows(std::vector<DerivedNode> &nodes, const size_t &n) const;
+	bool ComputeDerivedCurve(const SourceFile &file, Curve &curve, const size_t &keptRows);
+	bool PrepareDerivedCurve(const SourceFile &file, Curve &curve, const size_t &keptRows,
+		DerivedJob &job);
+	void EvaluateDerivedCurve(const DerivedJob &job) const;
+	void FinishDerivedCurve(const DerivedJob &job);
+	const double* AlignColumn(const SourceFile &source, const Curve &curve,
+		const SourceFile &target, const double* targetTime, const size_t &targetCount,
+		const Resampler::Method &method, const size_t &keptRows);
+	void ForgetAlignedColumns();
+	void ReloadInterfaceFiles();
+	bool LoadInterfaceFiles(const wxArrayString &fileList);
+	bool IsOwnCurve(const LibPlot2D::Dataset2D* display) const;
+	void ReloadFiles(const std::vector<wxString> &fileNames);
+
+	void CheckFiles(std::vector<ReloadJob> &jobs);
+	void ApplyReload(std::vector<ReloadJob> &jobs);
+	void AppendRows(SourceFile &file, const DelimitedFileLoader::LoadedTail &tail);
+	bool ReplaceData(SourceFile &file, DelimitedFileLoader::LoadedFile &loaded);
+
+	void AddStreamCurves(Stream &stream, const size_t &rowCount);
+	void AppendStreamRows(Stream &stream, const size_t &rowCount);
+	double GetStreamEnd() const;
+
+	void ForgetRemovedCurves();
+	static void ExpandDisplay(const Curve &curve, const double* time);
+	void FillDisplay(const Curve &curve, const double &xMin,
+		const double &xMax, const unsigned int &pixelColumns);
+};
+
+#endif// DATA_SOURCE_MANAGER_H_
@@ -20,16 +20,21 @@
 // wxWidgets headers
 #include <wx/colordlg.h>
 #include <wx/splitter.h>
+#include <wx/tglbtn.h>
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+#include <wx/ffile.h>
+#include <wx/datetime.h>
 
 // Local headers
 #include "mainFrame.h"
 #include "plotterApp.h"
+#include "utilities/perfMonitor.h"
 
 // LibPlot2D headers
 #include <lp2d/gui/plotListGrid.h>
 #include <lp2d/renderer/plotRenderer.h>
 #include <lp2d/utilities/guiUtilities.h>
-#include <lp2d/parser/customFileFormat.h>
 #include <lp2d/libPlot2D.h>
 
 // *nix Icons
@@ -62,13 +67,21 @@
 //
 //==========================================================================
 const unsigned long long MainFrame::mHighQualityCurvePointLimit(10000);
+const int MainFrame::mStreamReadInterval(50);
+const int MainFrame::mLoadProgressInterval(100);
+const int MainFrame::mLoadGaugeRange(1000);
+const int MainFrame::mPerformanceInterval(500);
+const wxString MainFrame::mStartupLogFileName(_T("startup.log"));
+const int MainFrame::mVisibleColumn(static_cast<int>(LibPlot2D::PlotListGrid::Column::Visible));
 
 //==========================================================================
 // Class:			MainFrame
 // Function:		MainFrame
 //
 // Description:		Constructor for MainFrame class.  Initializes the form
-//					and creates the controls, etc.
+//					and creates the controls, etc.  Anything which can wait
+//					until the window is shown is left to mDataSources'
+//					background tasks.
 //
 // Input Arguments:
 //		None
@@ -81,16 +94,14 @@ const unsigned long long MainFrame::mHighQualityCurvePointLimit(10000);
 //
 //==========================================================================
 MainFrame::MainFrame() : wxFrame(NULL, wxID_ANY, wxEmptyString,
-	wxDefaultPosition, wxDefaultSize, wxDEFAULT_FRAME_STYLE), mPlotInterface(this)
+	wxDefaultPosition, wxDefaultSize, wxDEFAULT_FRAME_STYLE), mPlotInterface(this),
+	mDataSources(*this, mPlotInterface, mHighQualityCurvePointLimit),
+	mStreamTimer(this, idStreamTimer), mLoadTimer(this, idLoadTimer),
+	mPerformanceTimer(this, idPerformanceTimer), mFirstFrameTime(-1), mStartupReported(false)
 {
 	CreateControls();
 	SetProperties();
-
-	mPlotInterface.RegisterAllBuiltInFileTypes();
-
-	if (!LibPlot2D::CustomFileFormat::CustomDefinitionsExist())
-		wxMessageBox(_T("Warning:  Custom file definitions not found!"),
-		_T("Custom File Formats"), wxICON_WARNING, this);
+	mControlsCreatedTime = PerfMonitor::GetSharedMonitor().GetTime();
 
 	srand(time(nullptr));
 
@@ -144,10 +155,17 @@ void MainFrame::CreateControls()
 	wxPanel *lowerPanel = new wxPanel(splitter);
 	wxBoxSizer *lowerSizer = new wxBoxSizer(wxHORIZONTAL);
 	lowerSizer->Add(CreateButtons(lowerPanel), 0, wxGROW | wxALL, 5);
-	lowerSizer->Add(new LibPlot2D::PlotListGrid(mPlotInterface, lowerPanel), 1, wxGROW | wxALL, 5);
+	mPlotList = new LibPlot2D::PlotListGrid(mPlotInterface, lowerPanel);
+	mPlotList->Bind(wxEVT_MENU, &MainFrame::OnPlotListMenu, this);
+	mPlotList->Bind(wxEVT_GRID_CELL_LEFT_CLICK, &MainFrame::OnPlotListClick, this);
+	lowerSizer->Add(mPlotList, 1, wxGROW | wxALL, 5);
 	lowerPanel->SetSizer(lowerSizer);
 
 	CreatePlotArea(splitter);
+
+	SetDropTarget(new DropTarget(*this));
+	mPlotArea->SetDropTarget(new DropTarget(*this));
+	mPlotList->SetDropTarget(new DropTarget(*this));
 	splitter->SplitHorizontally(mPlotArea, lowerPanel, mPlotArea->GetSize().GetHeight());
 	splitter->SetSize(GetClientSize());
 	splitter->SetSashGravity(1.0);
@@ -161,7 +179,8 @@ void MainFrame::CreateControls()
 // Class:			MainFrame
 // Function:		CreatePlotArea
 //
-// Description:		Creates the main plot control.
+// Description:		Creates the main plot control.  Multisampling is used
+//					unless it is unsupported or rendering is in software.
 //
 // Input Arguments:
 //		parent	= wxWindow*
@@ -175,18 +194,63 @@ void MainFrame::CreateControls()
 //==========================================================================
 LibPlot2D::PlotRenderer* MainFrame::CreatePlotArea(wxWindow *parent)
 {
-	wxGLAttributes displayAttributes;
-	displayAttributes.PlatformDefaults().RGBA().DoubleBuffer().SampleBuffers(1).Samplers(4).Stencil(1).EndList();
+	// Software rasterizers shade every sample, so multisampling multiplies
+	// the cost of each redraw; it's only used where it's likely to be done
+	// in hardware (and is supported at all)
+	wxGLAttributes multisampledAttributes;
+	multisampledAttributes.PlatformDefaults().RGBA().DoubleBuffer().SampleBuffers(1).Samplers(4).Stencil(1).EndList();
+	wxGLAttributes singleSampledAttributes;
+	singleSampledAttributes.PlatformDefaults().RGBA().DoubleBuffer().Stencil(1).EndList();
+
+	const bool multisample(!IsSoftwareRenderingRequested() &&
+		wxGLCanvas::IsDisplaySupported(multisampledAttributes));
+	const wxGLAttributes& displayAttributes(multisample ?
+		multisampledAttributes : singleSampledAttributes);
 	assert(wxGLCanvas::IsDisplaySupported(displayAttributes));
 	mPlotArea = new LibPlot2D::PlotRenderer(mPlotInterface, *parent, wxID_ANY, displayAttributes);
 
 	mPlotArea->SetMinSize(wxSize(650, 320));
 	mPlotArea->SetMajorGridOn();
 	mPlotArea->SetCurveQuality(LibPlot2D::PlotRenderer::CurveQuality::HighWrite);
+	mPlotArea->Bind(wxEVT_PAINT, &MainFrame::OnPlotPaint, this);
+
+	// Only shown while performance monitoring is on
+	mPerformanceOverlay = new wxStaticText(mPlotArea, wxID_ANY, wxEmptyString, wxPoint(5, 5));
+	mPerformanceOverlay->SetFont(wxFont(wxFontInfo(8).Family(wxFONTFAMILY_TELETYPE)));
+	mPerformanceOverlay->SetBackgroundColour(*wxWHITE);
+	mPerformanceOverlay->Hide();
 
 	return mPlotArea;
 }
 
+//==========================================================================
+// Class:			MainFrame
+// Function:		IsSoftwareRenderingRequested
+//
+// Description:		Checks the environment for the variables which select
+//					Mesa's software rasterizers (as used in VMs and headless
+//					sessions).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool MainFrame::IsSoftwareRenderingRequested()
+{
+	wxString value;
+	if (wxGetEnv(_T("LIBGL_ALWAYS_SOFTWARE"), &value) && !value.IsEmpty() && value != _T("0"))
+		return true;
+
+	return wxGetEnv(_T("GALLIUM_DRIVER"), &value) &&
+		(value == _T("llvmpipe") || value == _T("softpipe"));
+}
+
 //==========================================================================
 // Class:			MainFrame
 // Function:		CreateButtons
@@ -215,6 +279,23 @@ wxBoxSizer* MainFrame::CreateButtons(wxWindow *parent)
 	topSizer->Add(new wxButton(parent, idButtonRemoveCurve, _T("&Remove")), 1, wxGROW);
 	topSizer->Add(new wxButton(parent, idButtonReloadData, _T("Reload &Data")), 1, wxGROW);
 
+	wxButton *expressionButton = new wxButton(parent, idButtonExpression, _T("&Expression"));
+	expressionButton->SetToolTip(_T("Add a curve calculated from other curves; it is recalculated when they are reloaded"));
+	topSizer->Add(expressionButton, 1, wxGROW);
+
+	mFollowButton = new wxToggleButton(parent, idButtonFollow, _T("&Follow"));
+	mFollowButton->SetToolTip(_T("Plot rows as they are written to files, FIFOs or sockets"));
+	topSizer->Add(mFollowButton, 1, wxGROW);
+
+	// Only shown while files are loading in the background
+	mLoadGauge = new wxGauge(parent, wxID_ANY, mLoadGaugeRange);
+	topSizer->Add(mLoadGauge, 0, wxGROW | wxTOP, 5);
+	mCancelLoadButton = new wxButton(parent, idButtonCancelLoad, _T("&Cancel"));
+	mCancelLoadButton->SetToolTip(_T("Stop loading files"));
+	topSizer->Add(mCancelLoadButton, 1, wxGROW);
+	mLoadGauge->Hide();
+	mCancelLoadButton->Hide();
+
 	buttonSizer->AddStretchSpacer(1);
 	buttonSizer->Add(CreateVersionText(parent));
 
@@ -288,13 +369,16 @@ void MainFrame::SetProperties()
 	SetIcon(wxIcon(plots128_xpm));
 #endif
 
-	const int entryCount(5);
+	const int entryCount(8);
 	wxAcceleratorEntry entries[entryCount];
 	entries[0].Set(wxACCEL_CTRL, static_cast<int>('c'), idCopyEvent);
 	entries[1].Set(wxACCEL_CTRL, static_cast<int>('v'), idPasteEvent);
 	entries[2].Set(wxACCEL_CTRL, static_cast<int>('o'), idButtonOpen);
 	entries[3].Set(wxACCEL_CTRL, static_cast<int>('a'), idButtonAutoScale);
 	entries[4].Set(wxACCEL_CTRL, static_cast<int>('r'), idButtonRemoveCurve);
+	entries[5].Set(wxACCEL_CTRL | wxACCEL_SHIFT, static_cast<int>('p'), idTogglePerformance);
+	entries[6].Set(wxACCEL_CTRL | wxACCEL_SHIFT, static_cast<int>('t'), idExportTrace);
+	entries[7].Set(wxACCEL_CTRL, static_cast<int>('s'), idSaveSession);
 	wxAcceleratorTable accel(entryCount, entries);
 	SetAcceleratorTable(accel);
 }
@@ -320,9 +404,19 @@ BEGIN_EVENT_TABLE(MainFrame, wxFrame)
 	EVT_BUTTON(idButtonAutoScale,		MainFrame::ButtonAutoScaleClickedEvent)
 	EVT_BUTTON(idButtonRemoveCurve,		MainFrame::ButtonRemoveCurveClickedEvent)
 	EVT_BUTTON(idButtonReloadData,		MainFrame::ButtonReloadDataClickedEvent)
+	EVT_BUTTON(idButtonExpression,		MainFrame::ButtonExpressionClickedEvent)
+	EVT_TOGGLEBUTTON(idButtonFollow,	MainFrame::ButtonFollowToggledEvent)
+	EVT_BUTTON(idButtonCancelLoad,		MainFrame::ButtonCancelLoadClickedEvent)
 	EVT_MENU(idCopyEvent,				MainFrame::CopyEvent)
 	EVT_MENU(idPasteEvent,				MainFrame::PasteEvent)
+	EVT_MENU(idTogglePerformance,		MainFrame::TogglePerformanceEvent)
+	EVT_MENU(idExportTrace,				MainFrame::ExportTraceEvent)
+	EVT_MENU(idSaveSession,				MainFrame::SaveSessionEvent)
 	EVT_CLOSE(							MainFrame::OnClose)
+	EVT_IDLE(							MainFrame::OnIdle)
+	EVT_TIMER(idStreamTimer,			MainFrame::OnStreamTimer)
+	EVT_TIMER(idLoadTimer,				MainFrame::OnLoadTimer)
+	EVT_TIMER(idPerformanceTimer,		MainFrame::OnPerformanceTimer)
 END_EVENT_TABLE();
 
 //==========================================================================
@@ -348,6 +442,7 @@ void MainFrame::ButtonOpenClickedEvent(wxCommandEvent& WXUNUSED(event))
 	wxString wildcard("All files (*)|*");
 	wildcard.append("|Comma Separated (*.csv)|*.csv");
 	wildcard.append("|Tab Delimited (*.txt)|*.txt");
+	wildcard.append("|Sessions (*.dps)|*.dps");
 
 	wxArrayString fileList = LibPlot2D::GuiUtilities::GetFileNameFromUser(this,
 		_T("Open Data File"), wxEmptyString, wxEmptyString, wildcard,
@@ -356,7 +451,108 @@ void MainFrame::ButtonOpenClickedEvent(wxCommandEvent& WXUNUSED(event))
 	if (fileList.GetCount() == 0)
 		return;
 
-	mPlotInterface.LoadFiles(fileList);
+	LoadFiles(fileList);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		LoadFiles
+//
+// Description:		Loads the specified files (delimited files in the
+//					background) and names the window after the first.
+//
+// Input Arguments:
+//		fileList	= const wxArrayString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if at least one file was (or is being) loaded
+//
+//==========================================================================
+bool MainFrame::LoadFiles(const wxArrayString &fileList)
+{
+	if (!mDataSources.LoadFiles(fileList, this))
+		return false;
+
+	SetTitleFromFileName(fileList[0]);
+	return true;
+}
+
+//==========================================================================
+// Class:			MainFrame::DropTarget
+// Function:		DropTarget
+//
+// Description:		Constructor for DropTarget class.  Accepts files and
+//					text.
+//
+// Input Arguments:
+//		frame	= MainFrame&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MainFrame::DropTarget::DropTarget(MainFrame &frame) : mFrame(frame),
+	mFileData(new wxFileDataObject), mTextData(new wxTextDataObject)
+{
+	wxDataObjectComposite *data = new wxDataObjectComposite;
+	data->Add(mFileData, true);
+	data->Add(mTextData);
+	SetDataObject(data);
+}
+
+//==========================================================================
+// Class:			MainFrame::DropTarget
+// Function:		OnData
+//
+// Description:		Handles files or text dropped onto the frame.  They are
+//					loaded once the drop has returned, since loading may ask
+//					which columns to load and the application the data was
+//					dragged from waits for the drop to finish.
+//
+// Input Arguments:
+//		x				= wxCoord (unused)
+//		y				= wxCoord (unused)
+//		defaultResult	= wxDragResult
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxDragResult
+//
+//==========================================================================
+wxDragResult MainFrame::DropTarget::OnData(wxCoord WXUNUSED(x),
+	wxCoord WXUNUSED(y), wxDragResult defaultResult)
+{
+	if (!GetData())
+		return wxDragNone;
+
+	MainFrame &frame(mFrame);
+	const wxDataObjectComposite *data(static_cast<wxDataObjectComposite*>(GetDataObject()));
+	if (data->GetReceivedFormat() == wxDF_FILENAME)
+	{
+		const wxArrayString fileList(mFileData->GetFilenames());
+		frame.CallAfter([&frame, fileList]()
+		{
+			frame.LoadFiles(fileList);
+		});
+	}
+	else
+	{
+		const wxString text(mTextData->GetText());
+		frame.CallAfter([&frame, text]()
+		{
+			frame.mDataSources.LoadText(text, &frame);
+		});
+	}
+
+	return defaultResult;
 }
 
 //==========================================================================
@@ -377,6 +573,7 @@ void MainFrame::ButtonOpenClickedEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::ButtonAutoScaleClickedEvent(wxCommandEvent& WXUNUSED(event))
 {
+	PerfMonitor::ScopedTimer timer("Auto scale");
 	mPlotArea->AutoScale();
 }
 
@@ -419,7 +616,106 @@ void MainFrame::ButtonRemoveCurveClickedEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::ButtonReloadDataClickedEvent(wxCommandEvent& WXUNUSED(event))
 {
-	mPlotInterface.ReloadData();
+	mDataSources.ReloadData();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ButtonExpressionClickedEvent
+//
+// Description:		Event fires when user clicks "Expression" button.  Asks
+//					for an expression and adds a curve for it.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ButtonExpressionClickedEvent(wxCommandEvent& WXUNUSED(event))
+{
+	wxTextEntryDialog dialog(this, _T("Expression ([n] is curve n, [0] is time):"),
+		_T("Add Derived Curve"), _T("[1]"));
+	if (dialog.ShowModal() != wxID_OK)
+		return;
+
+	wxString error;
+	if (!mDataSources.AddDerivedCurve(dialog.GetValue(), error, this) && !error.IsEmpty())
+		wxMessageBox(error, _T("Expression Error"), wxICON_ERROR, this);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ButtonFollowToggledEvent
+//
+// Description:		Event fires when user toggles the "Follow" button.  When
+//					switched on, asks for the files (or FIFOs or sockets) to
+//					follow.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ButtonFollowToggledEvent(wxCommandEvent& event)
+{
+	if (!event.IsChecked())
+	{
+		mStreamTimer.Stop();
+		mDataSources.StopStreams();
+		ReadStreams();// Collect the rows left in the ring buffers
+		return;
+	}
+
+	wxString wildcard("All files (*)|*");
+	wildcard.append("|Comma Separated (*.csv)|*.csv");
+	wildcard.append("|Tab Delimited (*.txt)|*.txt");
+
+	// Not wxFD_FILE_MUST_EXIST, so FIFO and socket paths can be typed in
+	wxArrayString pathList = LibPlot2D::GuiUtilities::GetFileNameFromUser(this,
+		_T("Follow Data Stream"), wxEmptyString, wxEmptyString, wildcard,
+		wxFD_OPEN | wxFD_MULTIPLE);
+
+	if (pathList.GetCount() == 0 || !mDataSources.StartStreams(pathList))
+	{
+		mFollowButton->SetValue(false);
+		return;
+	}
+
+	SetTitleFromFileName(pathList[0]);
+	mStreamTimer.Start(mStreamReadInterval);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ButtonCancelLoadClickedEvent
+//
+// Description:		Event fires when user clicks "Cancel" button.  The
+//					curves of the files being loaded are removed once the
+//					load has stopped.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ButtonCancelLoadClickedEvent(wxCommandEvent& WXUNUSED(event))
+{
+	mDataSources.CancelLoad();
 }
 
 //==========================================================================
@@ -440,7 +736,15 @@ void MainFrame::ButtonReloadDataClickedEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::CopyEvent(wxCommandEvent& WXUNUSED(event))
 {
+	wxString error;
+	if (!mDataSources.ExpandDecimatedCurves(error))
+	{
+		wxMessageBox(error, _T("Copy"), wxICON_WARNING, this);
+		return;
+	}
+
 	mPlotInterface.Copy();
+	mDataSources.RestoreDecimatedCurves();
 }
 
 //==========================================================================
@@ -461,7 +765,82 @@ void MainFrame::CopyEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::PasteEvent(wxCommandEvent& WXUNUSED(event))
 {
-	mPlotInterface.Paste();
+	mDataSources.Paste(this);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		TogglePerformanceEvent
+//
+// Description:		Event fires when user uses CTRL-SHIFT-P.  Switches
+//					performance monitoring, and its overlay on the plot,
+//					on or off.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::TogglePerformanceEvent(wxCommandEvent& WXUNUSED(event))
+{
+	PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+	monitor.SetEnabled(!monitor.IsEnabled());
+	if (monitor.IsEnabled())
+	{
+		mPerformanceOverlay->SetLabel(_T("Performance monitoring on"));
+		mPerformanceOverlay->Show();
+		mPerformanceTimer.Start(mPerformanceInterval);
+	}
+	else
+	{
+		mPerformanceTimer.Stop();
+		mPerformanceOverlay->Hide();
+	}
+
+	mPlotArea->Refresh();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ExportTraceEvent
+//
+// Description:		Event fires when user uses CTRL-SHIFT-T.  Writes what
+//					has been recorded since monitoring was switched on as a
+//					Chrome trace.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ExportTraceEvent(wxCommandEvent& WXUNUSED(event))
+{
+	if (!PerfMonitor::GetSharedMonitor().IsEnabled())
+	{
+		wxMessageBox(_T("Switch performance monitoring on (Ctrl+Shift+P) and repeat the slow operation first."),
+			_T("Export Trace"), wxICON_INFORMATION, this);
+		return;
+	}
+
+	wxArrayString fileList = LibPlot2D::GuiUtilities::GetFileNameFromUser(this,
+		_T("Export Trace"), wxEmptyString, _T("trace.json"),
+		_T("Chrome trace (*.json)|*.json"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+	if (fileList.GetCount() == 0)
+		return;
+
+	if (!PerfMonitor::GetSharedMonitor().ExportChromeTrace(std::string(fileList[0].ToUTF8())))
+		wxMessageBox(_T("Failed to write ") + fileList[0], _T("Export Trace"),
+			wxICON_ERROR, this);
 }
 
 //==========================================================================
@@ -487,6 +866,38 @@ void MainFrame::SetTitleFromFileName(wxString pathAndFileName)
 	SetTitle(fileName.Mid(0, end) + _T(" - ") + DataPlotterApp::dataPlotterTitle);
 }
 
+//==========================================================================
+// Class:			MainFrame
+// Function:		SaveSessionEvent
+//
+// Description:		Event fires when user uses CTRL-s.  Saves the session
+//					(the files, derived curves and view) so it can be opened
+//					again without loading and computing everything again.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::SaveSessionEvent(wxCommandEvent& WXUNUSED(event))
+{
+	wxArrayString fileList = LibPlot2D::GuiUtilities::GetFileNameFromUser(this,
+		_T("Save Session"), wxEmptyString, _T("session.dps"),
+		_T("Sessions (*.dps)|*.dps"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+	if (fileList.GetCount() == 0)
+		return;
+
+	wxBusyCursor wait;
+	wxString error;
+	if (!mDataSources.SaveSession(fileList[0], *mPlotArea, error))
+		wxMessageBox(error, _T("Save Session"), wxICON_ERROR, this);
+}
+
 //==========================================================================
 // Class:			MainFrame
 // Function:		OnClose
@@ -511,6 +922,543 @@ void MainFrame::OnClose(wxCloseEvent& event)
 	event.Skip();
 }
 
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnIdle
+//
+// Description:		Idle event handler.  Switches off curves which were
+//					listed without their data, keeps decimated curves
+//					matched to the current view after panning, zooming or
+//					resizing, redraws once a background reload has been
+//					applied, and shows the progress of background loads
+//					(however they were started).
+//
+// Input Arguments:
+//		event	= wxIdleEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnIdle(wxIdleEvent& event)
+{
+	HideUnparsedCurves();
+	mDataSources.UpdateDisplay(*mPlotArea);
+	if (mDataSources.IsLoading() && !mLoadTimer.IsRunning())
+	{
+		ShowLoadProgress(true);
+		mLoadTimer.Start(mLoadProgressInterval);
+	}
+
+	if (!mStartupReported && mFirstFrameTime >= 0 && mDataSources.IsStartupComplete())
+		ReportStartup();
+
+	event.Skip();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnStreamTimer
+//
+// Description:		Collects the rows received from the followed streams.
+//					Releases the "Follow" button when they have all ended.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnStreamTimer(wxTimerEvent& WXUNUSED(event))
+{
+	ReadStreams();
+	if (mDataSources.IsStreaming())
+		return;
+
+	mStreamTimer.Stop();
+	mFollowButton->SetValue(false);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ReadStreams
+//
+// Description:		Adds the rows received from the followed streams to the
+//					plot, and reports the streams that ended without sending
+//					any data.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ReadStreams()
+{
+	mDataSources.ReadStreams(*mPlotArea);
+	mDataSources.UpdateDisplay(*mPlotArea);
+
+	const wxArrayString failedPaths(mDataSources.RemoveFailedStreams());
+	if (failedPaths.IsEmpty())
+		return;
+
+	wxString message(_T("No delimited numeric data was received from:"));
+	for (const auto& path : failedPaths)
+		message.append(_T("\n") + path);
+	wxMessageBox(message, _T("Follow Data Stream"), wxICON_WARNING, this);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnLoadTimer
+//
+// Description:		Updates the load progress gauge, and hides it once the
+//					background load has finished.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnLoadTimer(wxTimerEvent& WXUNUSED(event))
+{
+	if (mDataSources.IsLoading())
+	{
+		mLoadGauge->SetValue(static_cast<int>(mDataSources.GetLoadProgress() * mLoadGaugeRange));
+		return;
+	}
+
+	mLoadTimer.Stop();
+	ShowLoadProgress(false);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnPerformanceTimer
+//
+// Description:		Refreshes the performance overlay.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnPerformanceTimer(wxTimerEvent& WXUNUSED(event))
+{
+	const wxString summary(wxString::FromUTF8(
+		PerfMonitor::GetSharedMonitor().GetSummary().c_str()).Trim());
+	if (summary.IsEmpty() || summary == mPerformanceOverlay->GetLabel())
+		return;
+
+	mPerformanceOverlay->SetLabel(summary);
+	mPerformanceOverlay->SetSize(mPerformanceOverlay->GetBestSize());
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnPlotPaint
+//
+// Description:		Paint event handler for the plot, which runs before the
+//					renderer's own.  Frame time is measured from here until
+//					the event loop is next free, by which time the renderer
+//					has drawn and swapped buffers, and the points of the
+//					curves which are switched on are counted for each frame.
+//					The first frame's end is kept for the start-up times.
+//
+// Input Arguments:
+//		event	= wxPaintEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnPlotPaint(wxPaintEvent& event)
+{
+	if (mFirstFrameTime < 0)
+	{
+		CallAfter([this]()
+		{
+			if (mFirstFrameTime < 0)
+				mFirstFrameTime = PerfMonitor::GetSharedMonitor().GetTime();
+		});
+	}
+
+	PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+	if (monitor.IsEnabled())
+	{
+		const long long start(monitor.GetTime());
+		CallAfter([start]()
+		{
+			PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+			monitor.RecordDuration("Frame", start, monitor.GetTime());
+		});
+
+		monitor.RecordCounter("Points per frame", static_cast<double>(CountVisiblePoints()));
+	}
+
+	event.Skip();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		CountVisiblePoints
+//
+// Description:		Counts the points of the curves which are switched on in
+//					the plot list, which are the ones the renderer draws.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned long long
+//
+//==========================================================================
+unsigned long long MainFrame::CountVisiblePoints() const
+{
+	unsigned long long pointCount(0);
+	unsigned int i;
+	for (i = 0; i < mPlotInterface.GetCurveCount(); ++i)
+	{
+		if (!mPlotList->GetCellValue(i + 1, mVisibleColumn).IsEmpty())// Row 0 is time
+			pointCount += mPlotInterface.GetDataset(i).GetNumberOfPoints();
+	}
+
+	return pointCount;
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnPlotListMenu
+//
+// Description:		Handles the plot list's context menu commands before
+//					the list does.  Derivatives, integrals and RMS are
+//					computed here.  The list's other commands which read
+//					curve data read the curves' datasets, so the decimated
+//					curves they use are given their full data while the list
+//					handles the command.  Other commands are left to the list.
+//
+// Input Arguments:
+//		event	= &wxCommandEvent
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnPlotListMenu(wxCommandEvent& event)
+{
+	const PlotListCommand command(GetPlotListCommand(event));
+	if (command == PlotListCommand::NoData)
+	{
+		event.Skip();
+		return;
+	}
+	else if (command == PlotListCommand::Derivative || command == PlotListCommand::Integral ||
+		command == PlotListCommand::RootMeanSquare)
+	{
+		AddOperationCurves(command);
+		return;
+	}
+
+	wxString error;
+	if ((command == PlotListCommand::AllData && !mDataSources.ExpandDecimatedCurves(error)) ||
+		(command == PlotListCommand::SelectedData &&
+		!mDataSources.ExpandDecimatedCurves(GetSelectedCurves(), error)))
+	{
+		wxMessageBox(error, _T("Curve Operation"), wxICON_WARNING, this);
+		return;
+	}
+
+	// Handled here (rather than skipped) so the curves can be decimated again
+	// once the list has finished with them
+	mPlotList->Unbind(wxEVT_MENU, &MainFrame::OnPlotListMenu, this);
+	mPlotList->GetEventHandler()->ProcessEvent(event);
+	mPlotList->Bind(wxEVT_MENU, &MainFrame::OnPlotListMenu, this);
+
+	mDataSources.RestoreDecimatedCurves();
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		OnPlotListClick
+//
+// Description:		Watches for curves being switched on in the plot list.
+//					The curves of very wide files are listed without their
+//					data, and a column is only parsed (in the background)
+//					once its curve is switched on.  The list toggles the
+//					check box itself, so it is read after the list has
+//					handled the click.
+//
+// Input Arguments:
+//		event	= wxGridEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::OnPlotListClick(wxGridEvent& event)
+{
+	event.Skip();
+	if (event.GetCol() != mVisibleColumn || event.GetRow() < 1)
+		return;
+
+	const int row(event.GetRow());
+	CallAfter([this, row]()
+	{
+		if (row < mPlotList->GetNumberRows() &&
+			!mPlotList->GetCellValue(row, mVisibleColumn).IsEmpty())
+			mDataSources.ParseCurve(row - 1);// Row 0 is time
+	});
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		HideUnparsedCurves
+//
+// Description:		Switches off the curves which have been listed without
+//					their data, so switching one on asks for it.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::HideUnparsedCurves()
+{
+	for (const auto& curve : mDataSources.TakeUnparsedCurves())
+	{
+		mPlotList->SetCellValue(curve + 1, mVisibleColumn, wxEmptyString);
+		mPlotInterface.UpdateCurveProperties(curve);
+	}
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		GetPlotListCommand
+//
+// Description:		Decides which curves' data a plot list context menu
+//					command reads.  The list's command IDs are private to
+//					LibPlot2D, so its commands are told apart by their menu
+//					labels; unknown commands are assumed to read the
+//					selected curves.
+//
+// Input Arguments:
+//		event	= const wxCommandEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PlotListCommand
+//
+//==========================================================================
+MainFrame::PlotListCommand MainFrame::GetPlotListCommand(const wxCommandEvent &event)
+{
+	const wxMenu* menu(wxDynamicCast(event.GetEventObject(), wxMenu));
+	if (!menu)
+		return PlotListCommand::SelectedData;
+
+	const wxString label(menu->GetLabelText(event.GetId()));
+	if (label == _T("Plot Derivative"))
+		return PlotListCommand::Derivative;
+	else if (label == _T("Plot Integral"))
+		return PlotListCommand::Integral;
+	else if (label == _T("Plot RMS"))
+		return PlotListCommand::RootMeanSquare;
+	else if (label == _T("Remove Curve") || label == _T("Create Signal") ||
+		label == _T("Set Time Units") || label == _T("Scale X Data"))
+		return PlotListCommand::NoData;
+	else if (label == _T("Add Math Channel") || label == _T("Frequency Response"))
+		return PlotListCommand::AllData;
+
+	return PlotListCommand::SelectedData;
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		GetSelectedCurves
+//
+// Description:		Returns the indices of the curves selected in the plot
+//					list.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<unsigned int>
+//
+//==========================================================================
+std::vector<unsigned int> MainFrame::GetSelectedCurves() const
+{
+	// The list's first row is the time (x-axis) row, not a curve
+	std::vector<unsigned int> curves;
+	const wxArrayInt rows(mPlotList->GetSelectedRows());
+	for (const auto& row : rows)
+	{
+		if (row > 0)
+			curves.push_back(row - 1);
+	}
+
+	return curves;
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		AddOperationCurves
+//
+// Description:		Adds the derivative, integral or RMS of each selected
+//					curve, computed from its full data.
+//
+// Input Arguments:
+//		command	= const PlotListCommand&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::AddOperationCurves(const PlotListCommand &command)
+{
+	SignalOperations::Operation operation;
+	wxString prefix, suffix(_T(")"));
+	if (command == PlotListCommand::Derivative)
+	{
+		operation = SignalOperations::Operation::Derivative;
+		prefix = _T("d/dt(");
+	}
+	else if (command == PlotListCommand::Integral)
+	{
+		operation = SignalOperations::Operation::Integral;
+		prefix = _T("Integral(");
+		suffix = _T(")dt");
+	}
+	else
+	{
+		operation = SignalOperations::Operation::RootMeanSquare;
+		prefix = _T("RMS(");
+	}
+
+	// The curves' names are in the list's first column
+	const std::vector<unsigned int> curves(GetSelectedCurves());
+	wxArrayString names;
+	for (const auto& curve : curves)
+		names.Add(prefix + mPlotList->GetCellValue(curve + 1, 0) + suffix);
+
+	wxString error;
+	if (!mDataSources.AddOperationCurves(operation, curves, names, error))
+		wxMessageBox(error, _T("Curve Operation"), wxICON_WARNING, this);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ReportStartup
+//
+// Description:		Appends the start-up times to the log in the user data
+//					directory (one line per start, so they can be compared
+//					over time) and warns if the custom file definitions
+//					weren't found.  Called once, when the window has been
+//					drawn and the background set-up has finished.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ReportStartup()
+{
+	mStartupReported = true;
+
+	// [msec since DataPlotterApp::OnInit]
+	const double controlsTime(mControlsCreatedTime * 1.0e-3);
+	const double firstFrameTime(mFirstFrameTime * 1.0e-3);
+	const double formatsTime(mDataSources.GetFormatsLoadedTime() * 1.0e-3);
+	const double fileTypesTime(mDataSources.GetFileTypesRegisteredTime() * 1.0e-3);
+
+	wxFFile log(wxStandardPaths::Get().GetUserDataDir()
+		+ wxFileName::GetPathSeparator() + mStartupLogFileName, _T("a"));
+	if (log.IsOpened())
+		log.Write(wxDateTime::Now().FormatISOCombined(' ') + wxString::Format(
+			_T("  controls %.0f ms, first frame %.0f ms, custom formats %.0f ms, file types %.0f ms, ready %.0f ms\n"),
+			controlsTime, firstFrameTime, formatsTime, fileTypesTime,
+			std::max(firstFrameTime, std::max(formatsTime, fileTypesTime))));
+
+	if (!mDataSources.CustomDefinitionsExist())
+		wxMessageBox(_T("Warning:  Custom file definitions not found!"),
+		_T("Custom File Formats"), wxICON_WARNING, this);
+}
+
+//==========================================================================
+// Class:			MainFrame
+// Function:		ShowLoadProgress
+//
+// Description:		Shows or hides the load progress gauge and its "Cancel"
+//					button.
+//
+// Input Arguments:
+//		show	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MainFrame::ShowLoadProgress(const bool &show)
+{
+	mLoadGauge->SetValue(0);
+	mLoadGauge->Show(show);
+	mCancelLoadButton->Show(show);
+	mLoadGauge->GetParent()->Layout();
+}
+
 //==========================================================================
 // Class:			None
 // Function:		TestSignalOperations
@@ -21,6 +21,10 @@
 
 // wxWidgets headers
 #include <wx/wx.h>
+#include <wx/dnd.h>
+
+// Local headers
+#include "dataSourceManager.h"
 
 // Standard C++ headers
 #include <vector>
@@ -28,6 +32,7 @@
 // wxWidgets forward declarations
 class wxGrid;
 class wxGridEvent;
+class wxToggleButton;
 
 // LibPlot2D forward declarations
 namespace LibPlot2D
@@ -45,19 +50,41 @@ public:
 
 private:
 	static const unsigned long long mHighQualityCurvePointLimit;
+	static const int mStreamReadInterval;// [msec]
+	static const int mLoadProgressInterval;// [msec]
+	static const int mLoadGaugeRange;
+	static const int mPerformanceInterval;// [msec]
+	static const wxString mStartupLogFileName;
+	static const int mVisibleColumn;// In the plot list
 
 	LibPlot2D::GuiInterface mPlotInterface;
+	DataSourceManager mDataSources;
 
 	// Functions that do some of the frame initialization and control positioning
 	void CreateControls();
 	void SetProperties();
 
 	LibPlot2D::PlotRenderer* CreatePlotArea(wxWindow *parent);
+	static bool IsSoftwareRenderingRequested();
 	wxBoxSizer* CreateButtons(wxWindow *parent);
 	wxWindow* CreateVersionText(wxWindow *parent);
 
 	// Controls
 	LibPlot2D::PlotRenderer *mPlotArea;
+	LibPlot2D::PlotListGrid *mPlotList;
+	wxToggleButton *mFollowButton;
+	wxGauge *mLoadGauge;
+	wxButton *mCancelLoadButton;
+	wxStaticText *mPerformanceOverlay;// Child of mPlotArea
+
+	wxTimer mStreamTimer;
+	wxTimer mLoadTimer;
+	wxTimer mPerformanceTimer;
+
+	// [usec, on PerfMonitor's clock]
+	long long mControlsCreatedTime;
+	long long mFirstFrameTime;// Negative until the plot is first drawn
+	bool mStartupReported;
 
 	// The event IDs
 	enum MainFrameEventID
@@ -66,9 +93,19 @@ private:
 		idButtonAutoScale,
 		idButtonRemoveCurve,
 		idButtonReloadData,
+		idButtonExpression,
+		idButtonFollow,
+		idButtonCancelLoad,
 
 		idCopyEvent,
-		idPasteEvent
+		idPasteEvent,
+		idTogglePerformance,
+		idExportTrace,
+		idSaveSession,
+
+		idStreamTimer,
+		idLoadTimer,
+		idPerformanceTimer
 	};
 
 	// Button events
@@ -76,12 +113,67 @@ private:
 	void ButtonAutoScaleClickedEvent(wxCommandEvent &event);
 	void ButtonRemoveCurveClickedEvent(wxCommandEvent &event);
 	void ButtonReloadDataClickedEvent(wxCommandEvent &event);
+	void ButtonExpressionClickedEvent(wxCommandEvent &event);
+	void ButtonFollowToggledEvent(wxCommandEvent &event);
+	void ButtonCancelLoadClickedEvent(wxCommandEvent &event);
 
 	// Shortcut-only events
 	void CopyEvent(wxCommandEvent &event);
 	void PasteEvent(wxCommandEvent &event);
+	void TogglePerformanceEvent(wxCommandEvent &event);
+	void ExportTraceEvent(wxCommandEvent &event);
+	void SaveSessionEvent(wxCommandEvent &event);
 
 	void OnClose(wxCloseEvent& event);
+	void OnIdle(wxIdleEvent& event);
+	void OnStreamTimer(wxTimerEvent& event);
+	void OnLoadTimer(wxTimerEvent& event);
+	void OnPerformanceTimer(wxTimerEvent& event);
+	void OnPlotPaint(wxPaintEvent& event);
+	unsigned long long CountVisiblePoints() const;
+	void OnPlotListMenu(wxCommandEvent& event);
+	void OnPlotListClick(wxGridEvent& event);
+
+	// Curve data read by plot list context menu commands
+	enum class PlotListCommand
+	{
+		NoData,// Colour, removal, etc.
+		SelectedData,// Curve operations on the selected curves
+		AllData,// Commands which may refer to any curve
+
+		// Computed here rather than by the list
+		Derivative,
+		Integral,
+		RootMeanSquare
+	};
+
+	static PlotListCommand GetPlotListCommand(const wxCommandEvent &event);
+	std::vector<unsigned int> GetSelectedCurves() const;
+	void AddOperationCurves(const PlotListCommand &command);
+
+	bool LoadFiles(const wxArrayString &fileList);
+	void HideUnparsedCurves();
+	void ReadStreams();
+
+	// Loads dropped files the same way as File->Open (in the background, for
+	// delimited files) and dropped text the same way as pasted text;
+	// replaces LibPlot2D's drop targets, which load files on the GUI thread
+	class DropTarget : public wxDropTarget
+	{
+	public:
+		explicit DropTarget(MainFrame &frame);
+		wxDragResult OnData(wxCoord x, wxCoord y, wxDragResult defaultResult) override;
+
+	private:
+		MainFrame &mFrame;
+
+		// Owned by the composite data object
+		wxFileDataObject *mFileData;
+		wxTextDataObject *mTextData;
+	};
+
+	void ReportStartup();
+	void ShowLoadProgress(const bool &show);
 
 	void SetTitleFromFileName(wxString pathAndFileName);
 
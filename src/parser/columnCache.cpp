@@ -0,0 +1,613 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  columnCache.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Binary, columnar copy of a parsed data file.  Reopening a file
+//				 whose cache is current maps the cache instead of parsing text.
+//				 Files too large to hold in memory are parsed straight into
+//				 a new cache.
+// History:
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+// wxWidgets headers
+#include <wx/filename.h>
+
+// Local headers
+#include "parser/columnCache.h"
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for ColumnCache class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char ColumnCache::mMagic[4] = { 'D', 'P', 'C', 'C' };
+const uint32_t ColumnCache::mVersion(3);
+const uint64_t ColumnCache::mPageSize(4096);
+const uint64_t ColumnCache::mHeaderLength(sizeof(mMagic) + sizeof(mVersion) + 2 * sizeof(uint64_t));
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		GetFileName
+//
+// Description:		Returns the name of the cache for the specified data file.
+//					Caches are named after a hash of the data file's absolute
+//					path, so each data file has at most one cache.
+//
+// Input Arguments:
+//		directory		= const wxString&
+//		dataFileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString
+//
+//==========================================================================
+wxString ColumnCache::GetFileName(const wxString &directory,
+	const wxString &dataFileName)
+{
+	const std::string path(GetKeyPath(dataFileName));
+	const uint64_t hash(DelimitedFileLoader::ComputeChecksum(
+		path.data(), path.data() + path.size()));
+	return directory + wxFileName::GetPathSeparator()
+		+ wxString::Format(_T("%016llx.columns"), static_cast<unsigned long long>(hash));
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Open
+//
+// Description:		Maps the cache and checks that it belongs to the current
+//					version of the data file.
+//
+// Input Arguments:
+//		cacheFile			= const wxString&
+//		dataFileName		= const wxString&
+//		size				= const uint64_t&, current size of the data file
+//		modificationTime	= const wxLongLong_t&, of the data file
+//		formatStamp			= const uint64_t&, from CustomFormatMatcher::GetStamp()
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the cache is current
+//
+//==========================================================================
+bool ColumnCache::Open(const wxString &cacheFile, const wxString &dataFileName,
+	const uint64_t &size, const wxLongLong_t &modificationTime,
+	const uint64_t &formatStamp)
+{
+	if (!wxFileName::FileExists(cacheFile) ||
+		!mFile.Open(std::string(cacheFile.ToUTF8())) || !mFile.GetData())
+		return false;
+
+	const char* data(mFile.GetData());
+	const uint64_t headerLength(mHeaderLength);
+	uint32_t version;
+	uint64_t metadataLength;
+	if (mFile.GetSize() < headerLength || memcmp(data, mMagic, sizeof(mMagic)) != 0)
+	{
+		mFile.Close();
+		return false;
+	}
+
+	memcpy(&version, data + sizeof(mMagic), sizeof(version));
+	memcpy(&metadataLength, data + sizeof(mMagic) + sizeof(version), sizeof(metadataLength));
+	memcpy(&mRowCount, data + sizeof(mMagic) + sizeof(version) + sizeof(metadataLength),
+		sizeof(mRowCount));
+	if (version != mVersion || metadataLength > mFile.GetSize() - headerLength ||
+		mRowCount > mFile.GetSize() / sizeof(double))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	std::istringstream stream(std::string(data + headerLength, metadataLength));
+	std::string path;
+	uint64_t stamp;
+	if (!ReadMetadata(stream, path, stamp, mState) || path != GetKeyPath(dataFileName) ||
+		mState.size != size || mState.modificationTime != modificationTime ||
+		stamp != formatStamp || mState.layout.columnCount == 0)
+	{
+		mFile.Close();
+		return false;
+	}
+
+	mFirstColumnOffset = RoundUpToPage(headerLength + metadataLength);
+	mColumnStride = RoundUpToPage(sizeof(double) * mRowCount);
+	if (mFirstColumnOffset + mColumnStride * (mState.layout.columnCount - 1)
+		+ sizeof(double) * mRowCount > mFile.GetSize())
+	{
+		mFile.Close();
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		GetColumn
+//
+// Description:		Returns the values in the specified column.
+//
+// Input Arguments:
+//		column	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const double*, GetRowCount() values
+//
+//==========================================================================
+const double* ColumnCache::GetColumn(const unsigned int &column) const
+{
+	return reinterpret_cast<const double*>(mFile.GetData()
+		+ mFirstColumnOffset + mColumnStride * column);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Write
+//
+// Description:		Writes a cache for the specified data file.
+//
+// Input Arguments:
+//		cacheFile		= const wxString&
+//		dataFileName	= const wxString&
+//		formatStamp		= const uint64_t&
+//		state			= const DelimitedFileLoader::FileState&
+//		columns			= const std::vector<const double*>&
+//		rowCount		= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ColumnCache::Write(const wxString &cacheFile, const wxString &dataFileName,
+	const uint64_t &formatStamp, const DelimitedFileLoader::FileState &state,
+	const std::vector<const double*> &columns, const uint64_t &rowCount)
+{
+	if (columns.size() != state.layout.columnCount || columns.empty())
+		return false;
+
+	std::ostringstream metadataStream;
+	WriteMetadata(metadataStream, GetKeyPath(dataFileName), formatStamp, state);
+	const std::string metadata(metadataStream.str());
+	const uint64_t metadataLength(metadata.size());
+
+	const uint64_t headerLength(mHeaderLength);
+	const uint64_t firstColumnOffset(RoundUpToPage(headerLength + metadataLength));
+	const uint64_t columnLength(sizeof(double) * rowCount);
+	const std::vector<char> padding(mPageSize, 0);
+
+	const wxString tempFile(GetTemporaryFileName(cacheFile));
+	{
+		std::ofstream stream(tempFile.fn_str(), std::ios::binary | std::ios::trunc);
+		if (!stream.is_open())
+			return false;
+
+		stream.write(mMagic, sizeof(mMagic));
+		stream.write(reinterpret_cast<const char*>(&mVersion), sizeof(mVersion));
+		stream.write(reinterpret_cast<const char*>(&metadataLength), sizeof(metadataLength));
+		stream.write(reinterpret_cast<const char*>(&rowCount), sizeof(rowCount));
+		stream.write(metadata.data(), metadata.size());
+		stream.write(padding.data(), firstColumnOffset - headerLength - metadataLength);
+
+		unsigned int c;
+		for (c = 0; c < columns.size(); ++c)
+		{
+			stream.write(reinterpret_cast<const char*>(columns[c]), columnLength);
+			if (c + 1 < columns.size())
+				stream.write(padding.data(), RoundUpToPage(columnLength) - columnLength);
+		}
+
+		if (!stream)
+		{
+			stream.close();
+			wxRemoveFile(tempFile);
+			return false;
+		}
+	}
+
+	return wxRenameFile(tempFile, cacheFile, true);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Create
+//
+// Description:		Creates a cache (under a temporary name) to be filled in
+//					place.  The metadata is written by Finish(), but its
+//					length depends only on the path and the layout, so the
+//					columns can be placed now.
+//
+// Input Arguments:
+//		cacheFile		= const wxString&
+//		dataFileName	= const wxString&
+//		formatStamp		= const uint64_t&
+//		layout			= const DelimitedParser::Layout&
+//		rowCount		= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ColumnCache::Create(const wxString &cacheFile, const wxString &dataFileName,
+	const uint64_t &formatStamp, const DelimitedParser::Layout &layout,
+	const uint64_t &rowCount)
+{
+	if (layout.columnCount == 0 || rowCount == 0)
+		return false;
+
+	DelimitedFileLoader::FileState state;
+	state.layout = layout;
+	std::ostringstream metadataStream;
+	WriteMetadata(metadataStream, GetKeyPath(dataFileName), formatStamp, state);
+
+	mMetadataLength = metadataStream.str().size();
+	mRowCount = rowCount;
+	mFirstColumnOffset = RoundUpToPage(mHeaderLength + mMetadataLength);
+	mColumnStride = RoundUpToPage(sizeof(double) * rowCount);
+	mState = state;
+	mCacheFileName = cacheFile;
+	mDataFileName = dataFileName;
+	mFormatStamp = formatStamp;
+
+	return mFile.Create(std::string(GetTemporaryFileName(cacheFile).ToUTF8()),
+		mFirstColumnOffset + mColumnStride * (layout.columnCount - 1)
+		+ sizeof(double) * rowCount);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		GetWritableColumn
+//
+// Description:		Returns the storage for the specified column of a cache
+//					being filled.
+//
+// Input Arguments:
+//		column	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double*, GetRowCount() values
+//
+//==========================================================================
+double* ColumnCache::GetWritableColumn(const unsigned int &column)
+{
+	return reinterpret_cast<double*>(mFile.GetWritableData()
+		+ mFirstColumnOffset + mColumnStride * column);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Finish
+//
+// Description:		Writes the header and metadata of a cache created by
+//					Create(), gives it its final name and maps it read-only.
+//					If it can't be renamed, the temporary file is used.
+//
+// Input Arguments:
+//		state	= const DelimitedFileLoader::FileState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the cache is open
+//
+//==========================================================================
+bool ColumnCache::Finish(const DelimitedFileLoader::FileState &state)
+{
+	char* data(mFile.GetWritableData());
+	if (!data)
+		return false;
+
+	std::ostringstream metadataStream;
+	WriteMetadata(metadataStream, GetKeyPath(mDataFileName), mFormatStamp, state);
+	const std::string metadata(metadataStream.str());
+	const wxString tempFile(GetTemporaryFileName(mCacheFileName));
+	if (metadata.size() != mMetadataLength ||
+		state.layout.columnCount != mState.layout.columnCount)
+	{
+		mFile.Close();
+		wxRemoveFile(tempFile);
+		return false;
+	}
+
+	memcpy(data, mMagic, sizeof(mMagic));
+	memcpy(data + sizeof(mMagic), &mVersion, sizeof(mVersion));
+	memcpy(data + sizeof(mMagic) + sizeof(mVersion), &mMetadataLength, sizeof(mMetadataLength));
+	memcpy(data + sizeof(mMagic) + sizeof(mVersion) + sizeof(mMetadataLength),
+		&mRowCount, sizeof(mRowCount));
+	memcpy(data + mHeaderLength, metadata.data(), metadata.size());
+	mFile.Close();
+
+	const wxString cacheFile(wxRenameFile(tempFile, mCacheFileName, true) ? mCacheFileName : tempFile);
+	return Open(cacheFile, mDataFileName, state.size, state.modificationTime, mFormatStamp);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		Discard
+//
+// Description:		Closes a cache created by Create() without finishing it,
+//					and deletes the partially written file.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ColumnCache::Discard()
+{
+	if (!mFile.GetWritableData())
+		return;
+
+	mFile.Close();
+	wxRemoveFile(GetTemporaryFileName(mCacheFileName));
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		GetKeyPath
+//
+// Description:		Returns the absolute path of the data file, which is
+//					what identifies it in the cache.
+//
+// Input Arguments:
+//		dataFileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string, UTF-8
+//
+//==========================================================================
+std::string ColumnCache::GetKeyPath(const wxString &dataFileName)
+{
+	wxFileName fileName(dataFileName);
+	fileName.MakeAbsolute();
+	return std::string(fileName.GetFullPath().ToUTF8());
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		RoundUpToPage
+//
+// Description:		Rounds the value up to a multiple of the page size.
+//
+// Input Arguments:
+//		value	= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint64_t
+//
+//==========================================================================
+uint64_t ColumnCache::RoundUpToPage(const uint64_t &value)
+{
+	return (value + mPageSize - 1) / mPageSize * mPageSize;
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		WriteMetadata
+//
+// Description:		Writes the key and the file state.
+//
+// Input Arguments:
+//		stream		= std::ostream&
+//		path		= const std::string&
+//		formatStamp	= const uint64_t&
+//		state		= const DelimitedFileLoader::FileState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ColumnCache::WriteMetadata(std::ostream &stream, const std::string &path,
+	const uint64_t &formatStamp, const DelimitedFileLoader::FileState &state)
+{
+	WriteString(stream, path);
+	stream.write(reinterpret_cast<const char*>(&formatStamp), sizeof(formatStamp));
+	stream.write(reinterpret_cast<const char*>(&state.size), sizeof(state.size));
+	const int64_t modificationTime(state.modificationTime);
+	stream.write(reinterpret_cast<const char*>(&modificationTime), sizeof(modificationTime));
+
+	const DelimitedParser::Layout& layout(state.layout);
+	stream.write(&layout.delimiter, sizeof(layout.delimiter));
+	stream.write(&layout.decimalSeparator, sizeof(layout.decimalSeparator));
+	const uint32_t columnCount(layout.columnCount);
+	stream.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+	const uint64_t dataStart(layout.dataStart);
+	stream.write(reinterpret_cast<const char*>(&dataStart), sizeof(dataStart));
+
+	const uint32_t headingCount(static_cast<uint32_t>(layout.headings.size()));
+	stream.write(reinterpret_cast<const char*>(&headingCount), sizeof(headingCount));
+	for (const auto& heading : layout.headings)
+		WriteString(stream, heading);
+
+	const uint32_t scaleCount(static_cast<uint32_t>(layout.scales.size()));
+	stream.write(reinterpret_cast<const char*>(&scaleCount), sizeof(scaleCount));
+	stream.write(reinterpret_cast<const char*>(layout.scales.data()),
+		sizeof(double) * scaleCount);
+	stream.write(reinterpret_cast<const char*>(&layout.timeScale), sizeof(layout.timeScale));
+
+	stream.write(reinterpret_cast<const char*>(&state.parsedLength), sizeof(state.parsedLength));
+	const char hasPartialRow(state.hasPartialRow ? 1 : 0);
+	stream.write(&hasPartialRow, sizeof(hasPartialRow));
+	stream.write(reinterpret_cast<const char*>(&state.headerChecksum), sizeof(state.headerChecksum));
+	stream.write(reinterpret_cast<const char*>(&state.tailChecksum), sizeof(state.tailChecksum));
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		ReadMetadata
+//
+// Description:		Reads what WriteMetadata() wrote.
+//
+// Input Arguments:
+//		stream		= std::istream&
+//
+// Output Arguments:
+//		path		= std::string&
+//		formatStamp	= uint64_t&
+//		state		= DelimitedFileLoader::FileState&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ColumnCache::ReadMetadata(std::istream &stream, std::string &path,
+	uint64_t &formatStamp, DelimitedFileLoader::FileState &state)
+{
+	const uint32_t maxCount(1 << 24);
+
+	if (!ReadString(stream, path))
+		return false;
+
+	int64_t modificationTime;
+	stream.read(reinterpret_cast<char*>(&formatStamp), sizeof(formatStamp));
+	stream.read(reinterpret_cast<char*>(&state.size), sizeof(state.size));
+	stream.read(reinterpret_cast<char*>(&modificationTime), sizeof(modificationTime));
+	state.modificationTime = modificationTime;
+
+	DelimitedParser::Layout& layout(state.layout);
+	uint32_t columnCount;
+	uint64_t dataStart;
+	uint32_t headingCount;
+	stream.read(&layout.delimiter, sizeof(layout.delimiter));
+	stream.read(&layout.decimalSeparator, sizeof(layout.decimalSeparator));
+	stream.read(reinterpret_cast<char*>(&columnCount), sizeof(columnCount));
+	stream.read(reinterpret_cast<char*>(&dataStart), sizeof(dataStart));
+	stream.read(reinterpret_cast<char*>(&headingCount), sizeof(headingCount));
+	if (!stream || headingCount != columnCount || columnCount > maxCount)
+		return false;
+
+	layout.columnCount = columnCount;
+	layout.dataStart = static_cast<size_t>(dataStart);
+	layout.headings.resize(headingCount);
+	for (auto& heading : layout.headings)
+	{
+		if (!ReadString(stream, heading))
+			return false;
+	}
+
+	uint32_t scaleCount;
+	stream.read(reinterpret_cast<char*>(&scaleCount), sizeof(scaleCount));
+	if (!stream || (scaleCount != 0 && scaleCount != columnCount))
+		return false;
+
+	layout.scales.resize(scaleCount);
+	stream.read(reinterpret_cast<char*>(layout.scales.data()), sizeof(double) * scaleCount);
+	stream.read(reinterpret_cast<char*>(&layout.timeScale), sizeof(layout.timeScale));
+
+	char hasPartialRow;
+	stream.read(reinterpret_cast<char*>(&state.parsedLength), sizeof(state.parsedLength));
+	stream.read(&hasPartialRow, sizeof(hasPartialRow));
+	stream.read(reinterpret_cast<char*>(&state.headerChecksum), sizeof(state.headerChecksum));
+	stream.read(reinterpret_cast<char*>(&state.tailChecksum), sizeof(state.tailChecksum));
+	state.hasPartialRow = hasPartialRow != 0;
+
+	return static_cast<bool>(stream);
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		WriteString
+//
+// Description:		Writes a length-prefixed string.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//		s		= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ColumnCache::WriteString(std::ostream &stream, const std::string &s)
+{
+	const uint32_t length(static_cast<uint32_t>(s.size()));
+	stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	stream.write(s.data(), s.size());
+}
+
+//==========================================================================
+// Class:			ColumnCache
+// Function:		ReadString
+//
+// Description:		Reads a length-prefixed string.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		s		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool ColumnCache::ReadString(std::istream &stream, std::string &s)
+{
+	const uint32_t maxLength(1 << 20);
+	uint32_t length;
+	stream.read(reinterpret_cast<char*>(&length), sizeof(length));
+	if (!stream || length > maxLength)
+		return false;
+
+	s.resize(length);
+	stream.read(&s[0], length);
+	return static_cast<bool>(stream);
+}
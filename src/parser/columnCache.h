@@ -0,0 +1,106 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  columnCache.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Binary, columnar copy of a parsed data file.  Reopening a file
+//				 whose cache is current maps the cache instead of parsing text.
+//				 Files too large to hold in memory are parsed straight into
+//				 a new cache.
+// History:
+
+#ifndef COLUMN_CACHE_H_
+#define COLUMN_CACHE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iosfwd>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "parser/delimitedFileLoader.h"
+#include "parser/mappedFile.h"
+
+// Cache of the parsed (and renamed and scaled) columns of one data file.  The
+// columns are stored one after another, each starting on a page boundary, so
+// they can be used straight out of the mapping.
+class ColumnCache
+{
+public:
+	// Returns the name of the cache for dataFileName within directory
+	static wxString GetFileName(const wxString &directory, const wxString &dataFileName);
+
+	// Maps the cache; fails unless it was written for the same path, size,
+	// modification time and custom format definitions
+	bool Open(const wxString &cacheFile, const wxString &dataFileName,
+		const uint64_t &size, const wxLongLong_t &modificationTime,
+		const uint64_t &formatStamp);
+
+	// Valid after a successful Open()
+	const DelimitedFileLoader::FileState& GetState() const { return mState; }
+	uint64_t GetRowCount() const { return mRowCount; }
+	const double* GetColumn(const unsigned int &column) const;// Time column first
+
+	// columns holds one pointer per column in state.layout, each to rowCount
+	// values.  The cache is written under a temporary name and renamed, so a
+	// partially written cache is never opened.
+	static bool Write(const wxString &cacheFile, const wxString &dataFileName,
+		const uint64_t &formatStamp, const DelimitedFileLoader::FileState &state,
+		const std::vector<const double*> &columns, const uint64_t &rowCount);
+
+	// Creates and maps a cache with room for rowCount values in each column
+	// of layout; the columns are then filled through GetWritableColumn().
+	// Finish() completes the cache and leaves it open as if by Open(), so
+	// the columns remain valid.
+	bool Create(const wxString &cacheFile, const wxString &dataFileName,
+		const uint64_t &formatStamp, const DelimitedParser::Layout &layout,
+		const uint64_t &rowCount);
+	double* GetWritableColumn(const unsigned int &column);
+	bool Finish(const DelimitedFileLoader::FileState &state);
+	void Discard();// Closes and deletes a cache that won't be finished
+
+	// Binary form of the file state, also used by SessionSnapshot
+	static void WriteMetadata(std::ostream &stream, const std::string &path,
+		const uint64_t &formatStamp, const DelimitedFileLoader::FileState &state);
+	static bool ReadMetadata(std::istream &stream, std::string &path,
+		uint64_t &formatStamp, DelimitedFileLoader::FileState &state);
+
+	static void WriteString(std::ostream &stream, const std::string &s);
+	static bool ReadString(std::istream &stream, std::string &s);
+
+private:
+	static const char mMagic[4];
+	static const uint32_t mVersion;
+	static const uint64_t mPageSize;
+
+	MappedFile mFile;
+	DelimitedFileLoader::FileState mState;
+	uint64_t mRowCount = 0;
+	uint64_t mFirstColumnOffset = 0;
+	uint64_t mColumnStride = 0;
+
+	// Set by Create() for use by Finish()
+	wxString mCacheFileName;
+	wxString mDataFileName;
+	uint64_t mFormatStamp = 0;
+	uint64_t mMetadataLength = 0;
+
+	static const uint64_t mHeaderLength;
+	static wxString GetTemporaryFileName(const wxString &cacheFile) { return cacheFile + _T(".tmp"); }
+
+	static std::string GetKeyPath(const wxString &dataFileName);
+	static uint64_t RoundUpToPage(const uint64_t &value);
+};
+
+#endif// COLUMN_CACHE_H_
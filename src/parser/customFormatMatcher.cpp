@@ -0,0 +1,1163 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  customFormatMatcher.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Compiled form of CustomFormats.xml.  Identifiers are indexed in
+//				 tries and channel codes in Aho-Corasick automata, so detecting a
+//				 file's format and renaming its columns costs time proportional
+//				 to the length of the header rather than to the size of the XML.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <fstream>
+#include <queue>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+// wxWidgets headers
+#include <wx/filename.h>
+#include <wx/xml/xml.h>
+
+// Local headers
+#include "parser/customFormatMatcher.h"
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for CustomFormatMatcher class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const int CustomFormatMatcher::noMatch(-1);
+const char CustomFormatMatcher::mCacheMagic[4] = { 'D', 'P', 'C', 'F' };
+const uint32_t CustomFormatMatcher::mCacheVersion(2);
+const size_t CustomFormatMatcher::mMaxHeaderLength(1 << 16);
+const uint32_t CustomFormatMatcher::mNone(UINT_MAX);
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		Load
+//
+// Description:		Loads the format definitions, from the cache if it is
+//					current, otherwise from the XML (in which case the cache
+//					is rewritten).
+//
+// Input Arguments:
+//		xmlFile		= const wxString&
+//		cacheFile	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool CustomFormatMatcher::Load(const wxString &xmlFile, const wxString &cacheFile)
+{
+	*this = CustomFormatMatcher();
+
+	wxFileName xmlFileName(xmlFile);
+	const wxULongLong xmlSize(xmlFileName.GetSize());
+	const wxDateTime xmlTime(xmlFileName.GetModificationTime());
+	if (xmlSize == wxInvalidSize || !xmlTime.IsValid())
+		return false;
+
+	const uint64_t stamp(xmlSize.GetValue() * 1099511628211ULL
+		^ static_cast<uint64_t>(xmlTime.GetValue().GetValue()));
+	if (ReadCache(cacheFile, xmlSize.GetValue(), xmlTime.GetValue().GetValue()))
+	{
+		FindLastLine();
+		mStamp = stamp;
+		return true;
+	}
+
+	*this = CustomFormatMatcher();
+	if (!Compile(xmlFile))
+	{
+		*this = CustomFormatMatcher();
+		return false;
+	}
+
+	FindLastLine();
+	mStamp = stamp;
+	WriteCache(cacheFile, xmlSize.GetValue(), xmlTime.GetValue().GetValue());
+	return true;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		Compile
+//
+// Description:		Reads the XML and builds the indices.
+//
+// Input Arguments:
+//		xmlFile	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool CustomFormatMatcher::Compile(const wxString &xmlFile)
+{
+	wxXmlDocument document;
+	if (!document.Load(xmlFile) || !document.GetRoot() ||
+		document.GetRoot()->GetName() != _T("CUSTOM_FORMATS"))
+		return false;
+
+	std::vector<std::string> caseSensitive, caseInsensitive;
+	const wxXmlNode* node;
+	for (node = document.GetRoot()->GetChildren(); node; node = node->GetNext())
+	{
+		if (node->GetType() == wxXML_ELEMENT_NODE && node->GetName() == _T("FORMAT"))
+			AddFormat(*node, caseSensitive, caseInsensitive);
+	}
+
+	mCaseSensitive.Build(caseSensitive, false);
+	mCaseInsensitive.Build(caseInsensitive, false);
+	return true;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		AddFormat
+//
+// Description:		Adds one FORMAT element.  Identifier text is appended to
+//					the pattern lists; the tries are built once every format
+//					has been read.
+//
+// Input Arguments:
+//		node			= const wxXmlNode&
+//
+// Output Arguments:
+//		caseSensitive	= std::vector<std::string>&
+//		caseInsensitive	= std::vector<std::string>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::AddFormat(const wxXmlNode &node,
+	std::vector<std::string> &caseSensitive, std::vector<std::string> &caseInsensitive)
+{
+	const uint32_t formatIndex(static_cast<uint32_t>(mFormats.size()));
+	Format format;
+
+	wxString extensions(node.GetAttribute(_T("EXTENSION"), _T("*")));
+	while (!extensions.IsEmpty())
+	{
+		const std::string extension(ToLower(std::string(
+			extensions.BeforeFirst(';').Trim().Trim(false).ToUTF8())));
+		extensions = extensions.AfterFirst(';');
+		if (extension == "*")
+		{
+			format.extensions.clear();
+			break;
+		}
+		else if (!extension.empty())
+			format.extensions.push_back(extension);
+	}
+
+	const std::string delimiter(node.GetAttribute(_T("DELIMITER")).ToUTF8());
+	if (delimiter == "\\t")
+		format.delimiter = '\t';
+	else if (delimiter.size() == 1)
+		format.delimiter = delimiter[0];
+
+	// Anything beyond the delimiter, time units and channel definitions needs LibPlot2D
+	const wxXmlAttribute* attribute;
+	for (attribute = node.GetAttributes(); attribute; attribute = attribute->GetNext())
+	{
+		const wxString name(attribute->GetName());
+		if (name == _T("TIME_UNITS"))
+		{
+			format.timeScale = GetSecondsPerUnit(std::string(attribute->GetValue().ToUTF8()));
+			if (format.timeScale == 0.0)
+				format.simple = false;
+		}
+		else if (name != _T("NAME") && name != _T("EXTENSION") && name != _T("DELIMITER"))
+			format.simple = false;
+	}
+
+	std::vector<std::string> codes;
+	const wxXmlNode* child;
+	for (child = node.GetChildren(); child; child = child->GetNext())
+	{
+		if (child->GetType() != wxXML_ELEMENT_NODE)
+			continue;
+
+		if (child->GetName() == _T("IDENTIFIER"))
+		{
+			const wxString location(child->GetAttribute(_T("LOCATION")));
+			const std::string text(child->GetNodeContent().ToUTF8());
+			if (text.empty())
+				continue;
+
+			if (location == _T("ROOT"))
+			{
+				mRootNames[text].push_back(formatIndex);
+				continue;
+			}
+
+			Identifier identifier;
+			identifier.format = formatIndex;
+			unsigned long line;
+			if (location == _T("BOF"))
+				identifier.line = 0;
+			else if (location == _T("BOL"))
+				identifier.line = -1;
+			else if (location.StartsWith(_T("BOL")) && location.Mid(3).ToULong(&line))
+				identifier.line = static_cast<int32_t>(line);
+			else
+				continue;
+
+			const uint32_t identifierIndex(static_cast<uint32_t>(mIdentifiers.size()));
+			mIdentifiers.push_back(identifier);
+			if (child->GetAttribute(_T("MATCH_CASE"), _T("1")) == _T("0"))
+			{
+				caseInsensitive.push_back(ToUpper(text));
+				mCaseInsensitiveIds.push_back(identifierIndex);
+			}
+			else
+			{
+				caseSensitive.push_back(text);
+				mCaseSensitiveIds.push_back(identifierIndex);
+			}
+		}
+		else if (child->GetName() == _T("CHANNEL"))
+		{
+			Channel channel;
+			channel.code = child->GetAttribute(_T("CODE")).ToUTF8();
+			channel.name = child->GetAttribute(_T("NAME")).ToUTF8();
+			channel.units = child->GetAttribute(_T("UNITS")).ToUTF8();
+			if (!child->GetAttribute(_T("SCALE"), _T("1")).ToCDouble(&channel.scale))
+				channel.scale = 1.0;
+
+			if (channel.code.empty() || child->HasAttribute(_T("COLUMN")) ||
+				child->HasAttribute(_T("DISCARD_CODE")))
+				format.simple = false;
+
+			if (channel.code.empty())
+				continue;
+
+			codes.push_back(channel.code);
+			format.channels.push_back(std::move(channel));
+		}
+		else
+			format.simple = false;
+	}
+
+	format.codes.Build(codes, true);
+	mFormats.push_back(std::move(format));
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		FindLastLine
+//
+// Description:		Finds the last line that any identifier looks at, so
+//					matching can stop early.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::FindLastLine()
+{
+	mLastLine = -1;
+	for (const auto& identifier : mIdentifiers)
+	{
+		if (identifier.line < 0)
+		{
+			mLastLine = INT32_MAX;
+			return;
+		}
+
+		mLastLine = std::max(mLastLine, identifier.line);
+	}
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		Match
+//
+// Description:		Finds the format which applies to the file.  Each line
+//					start within the header is run through the identifier
+//					tries, so the cost depends on the header length and not
+//					on the number of formats.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		header		= const char*
+//		size		= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, format index or noMatch
+//
+//==========================================================================
+int CustomFormatMatcher::Match(const wxString &fileName, const char* header,
+	const size_t &size) const
+{
+	if (mFormats.empty())
+		return noMatch;
+
+	const std::string extension(ToLower(std::string(wxFileName(fileName).GetExt().ToUTF8())));
+	const char* end(header + std::min(size, mMaxHeaderLength));
+
+	uint32_t best(mNone);
+	const char* lineStart(header);
+	int32_t line(0);
+	while (lineStart < end && line <= mLastLine)
+	{
+		MatchLine(mCaseSensitive, mCaseSensitiveIds, false, lineStart, end, line, extension, best);
+		MatchLine(mCaseInsensitive, mCaseInsensitiveIds, true, lineStart, end, line, extension, best);
+
+		const char* lineEnd(static_cast<const char*>(memchr(lineStart, '\n', end - lineStart)));
+		if (!lineEnd)
+			break;
+
+		lineStart = lineEnd + 1;
+		++line;
+	}
+
+	if (!mRootNames.empty())
+	{
+		const auto root(mRootNames.find(GetRootName(header, size)));
+		if (root != mRootNames.end())
+		{
+			for (const auto& format : root->second)
+			{
+				if (format < best && ExtensionMatches(format, extension))
+					best = format;
+			}
+		}
+	}
+
+	return best == mNone ? noMatch : static_cast<int>(best);
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		MatchLine
+//
+// Description:		Walks the trie from the start of a line, checking every
+//					identifier that ends along the way.
+//
+// Input Arguments:
+//		automaton	= const Automaton&
+//		ids			= const std::vector<uint32_t>&, identifier for each pattern
+//		foldCase	= const bool&
+//		begin		= const char*
+//		end			= const char*
+//		line		= const int32_t&
+//		extension	= const std::string&
+//
+// Output Arguments:
+//		best		= uint32_t&, lowest matching format index so far
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::MatchLine(const Automaton &automaton,
+	const std::vector<uint32_t> &ids, const bool &foldCase, const char* begin,
+	const char* end, const int32_t &line, const std::string &extension,
+	uint32_t &best) const
+{
+	if (automaton.nodes.empty())
+		return;
+
+	uint32_t node(0);
+	const char* p;
+	for (p = begin; p < end; ++p)
+	{
+		const unsigned char symbol(static_cast<unsigned char>(*p));
+		node = automaton.Step(node, foldCase ? static_cast<unsigned char>(toupper(symbol)) : symbol);
+		if (node == mNone)
+			return;
+
+		const Automaton::Node& current(automaton.nodes[node]);
+		uint32_t i;
+		for (i = current.firstOutput; i < current.firstOutput + current.outputCount; ++i)
+		{
+			const Identifier& identifier(mIdentifiers[ids[automaton.outputs[i]]]);
+			if ((identifier.line < 0 || identifier.line == line) &&
+				identifier.format < best && ExtensionMatches(identifier.format, extension))
+				best = identifier.format;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ExtensionMatches
+//
+// Description:		Checks the file extension against the format's list.
+//
+// Input Arguments:
+//		format		= const uint32_t&
+//		extension	= const std::string&, lower case
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool CustomFormatMatcher::ExtensionMatches(const uint32_t &format,
+	const std::string &extension) const
+{
+	const std::vector<std::string>& extensions(mFormats[format].extensions);
+	return extensions.empty() ||
+		std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		GetRootName
+//
+// Description:		Returns the name of the root element if the buffer
+//					looks like the start of an XML document.
+//
+// Input Arguments:
+//		header	= const char*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string, empty if none was found
+//
+//==========================================================================
+std::string CustomFormatMatcher::GetRootName(const char* header, const size_t &size)
+{
+	const char* end(header + std::min(size, mMaxHeaderLength));
+	const char* p(header);
+	while (p < end)
+	{
+		while (p < end && isspace(static_cast<unsigned char>(*p)))
+			++p;
+		if (p == end || *p != '<')
+			return std::string();
+
+		// Skip declarations, processing instructions and comments
+		if (p + 1 < end && (p[1] == '?' || p[1] == '!'))
+		{
+			const char* close(static_cast<const char*>(memchr(p, '>', end - p)));
+			if (!close)
+				return std::string();
+			p = close + 1;
+			continue;
+		}
+
+		const char* nameEnd(++p);
+		while (nameEnd < end && !isspace(static_cast<unsigned char>(*nameEnd)) &&
+			*nameEnd != '>' && *nameEnd != '/')
+			++nameEnd;
+		return std::string(p, nameEnd);
+	}
+
+	return std::string();
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		RenameHeading
+//
+// Description:		Runs the heading through the format's channel code
+//					automaton.  The first code found (by end position, then
+//					by order in the XML) is replaced with the channel name,
+//					and the units are appended in square brackets.
+//
+// Input Arguments:
+//		format	= const int&
+//		heading	= std::string&
+//
+// Output Arguments:
+//		heading	= std::string&
+//
+// Return Value:
+//		double, scale for the channel's data
+//
+//==========================================================================
+double CustomFormatMatcher::RenameHeading(const int &format, std::string &heading) const
+{
+	const Format& f(mFormats[format]);
+	if (f.codes.nodes.empty())
+		return 1.0;
+
+	uint32_t node(0);
+	size_t i;
+	for (i = 0; i < heading.size(); ++i)
+	{
+		node = f.codes.Advance(node, static_cast<unsigned char>(heading[i]));
+		const Automaton::Node& current(f.codes.nodes[node]);
+		if (current.outputCount == 0)
+			continue;
+
+		const uint32_t* first(f.codes.outputs.data() + current.firstOutput);
+		const Channel& channel(f.channels[*std::min_element(first, first + current.outputCount)]);
+
+		heading.replace(i + 1 - channel.code.size(), channel.code.size(), channel.name);
+		if (!channel.units.empty())
+			heading.append(" [" + channel.units + "]");
+		return channel.scale;
+	}
+
+	return 1.0;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher::Automaton
+// Function:		Build
+//
+// Description:		Builds the trie for the patterns.  With failure links,
+//					each node's outputs also include those of the nodes
+//					reachable through its failure chain, so a match never
+//					needs to walk the chain.
+//
+// Input Arguments:
+//		patterns		= const std::vector<std::string>&
+//		linkFailures	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::Automaton::Build(const std::vector<std::string> &patterns,
+	const bool &linkFailures)
+{
+	nodes.clear();
+	edges.clear();
+	outputs.clear();
+	if (patterns.empty())
+		return;
+
+	std::vector<std::map<unsigned char, uint32_t>> children(1);
+	std::vector<std::vector<uint32_t>> matches(1);
+	uint32_t p;
+	for (p = 0; p < patterns.size(); ++p)
+	{
+		uint32_t node(0);
+		for (const char c : patterns[p])
+		{
+			const unsigned char symbol(static_cast<unsigned char>(c));
+			const auto child(children[node].find(symbol));
+			if (child != children[node].end())
+			{
+				node = child->second;
+				continue;
+			}
+
+			const uint32_t next(static_cast<uint32_t>(children.size()));
+			children[node][symbol] = next;
+			children.emplace_back();
+			matches.emplace_back();
+			node = next;
+		}
+
+		matches[node].push_back(p);
+	}
+
+	std::vector<uint32_t> failures(children.size(), 0);
+	if (linkFailures)
+	{
+		// Breadth first, so each node's failure target is finished first
+		std::queue<uint32_t> pending;
+		for (const auto& child : children[0])
+			pending.push(child.second);
+
+		while (!pending.empty())
+		{
+			const uint32_t node(pending.front());
+			pending.pop();
+			for (const auto& child : children[node])
+			{
+				uint32_t failure(failures[node]);
+				while (failure != 0 && children[failure].find(child.first) == children[failure].end())
+					failure = failures[failure];
+
+				const auto target(children[failure].find(child.first));
+				failures[child.second] = target != children[failure].end() ? target->second : 0;
+
+				const std::vector<uint32_t>& inherited(matches[failures[child.second]]);
+				matches[child.second].insert(matches[child.second].end(),
+					inherited.begin(), inherited.end());
+				pending.push(child.second);
+			}
+		}
+	}
+
+	nodes.resize(children.size());
+	uint32_t n;
+	for (n = 0; n < nodes.size(); ++n)
+	{
+		nodes[n].firstEdge = static_cast<uint32_t>(edges.size());
+		nodes[n].edgeCount = static_cast<uint32_t>(children[n].size());
+		for (const auto& child : children[n])// std::map keeps these sorted
+			edges.push_back({ child.first, child.second });
+
+		nodes[n].failure = failures[n];
+		nodes[n].firstOutput = static_cast<uint32_t>(outputs.size());
+		nodes[n].outputCount = static_cast<uint32_t>(matches[n].size());
+		outputs.insert(outputs.end(), matches[n].begin(), matches[n].end());
+	}
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher::Automaton
+// Function:		Step
+//
+// Description:		Follows the edge for the symbol, if there is one.
+//
+// Input Arguments:
+//		node	= const uint32_t&
+//		symbol	= const unsigned char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, next node or mNone
+//
+//==========================================================================
+uint32_t CustomFormatMatcher::Automaton::Step(const uint32_t &node,
+	const unsigned char &symbol) const
+{
+	const Edge* first(edges.data() + nodes[node].firstEdge);
+	const Edge* last(first + nodes[node].edgeCount);
+	const Edge* edge(std::lower_bound(first, last, symbol, [](const Edge &e, const unsigned char &s)
+	{
+		return e.symbol < s;
+	}));
+
+	if (edge == last || edge->symbol != symbol)
+		return mNone;
+
+	return edge->target;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher::Automaton
+// Function:		Advance
+//
+// Description:		Aho-Corasick transition; follows failure links until an
+//					edge for the symbol is found (or the root is reached).
+//
+// Input Arguments:
+//		node	= uint32_t
+//		symbol	= const unsigned char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t
+//
+//==========================================================================
+uint32_t CustomFormatMatcher::Automaton::Advance(uint32_t node,
+	const unsigned char &symbol) const
+{
+	while (true)
+	{
+		const uint32_t next(Step(node, symbol));
+		if (next != mNone)
+			return next;
+		else if (node == 0)
+			return 0;
+
+		node = nodes[node].failure;
+	}
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher::Automaton
+// Function:		Write
+//
+// Description:		Writes the automaton to a binary stream.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::Automaton::Write(std::ostream &stream) const
+{
+	WriteVector(stream, nodes);
+	WriteVector(stream, edges);
+	WriteVector(stream, outputs);
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher::Automaton
+// Function:		Read
+//
+// Description:		Reads the automaton from a binary stream.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool CustomFormatMatcher::Automaton::Read(std::istream &stream)
+{
+	if (!ReadVector(stream, nodes) || !ReadVector(stream, edges) || !ReadVector(stream, outputs))
+		return false;
+
+	// Make sure a damaged cache can't send us outside the arrays
+	for (const auto& node : nodes)
+	{
+		if (static_cast<uint64_t>(node.firstEdge) + node.edgeCount > edges.size() ||
+			static_cast<uint64_t>(node.firstOutput) + node.outputCount > outputs.size() ||
+			node.failure >= nodes.size())
+			return false;
+	}
+
+	for (const auto& edge : edges)
+	{
+		if (edge.target >= nodes.size())
+			return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		WriteCache
+//
+// Description:		Writes the compiled definitions to the cache file.
+//					Failure is not an error; the XML is compiled again next
+//					time.
+//
+// Input Arguments:
+//		cacheFile	= const wxString&
+//		xmlSize		= const uint64_t&
+//		xmlTime		= const int64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::WriteCache(const wxString &cacheFile,
+	const uint64_t &xmlSize, const int64_t &xmlTime) const
+{
+	std::ofstream stream(cacheFile.fn_str(), std::ios::binary | std::ios::trunc);
+	if (!stream.is_open())
+		return;
+
+	stream.write(mCacheMagic, sizeof(mCacheMagic));
+	stream.write(reinterpret_cast<const char*>(&mCacheVersion), sizeof(mCacheVersion));
+	stream.write(reinterpret_cast<const char*>(&xmlSize), sizeof(xmlSize));
+	stream.write(reinterpret_cast<const char*>(&xmlTime), sizeof(xmlTime));
+
+	const uint32_t formatCount(static_cast<uint32_t>(mFormats.size()));
+	stream.write(reinterpret_cast<const char*>(&formatCount), sizeof(formatCount));
+	for (const auto& format : mFormats)
+	{
+		const uint32_t extensionCount(static_cast<uint32_t>(format.extensions.size()));
+		stream.write(reinterpret_cast<const char*>(&extensionCount), sizeof(extensionCount));
+		for (const auto& extension : format.extensions)
+			WriteString(stream, extension);
+
+		stream.write(&format.delimiter, sizeof(format.delimiter));
+		stream.write(reinterpret_cast<const char*>(&format.timeScale), sizeof(format.timeScale));
+		const char simple(format.simple ? 1 : 0);
+		stream.write(&simple, sizeof(simple));
+
+		const uint32_t channelCount(static_cast<uint32_t>(format.channels.size()));
+		stream.write(reinterpret_cast<const char*>(&channelCount), sizeof(channelCount));
+		for (const auto& channel : format.channels)
+		{
+			WriteString(stream, channel.code);
+			WriteString(stream, channel.name);
+			WriteString(stream, channel.units);
+			stream.write(reinterpret_cast<const char*>(&channel.scale), sizeof(channel.scale));
+		}
+
+		format.codes.Write(stream);
+	}
+
+	WriteVector(stream, mIdentifiers);
+	mCaseSensitive.Write(stream);
+	mCaseInsensitive.Write(stream);
+	WriteVector(stream, mCaseSensitiveIds);
+	WriteVector(stream, mCaseInsensitiveIds);
+
+	const uint32_t rootCount(static_cast<uint32_t>(mRootNames.size()));
+	stream.write(reinterpret_cast<const char*>(&rootCount), sizeof(rootCount));
+	for (const auto& root : mRootNames)
+	{
+		WriteString(stream, root.first);
+		WriteVector(stream, root.second);
+	}
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ReadCache
+//
+// Description:		Reads the compiled definitions from the cache file, if
+//					it was written for the current version of the XML.
+//
+// Input Arguments:
+//		cacheFile	= const wxString&
+//		xmlSize		= const uint64_t&
+//		xmlTime		= const int64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the cache was current and complete
+//
+//==========================================================================
+bool CustomFormatMatcher::ReadCache(const wxString &cacheFile,
+	const uint64_t &xmlSize, const int64_t &xmlTime)
+{
+	std::ifstream stream(cacheFile.fn_str(), std::ios::binary);
+	if (!stream.is_open())
+		return false;
+
+	char magic[sizeof(mCacheMagic)];
+	uint32_t version;
+	uint64_t size;
+	int64_t time;
+	stream.read(magic, sizeof(magic));
+	stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+	stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+	stream.read(reinterpret_cast<char*>(&time), sizeof(time));
+	if (!stream || memcmp(magic, mCacheMagic, sizeof(magic)) != 0 ||
+		version != mCacheVersion || size != xmlSize || time != xmlTime)
+		return false;
+
+	uint32_t formatCount;
+	stream.read(reinterpret_cast<char*>(&formatCount), sizeof(formatCount));
+	if (!stream)
+		return false;
+
+	uint32_t i;
+	for (i = 0; i < formatCount; ++i)
+	{
+		Format format;
+		uint32_t extensionCount;
+		stream.read(reinterpret_cast<char*>(&extensionCount), sizeof(extensionCount));
+		if (!stream)
+			return false;
+
+		format.extensions.resize(extensionCount);
+		for (auto& extension : format.extensions)
+		{
+			if (!ReadString(stream, extension))
+				return false;
+		}
+
+		char simple;
+		uint32_t channelCount;
+		stream.read(&format.delimiter, sizeof(format.delimiter));
+		stream.read(reinterpret_cast<char*>(&format.timeScale), sizeof(format.timeScale));
+		stream.read(&simple, sizeof(simple));
+		stream.read(reinterpret_cast<char*>(&channelCount), sizeof(channelCount));
+		if (!stream)
+			return false;
+
+		format.simple = simple != 0;
+		format.channels.resize(channelCount);
+		for (auto& channel : format.channels)
+		{
+			if (!ReadString(stream, channel.code) || !ReadString(stream, channel.name) ||
+				!ReadString(stream, channel.units))
+				return false;
+			stream.read(reinterpret_cast<char*>(&channel.scale), sizeof(channel.scale));
+		}
+
+		if (!format.codes.Read(stream))
+			return false;
+
+		for (const auto& output : format.codes.outputs)
+		{
+			if (output >= format.channels.size())
+				return false;
+		}
+
+		mFormats.push_back(std::move(format));
+	}
+
+	if (!ReadVector(stream, mIdentifiers) || !mCaseSensitive.Read(stream) ||
+		!mCaseInsensitive.Read(stream) || !ReadVector(stream, mCaseSensitiveIds) ||
+		!ReadVector(stream, mCaseInsensitiveIds))
+		return false;
+
+	uint32_t rootCount;
+	stream.read(reinterpret_cast<char*>(&rootCount), sizeof(rootCount));
+	if (!stream)
+		return false;
+
+	for (i = 0; i < rootCount; ++i)
+	{
+		std::string name;
+		if (!ReadString(stream, name) || !ReadVector(stream, mRootNames[name]))
+			return false;
+	}
+
+	// Check the cross references, as the automata check their own
+	for (const auto& identifier : mIdentifiers)
+	{
+		if (identifier.format >= mFormats.size())
+			return false;
+	}
+
+	for (const auto& output : mCaseSensitive.outputs)
+	{
+		if (output >= mCaseSensitiveIds.size() || mCaseSensitiveIds[output] >= mIdentifiers.size())
+			return false;
+	}
+
+	for (const auto& output : mCaseInsensitive.outputs)
+	{
+		if (output >= mCaseInsensitiveIds.size() || mCaseInsensitiveIds[output] >= mIdentifiers.size())
+			return false;
+	}
+
+	for (const auto& root : mRootNames)
+	{
+		for (const auto& format : root.second)
+		{
+			if (format >= mFormats.size())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		WriteVector
+//
+// Description:		Writes a length-prefixed array of plain data.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//		v		= const std::vector<T>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template<typename T>
+void CustomFormatMatcher::WriteVector(std::ostream &stream, const std::vector<T> &v)
+{
+	const uint32_t count(static_cast<uint32_t>(v.size()));
+	stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	stream.write(reinterpret_cast<const char*>(v.data()), sizeof(T) * v.size());
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ReadVector
+//
+// Description:		Reads a length-prefixed array of plain data.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		v		= std::vector<T>&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+template<typename T>
+bool CustomFormatMatcher::ReadVector(std::istream &stream, std::vector<T> &v)
+{
+	const uint32_t maxCount(1 << 24);
+	uint32_t count;
+	stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!stream || count > maxCount)
+		return false;
+
+	v.resize(count);
+	stream.read(reinterpret_cast<char*>(v.data()), sizeof(T) * count);
+	return static_cast<bool>(stream);
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		WriteString
+//
+// Description:		Writes a length-prefixed string.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//		s		= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CustomFormatMatcher::WriteString(std::ostream &stream, const std::string &s)
+{
+	WriteVector(stream, std::vector<char>(s.begin(), s.end()));
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ReadString
+//
+// Description:		Reads a length-prefixed string.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		s		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool CustomFormatMatcher::ReadString(std::istream &stream, std::string &s)
+{
+	std::vector<char> characters;
+	if (!ReadVector(stream, characters))
+		return false;
+
+	s.assign(characters.begin(), characters.end());
+	return true;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ToUpper
+//
+// Description:		Returns an upper case copy of an ASCII string.
+//
+// Input Arguments:
+//		s	= std::string
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string CustomFormatMatcher::ToUpper(std::string s)
+{
+	for (auto& c : s)
+		c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+	return s;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		ToLower
+//
+// Description:		Returns a lower case copy of an ASCII string.
+//
+// Input Arguments:
+//		s	= std::string
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string CustomFormatMatcher::ToLower(std::string s)
+{
+	for (auto& c : s)
+		c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	return s;
+}
+
+//==========================================================================
+// Class:			CustomFormatMatcher
+// Function:		GetSecondsPerUnit
+//
+// Description:		Interprets the TIME_UNITS attribute.
+//
+// Input Arguments:
+//		units	= const std::string&, e.g. "msec" or "minutes"
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, seconds per unit, or zero if the units aren't recognized
+//
+//==========================================================================
+double CustomFormatMatcher::GetSecondsPerUnit(const std::string &units)
+{
+	const std::string lowerUnits(ToLower(units));
+	if (lowerUnits == "usec" || lowerUnits == "us" || lowerUnits == "microseconds")
+		return 1.0e-6;
+	else if (lowerUnits == "msec" || lowerUnits == "ms" || lowerUnits == "milliseconds")
+		return 1.0e-3;
+	else if (lowerUnits == "sec" || lowerUnits == "s" || lowerUnits == "seconds")
+		return 1.0;
+	else if (lowerUnits == "min" || lowerUnits == "minutes")
+		return 60.0;
+	else if (lowerUnits == "hr" || lowerUnits == "hours")
+		return 3600.0;
+
+	return 0.0;
+}
@@ -0,0 +1,169 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  customFormatMatcher.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Compiled form of CustomFormats.xml.  Identifiers are indexed in
+//				 tries and channel codes in Aho-Corasick automata, so detecting a
+//				 file's format and renaming its columns costs time proportional
+//				 to the length of the header rather than to the size of the XML.
+// History:
+
+#ifndef CUSTOM_FORMAT_MATCHER_H_
+#define CUSTOM_FORMAT_MATCHER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdint>
+#include <iosfwd>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// wxWidgets forward declarations
+class wxXmlNode;
+
+// Index of the custom file format definitions
+class CustomFormatMatcher
+{
+public:
+	// Compiles the XML, or reads the compiled form from cacheFile if the XML
+	// has not changed since the cache was written.  Returns false if the XML
+	// could not be read (in which case nothing matches).
+	bool Load(const wxString &xmlFile, const wxString &cacheFile);
+
+	static const int noMatch;
+
+	// Returns the index of the first format (in XML order) which matches the
+	// file, or noMatch.  header holds the beginning of the file.
+	int Match(const wxString &fileName, const char* header, const size_t &size) const;
+
+	// True if the format only specifies the delimiter, time units and channel
+	// names, units and scales, so DelimitedFileLoader can apply it
+	bool IsSimple(const int &format) const { return mFormats[format].simple; }
+	char GetDelimiter(const int &format) const { return mFormats[format].delimiter; }
+	double GetTimeScale(const int &format) const { return mFormats[format].timeScale; }// [sec/unit]
+
+	// Replaces the first channel code found in the heading with the channel
+	// name (and units); returns the channel's scale, or 1.0 if none matched
+	double RenameHeading(const int &format, std::string &heading) const;
+
+	// Changes whenever a different version of the XML is loaded; zero if
+	// nothing was loaded.  Lets caches of processed files detect that the
+	// formats applied to them may have changed.
+	uint64_t GetStamp() const { return mStamp; }
+
+private:
+	static const char mCacheMagic[4];
+	static const uint32_t mCacheVersion;
+	static const size_t mMaxHeaderLength;
+	static const uint32_t mNone;
+
+	// Trie, or Aho-Corasick automaton if failure links are built, stored in
+	// flat arrays so it can be written to and read from the cache as is.
+	// The edges from each node are sorted so they can be binary searched.
+	struct Automaton
+	{
+		struct Node
+		{
+			uint32_t firstEdge;
+			uint32_t edgeCount;
+			uint32_t failure;
+			uint32_t firstOutput;
+			uint32_t outputCount;
+		};
+
+		struct Edge
+		{
+			uint32_t symbol;
+			uint32_t target;
+		};
+
+		std::vector<Node> nodes;
+		std::vector<Edge> edges;
+		std::vector<uint32_t> outputs;// Indices of the patterns ending at each node
+
+		void Build(const std::vector<std::string> &patterns, const bool &linkFailures);
+		uint32_t Step(const uint32_t &node, const unsigned char &symbol) const;
+		uint32_t Advance(uint32_t node, const unsigned char &symbol) const;
+
+		void Write(std::ostream &stream) const;
+		bool Read(std::istream &stream);
+	};
+
+	struct Identifier
+	{
+		uint32_t format;
+		int32_t line;// Zero-based; -1 matches every line
+	};
+
+	struct Channel
+	{
+		std::string code;
+		std::string name;
+		std::string units;
+		double scale;
+	};
+
+	struct Format
+	{
+		std::vector<std::string> extensions;// Lower case; empty matches all
+		char delimiter = 0;
+		double timeScale = 1.0;// [sec/unit]
+		bool simple = true;
+		std::vector<Channel> channels;
+		Automaton codes;
+	};
+
+	std::vector<Format> mFormats;
+	std::vector<Identifier> mIdentifiers;
+
+	// Identifier text, indexed from the start of each line
+	Automaton mCaseSensitive;
+	Automaton mCaseInsensitive;// Upper case
+	std::vector<uint32_t> mCaseSensitiveIds;// Pattern index to identifier index
+	std::vector<uint32_t> mCaseInsensitiveIds;
+
+	std::map<std::string, std::vector<uint32_t>> mRootNames;// For XML files
+
+	int32_t mLastLine = -1;// Lines after this can't match anything
+	uint64_t mStamp = 0;
+
+	bool Compile(const wxString &xmlFile);
+	void AddFormat(const wxXmlNode &node, std::vector<std::string> &caseSensitive,
+		std::vector<std::string> &caseInsensitive);
+	void FindLastLine();
+
+	bool ReadCache(const wxString &cacheFile, const uint64_t &xmlSize,
+		const int64_t &xmlTime);
+	void WriteCache(const wxString &cacheFile, const uint64_t &xmlSize,
+		const int64_t &xmlTime) const;
+
+	bool ExtensionMatches(const uint32_t &format, const std::string &extension) const;
+	void MatchLine(const Automaton &automaton, const std::vector<uint32_t> &ids,
+		const bool &foldCase, const char* begin, const char* end, const int32_t &line,
+		const std::string &extension, uint32_t &best) const;
+
+	static std::string GetRootName(const char* header, const size_t &size);
+	static std::string ToUpper(std::string s);
+	static std::string ToLower(std::string s);
+	static double GetSecondsPerUnit(const std::string &units);
+
+	template<typename T>
+	static void WriteVector(std::ostream &stream, const std::vector<T> &v);
+	template<typename T>
+	static bool ReadVector(std::istream &stream, std::vector<T> &v);
+	static void WriteString(std::ostream &stream, const std::string &s);
+	static bool ReadString(std::istream &stream, std::string &s);
+};
+
+#endif// CUSTOM_FORMAT_MATCHER_H_
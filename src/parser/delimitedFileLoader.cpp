@@ -0,0 +1,1109 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  delimitedFileLoader.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Loads delimited numeric files by memory mapping them and parsing
+//				 row chunks in parallel, writing values straight into shared
+//				 column buffers.
+// History:
+
+// Standard C++ headers
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+// wxWidgets headers
+#include <wx/filename.h>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Local headers
+#include "parser/delimitedFileLoader.h"
+#include "parser/delimitedParser.h"
+#include "parser/mappedFile.h"
+#include "parser/customFormatMatcher.h"
+#include "parser/columnCache.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for DelimitedFileLoader class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t DelimitedFileLoader::mChunkSize(8 << 20);
+const size_t DelimitedFileLoader::mBufferChunkSize(1 << 20);
+const uint64_t DelimitedFileLoader::mTailChecksumLength(4096);
+const uint64_t DelimitedFileLoader::mMinCachedFileSize(16 << 20);
+const double DelimitedFileLoader::mMaxInCoreMemoryFraction(0.5);
+const double DelimitedFileLoader::mRowCountingEffort(0.25);// [fraction of the load]
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		DelimitedFileLoader
+//
+// Description:		Constructor for DelimitedFileLoader class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//		formats	= const CustomFormatMatcher&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DelimitedFileLoader::DelimitedFileLoader(ThreadPool &pool,
+	const CustomFormatMatcher &formats) : mPool(pool), mFormats(formats)
+{
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		CanLoad
+//
+// Description:		Checks to see if the file should be handled by this
+//					loader.  Files matching a custom format definition are
+//					left to LibPlot2D, unless the format only renames and
+//					scales columns.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DelimitedFileLoader::CanLoad(const wxString &fileName) const
+{
+	if (!wxFileName::FileExists(fileName))
+		return false;
+
+	MappedFile file;
+	if (!file.Open(std::string(fileName.ToUTF8())))
+		return false;
+
+	const int format(mFormats.Match(fileName, file.GetData(), file.GetSize()));
+	return format == CustomFormatMatcher::noMatch || mFormats.IsSimple(format);
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		DetectLayout
+//
+// Description:		Determines the layout of a mapped file, applying its
+//					custom format (if any).
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		file		= const MappedFile&
+//
+// Output Arguments:
+//		layout		= DelimitedParser::Layout&
+//
+// Return Value:
+//		bool, true if the file can be loaded
+//
+//==========================================================================
+bool DelimitedFileLoader::DetectLayout(const wxString &fileName,
+	const MappedFile &file, DelimitedParser::Layout &layout) const
+{
+	const int format(mFormats.Match(fileName, file.GetData(), file.GetSize()));
+	if (format == CustomFormatMatcher::noMatch)
+		return DelimitedParser::DetectLayout(file.GetData(), file.GetSize(), layout);
+	else if (!mFormats.IsSimple(format) || !DelimitedParser::DetectLayout(
+		file.GetData(), file.GetSize(), layout, mFormats.GetDelimiter(format)))
+		return false;
+
+	layout.timeScale = mFormats.GetTimeScale(format);
+	layout.scales.assign(layout.columnCount, 1.0);
+	bool scaled(false);
+	unsigned int c;
+	for (c = 1; c < layout.columnCount; ++c)
+	{
+		layout.scales[c] = mFormats.RenameHeading(format, layout.headings[c]);
+		scaled = scaled || layout.scales[c] != 1.0;
+	}
+
+	if (!scaled)
+		layout.scales.clear();
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		Load
+//
+// Description:		Loads the specified files.  Work is split so that no
+//					pool task waits on another:  first every file is mapped
+//					and its layout detected, then the rows in every chunk of
+//					every file are counted, the columns are allocated, and
+//					finally every chunk is parsed into its slice of the
+//					columns.  Files with a current cache are copied from
+//					the cache while their columns are allocated instead,
+//					and large files without one have it written afterwards.
+//					Files whose columns would take too much of the free
+//					memory are parsed straight into a new cache (or use an
+//					existing one) and refer to the mapped columns.  Columns
+//					left out by a file's mask are neither allocated nor
+//					converted, and the file's chunks are kept so the rest
+//					can be parsed later without counting rows again.
+//
+// Input Arguments:
+//		fileList	= const wxArrayString&
+//		progress	= const ProgressFunction&, may be empty
+//		layoutKnown	= const LayoutFunction&, may be empty
+//		masks		= const std::vector<ColumnMask>&, empty or one per file
+//
+// Output Arguments:
+//		failedFiles	= wxArrayString&
+//
+// Return Value:
+//		std::vector<LoadedFile>
+//
+//==========================================================================
+std::vector<DelimitedFileLoader::LoadedFile> DelimitedFileLoader::Load(
+	const wxArrayString &fileList, wxArrayString &failedFiles,
+	const ProgressFunction &progress, const LayoutFunction &layoutKnown,
+	const std::vector<ColumnMask> &masks)
+{
+	PerfMonitor::ScopedTimer loadTimer("Load");
+	struct FileJob
+	{
+		MappedFile file;
+		DelimitedParser::Layout layout;
+		bool ok = false;
+		ColumnCache cache;
+		bool cached = false;
+		bool outOfCore = false;
+		LoadedFile result;
+		std::vector<double*> destinations;
+	};
+
+	struct ChunkJob
+	{
+		FileJob* job;
+		DelimitedParser::Chunk chunk;
+	};
+
+	std::vector<FileJob> jobs(fileList.GetCount());
+	unsigned int i;
+	for (i = 0; i < jobs.size(); ++i)
+	{
+		jobs[i].result.fileName = fileList[i];
+		if (i < masks.size())
+			jobs[i].result.mask = masks[i];
+	}
+
+	mPool.ParallelFor(jobs.size(), 1, [this, &jobs](const size_t &begin, const size_t &end)
+	{
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			FileJob& job(jobs[j]);
+			uint64_t size;
+			if (!GetFileInfo(job.result.fileName, size, job.result.state.modificationTime))
+				continue;
+
+			if (!mCacheDirectory.IsEmpty() && job.cache.Open(ColumnCache::GetFileName(
+				mCacheDirectory, job.result.fileName), job.result.fileName, size,
+				job.result.state.modificationTime, mFormats.GetStamp()))
+			{
+				job.layout = job.cache.GetState().layout;
+				job.cached = true;
+				job.ok = true;
+				continue;
+			}
+
+			if (!job.file.Open(std::string(job.result.fileName.ToUTF8())) || !job.file.GetData())
+				continue;
+
+			job.file.AdviseSequential();
+			job.ok = DetectLayout(job.result.fileName, job.file, job.layout);
+		}
+	});
+
+	for (auto& job : jobs)
+	{
+		if (!job.ok)
+			continue;
+
+		unsigned int c;
+		for (c = 1; c < job.layout.columnCount; ++c)
+			job.result.descriptions.Add(wxString::FromUTF8(job.layout.headings[c].c_str()));
+		if (!job.result.mask.empty())
+			job.result.mask.resize(job.layout.columnCount - 1, false);
+		if (layoutKnown)
+			layoutKnown(job.result.fileName, job.result.descriptions);
+	}
+
+	std::vector<ChunkJob> chunkJobs;
+	for (auto& job : jobs)
+	{
+		if (!job.ok || job.cached)
+			continue;
+
+		for (const auto& chunk : DelimitedParser::SplitIntoChunks(job.file.GetData(),
+			job.layout.dataStart, job.file.GetSize(), mChunkSize))
+			chunkJobs.push_back({ &job, chunk });
+	}
+
+	if (!ParallelForWithProgress(chunkJobs.size(), [&chunkJobs](const size_t &begin, const size_t &end)
+	{
+		PerfMonitor::ScopedTimer countTimer("Count rows");
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			const char* data(chunkJobs[j].job->file.GetData());
+			chunkJobs[j].chunk.rowCount = DelimitedParser::CountRows(
+				data + chunkJobs[j].chunk.begin, data + chunkJobs[j].chunk.end);
+		}
+	}, progress, 0.0, mRowCountingEffort))
+		return std::vector<LoadedFile>();
+
+	struct Allocation
+	{
+		FileJob* job;
+		unsigned int index;
+		unsigned int rowCount;
+	};
+	std::vector<Allocation> allocations;
+
+	// Files are kept in memory until they would use more than the limit
+	// (in total); after that they stay in their caches
+	const uint64_t inCoreLimit(mCacheDirectory.IsEmpty() ?
+		std::numeric_limits<uint64_t>::max() : GetInCoreMemoryLimit());
+	uint64_t inCoreSize(0);
+
+	auto addAllocations([this, &allocations, inCoreLimit, &inCoreSize](
+		FileJob &job, const uint64_t &rowCount)
+	{
+		if (rowCount == 0 || rowCount > std::numeric_limits<unsigned int>::max())
+		{
+			job.ok = false;
+			return;
+		}
+
+		unsigned int c, selectedCount(0);
+		for (c = 0; c < job.layout.columnCount; ++c)
+		{
+			if (IsSelected(job.result.mask, c))
+				++selectedCount;
+		}
+
+		// Partial files can't be cached, so they are always kept in memory
+		const uint64_t size(sizeof(double) * rowCount * selectedCount);
+		if ((job.cached || job.result.mask.empty()) &&
+			(size > inCoreLimit || inCoreSize > inCoreLimit - size))
+		{
+			job.outOfCore = job.cached || job.cache.Create(ColumnCache::GetFileName(
+				mCacheDirectory, job.result.fileName), job.result.fileName,
+				mFormats.GetStamp(), job.layout, rowCount);
+		}
+
+		if (!job.outOfCore)
+			inCoreSize += size;
+
+		job.result.columns.resize(job.layout.columnCount);
+		for (c = 0; c < job.layout.columnCount && !job.outOfCore; ++c)
+		{
+			if (IsSelected(job.result.mask, c))
+				allocations.push_back({ &job, c, static_cast<unsigned int>(rowCount) });
+		}
+	});
+
+	for (auto& job : jobs)
+	{
+		if (job.cached)
+			addAllocations(job, job.cache.GetRowCount());
+	}
+
+	FileJob* current(nullptr);
+	size_t rowCount(0);
+	for (auto& chunkJob : chunkJobs)
+	{
+		if (chunkJob.job != current)
+		{
+			if (current)
+				addAllocations(*current, rowCount);
+			current = chunkJob.job;
+			rowCount = 0;
+		}
+
+		chunkJob.chunk.firstRow = rowCount;
+		rowCount += chunkJob.chunk.rowCount;
+	}
+
+	if (current)
+		addAllocations(*current, rowCount);
+
+	// Allocating (and zeroing) large columns is worth spreading out, too
+	mPool.ParallelFor(allocations.size(), 1, [&allocations](const size_t &begin, const size_t &end)
+	{
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			const Allocation& allocation(allocations[j]);
+			SharedColumn& column(allocation.job->result.columns[allocation.index]);
+			column = SharedColumn(allocation.rowCount);
+			if (allocation.job->cached)
+				memcpy(column.GetWritableData(), allocation.job->cache.GetColumn(
+					allocation.index), sizeof(double) * allocation.rowCount);
+		}
+	});
+
+	for (auto& job : jobs)
+	{
+		if (job.result.columns.empty())
+			job.ok = false;
+		if (!job.ok || job.cached)
+			continue;
+
+		job.destinations.resize(job.layout.columnCount);
+		unsigned int c;
+		for (c = 0; c < job.layout.columnCount; ++c)
+		{
+			if (job.outOfCore)
+				job.destinations[c] = job.cache.GetWritableColumn(c);
+			else if (IsSelected(job.result.mask, c))
+				job.destinations[c] = job.result.columns[c].GetWritableData();
+		}
+	}
+
+	uint64_t parsedBytes(0);
+	for (const auto& chunkJob : chunkJobs)
+		parsedBytes += chunkJob.chunk.end - chunkJob.chunk.begin;
+
+	PerfMonitor& monitor(PerfMonitor::GetSharedMonitor());
+	const long long parseStart(monitor.GetTime());
+	if (!ParallelForWithProgress(chunkJobs.size(), [&chunkJobs](const size_t &begin, const size_t &end)
+	{
+		std::vector<double*> destinations;
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			const FileJob& job(*chunkJobs[j].job);
+			if (!job.ok)
+				continue;
+
+			PerfMonitor::ScopedTimer chunkTimer("Parse chunk");
+
+			const DelimitedParser::Chunk& chunk(chunkJobs[j].chunk);
+			destinations.resize(job.destinations.size());
+			unsigned int c;
+			for (c = 0; c < destinations.size(); ++c)
+				destinations[c] = job.destinations[c] ? job.destinations[c] + chunk.firstRow : nullptr;
+
+			DelimitedParser::ParseRows(job.file.GetData() + chunk.begin,
+				job.file.GetData() + chunk.end, job.layout, destinations.data());
+		}
+	}, progress, mRowCountingEffort, 1.0))
+	{
+		for (auto& job : jobs)
+		{
+			if (job.outOfCore && !job.cached)
+				job.cache.Discard();
+		}
+
+		return std::vector<LoadedFile>();
+	}
+
+	const long long parseEnd(monitor.GetTime());
+	monitor.RecordDuration("Parse", parseStart, parseEnd);
+	if (parsedBytes > 0 && parseEnd > parseStart)
+		monitor.RecordCounter("Parse rate [MB/sec]",
+			parsedBytes * 1.0e6 / (parseEnd - parseStart) / (1 << 20));
+
+	for (const auto& chunkJob : chunkJobs)
+	{
+		if (!chunkJob.job->result.mask.empty())
+			chunkJob.job->result.rowIndex.push_back(chunkJob.chunk);
+	}
+
+	mPool.ParallelFor(jobs.size(), 1, [this, &jobs](const size_t &begin, const size_t &end)
+	{
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			FileJob& job(jobs[j]);
+			if (!job.ok)
+				continue;
+			else if (job.cached)
+			{
+				job.result.state = job.cache.GetState();
+				if (job.outOfCore)
+					UseCacheColumns(std::make_shared<ColumnCache>(std::move(job.cache)), job.result);
+				continue;
+			}
+
+			job.result.state.layout = job.layout;
+			UpdateState(job.file.GetData(), job.file.GetData(), 0, job.file.GetSize(),
+				job.result.state);
+			if (job.outOfCore)
+			{
+				job.ok = job.cache.Finish(job.result.state);
+				if (job.ok)
+					UseCacheColumns(std::make_shared<ColumnCache>(std::move(job.cache)), job.result);
+				continue;
+			}
+			else if (mCacheDirectory.IsEmpty() || job.file.GetSize() < mMinCachedFileSize ||
+				!job.result.mask.empty())
+				continue;
+
+			std::vector<const double*> columns;
+			for (const auto& column : job.result.columns)
+				columns.push_back(column.GetData());
+
+			ColumnCache::Write(ColumnCache::GetFileName(mCacheDirectory, job.result.fileName),
+				job.result.fileName, mFormats.GetStamp(), job.result.state, columns,
+				job.result.columns.front().GetSize());
+		}
+	});
+
+	std::vector<LoadedFile> loadedFiles;
+	for (auto& job : jobs)
+	{
+		if (job.ok)
+			loadedFiles.push_back(std::move(job.result));
+		else
+			failedFiles.Add(job.result.fileName);
+	}
+
+	return loadedFiles;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		ParallelForWithProgress
+//
+// Description:		Runs the function over [0, count) on the pool.  With a
+//					progress function, the items are handed out a few per
+//					thread at a time and progress is reported in between.
+//
+// Input Arguments:
+//		count			= const size_t&
+//		function		= const std::function<void(const size_t&, const size_t&)>&
+//		progress		= const ProgressFunction&, may be empty
+//		progressBegin	= const double&, fraction reported before the first item
+//		progressEnd		= const double&, fraction reported after the last item
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if progress cancelled
+//
+//==========================================================================
+bool DelimitedFileLoader::ParallelForWithProgress(const size_t &count,
+	const std::function<void(const size_t&, const size_t&)> &function,
+	const ProgressFunction &progress, const double &progressBegin,
+	const double &progressEnd) const
+{
+	const size_t batchSize(progress ? 4 * std::max(mPool.GetThreadCount(), 1U) : count);
+	size_t first;
+	for (first = 0; first < count; first += batchSize)
+	{
+		const size_t last(std::min(first + batchSize, count));
+		mPool.ParallelFor(last - first, 1, [&function, first](const size_t &begin, const size_t &end)
+		{
+			function(first + begin, first + end);
+		});
+
+		if (progress && !progress(progressBegin
+			+ (progressEnd - progressBegin) * static_cast<double>(last) / count))
+			return false;
+	}
+
+	return !progress || count > 0 || progress(progressEnd);
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		ReadDescriptions
+//
+// Description:		Gets the column descriptions of a file without parsing
+//					any of its rows.
+//
+// Input Arguments:
+//		fileName		= const wxString&
+//
+// Output Arguments:
+//		descriptions	= wxArrayString&, one per data column
+//
+// Return Value:
+//		bool, false if the file isn't delimited numeric data
+//
+//==========================================================================
+bool DelimitedFileLoader::ReadDescriptions(const wxString &fileName,
+	wxArrayString &descriptions) const
+{
+	MappedFile file;
+	DelimitedParser::Layout layout;
+	if (!file.Open(std::string(fileName.ToUTF8())) || !file.GetData() ||
+		!DetectLayout(fileName, file, layout))
+		return false;
+
+	descriptions.Clear();
+	unsigned int c;
+	for (c = 1; c < layout.columnCount; ++c)
+		descriptions.Add(wxString::FromUTF8(layout.headings[c].c_str()));
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		LoadColumns
+//
+// Description:		Parses more of a file's columns.  The rows are the ones
+//					which were parsed before (up to file.state.size), so the
+//					file may only have grown since then; its checksums are
+//					compared to make sure the old part is unchanged.  If
+//					the file has no row index (or an appended tail made it
+//					stale), one is built first.
+//
+// Input Arguments:
+//		file		= LoadedFile&
+//		mask		= const ColumnMask&, columns wanted (in addition to those
+//					  file already has)
+//		progress	= const ProgressFunction&, may be empty
+//
+// Output Arguments:
+//		file		= LoadedFile&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DelimitedFileLoader::LoadColumns(LoadedFile &file, const ColumnMask &mask,
+	const ProgressFunction &progress) const
+{
+	const DelimitedParser::Layout& layout(file.state.layout);
+	file.columns.resize(layout.columnCount);
+
+	std::vector<unsigned int> wanted;
+	unsigned int c;
+	for (c = 0; c < layout.columnCount; ++c)
+	{
+		if (file.columns[c].GetSize() == 0 && IsSelected(mask, c))
+			wanted.push_back(c);
+	}
+
+	if (!wanted.empty())
+	{
+		uint64_t size;
+		wxLongLong_t modificationTime;
+		MappedFile mappedFile;
+		if (!GetFileInfo(file.fileName, size, modificationTime) || size < file.state.size ||
+			!mappedFile.Open(std::string(file.fileName.ToUTF8())) || !mappedFile.GetData() ||
+			mappedFile.GetSize() < file.state.size)
+			return false;
+
+		const char* data(mappedFile.GetData());
+		const uint64_t checkedBegin(file.state.parsedLength - std::min(mTailChecksumLength,
+			file.state.parsedLength - layout.dataStart));
+		if (ComputeChecksum(data, data + layout.dataStart) != file.state.headerChecksum ||
+			ComputeChecksum(data + checkedBegin, data + file.state.parsedLength) != file.state.tailChecksum)
+			return false;
+
+		std::vector<DelimitedParser::Chunk>& chunks(file.rowIndex);
+		if (chunks.empty())
+		{
+			chunks = DelimitedParser::SplitIntoChunks(data, layout.dataStart,
+				file.state.size, mChunkSize);
+			if (!ParallelForWithProgress(chunks.size(), [&chunks, data](const size_t &begin, const size_t &end)
+			{
+				size_t j;
+				for (j = begin; j < end; ++j)
+					chunks[j].rowCount = DelimitedParser::CountRows(
+						data + chunks[j].begin, data + chunks[j].end);
+			}, progress, 0.0, mRowCountingEffort))
+			{
+				chunks.clear();
+				return false;
+			}
+
+			size_t rowCount(0);
+			for (auto& chunk : chunks)
+			{
+				chunk.firstRow = rowCount;
+				rowCount += chunk.rowCount;
+			}
+		}
+
+		const size_t rowCount(chunks.empty() ? 0 : chunks.back().firstRow + chunks.back().rowCount);
+		if (rowCount == 0 || (file.columns.front().GetSize() > 0 &&
+			file.columns.front().GetSize() != rowCount))
+			return false;
+
+		std::vector<SharedColumn> columns(layout.columnCount);
+		std::vector<double*> destinations(layout.columnCount);
+		for (const auto& column : wanted)
+		{
+			columns[column] = SharedColumn(rowCount);
+			destinations[column] = columns[column].GetWritableData();
+		}
+
+		if (!ParallelForWithProgress(chunks.size(), [&chunks, &destinations, &layout, data](
+			const size_t &begin, const size_t &end)
+		{
+			std::vector<double*> chunkDestinations(destinations.size());
+			size_t j;
+			for (j = begin; j < end; ++j)
+			{
+				unsigned int k;
+				for (k = 0; k < destinations.size(); ++k)
+					chunkDestinations[k] = destinations[k] ? destinations[k] + chunks[j].firstRow : nullptr;
+
+				DelimitedParser::ParseRows(data + chunks[j].begin, data + chunks[j].end,
+					layout, chunkDestinations.data());
+			}
+		}, progress, mRowCountingEffort, 1.0))
+			return false;
+
+		for (const auto& column : wanted)
+			file.columns[column] = std::move(columns[column]);
+	}
+
+	if (file.mask.empty())
+		return true;
+	else if (mask.empty())
+	{
+		file.mask.clear();
+		return true;
+	}
+
+	for (c = 0; c < file.mask.size() && c < mask.size(); ++c)
+		file.mask[c] = file.mask[c] || mask[c];
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		IsSelected
+//
+// Description:		Checks whether a mask selects a column.  The time column
+//					is always selected.
+//
+// Input Arguments:
+//		mask	= const ColumnMask&
+//		column	= const unsigned int&, index in the layout (time column is zero)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DelimitedFileLoader::IsSelected(const ColumnMask &mask, const unsigned int &column)
+{
+	return mask.empty() || column == 0 || (column <= mask.size() && mask[column - 1]);
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		LoadBuffer
+//
+// Description:		Loads delimited text from memory.  The rows in each
+//					chunk are counted, the columns are allocated, and the
+//					chunks are parsed straight into them, a few at a time
+//					so progress can be reported in between.
+//
+// Input Arguments:
+//		data		= const char*
+//		size		= const size_t&
+//		name		= const wxString&, stored as the result's file name
+//		progress	= const ProgressFunction&, may be empty
+//
+// Output Arguments:
+//		result		= LoadedFile&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DelimitedFileLoader::LoadBuffer(const char* data, const size_t &size,
+	const wxString &name, LoadedFile &result, const ProgressFunction &progress) const
+{
+	DelimitedParser::Layout layout;
+	if (!DelimitedParser::DetectLayout(data, size, layout) || layout.columnCount < 2)
+		return false;
+
+	std::vector<DelimitedParser::Chunk> chunks(DelimitedParser::SplitIntoChunks(
+		data, layout.dataStart, size, mBufferChunkSize));
+	mPool.ParallelFor(chunks.size(), 1, [data, &chunks](const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+			chunks[i].rowCount = DelimitedParser::CountRows(
+				data + chunks[i].begin, data + chunks[i].end);
+	});
+
+	size_t rowCount(0);
+	for (auto& chunk : chunks)
+	{
+		chunk.firstRow = rowCount;
+		rowCount += chunk.rowCount;
+	}
+
+	if (rowCount == 0 || rowCount > std::numeric_limits<unsigned int>::max())
+		return false;
+
+	result.fileName = name;
+	result.descriptions.Clear();
+	result.columns.clear();
+	result.columns.resize(layout.columnCount);
+	unsigned int c;
+	for (c = 1; c < layout.columnCount; ++c)
+		result.descriptions.Add(wxString::FromUTF8(layout.headings[c].c_str()));
+
+	mPool.ParallelFor(result.columns.size(), 1, [&result, rowCount](const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+			result.columns[i] = SharedColumn(rowCount);
+	});
+
+	std::vector<double*> destinations(layout.columnCount);
+	for (c = 0; c < layout.columnCount; ++c)
+		destinations[c] = result.columns[c].GetWritableData();
+
+	if (!ParallelForWithProgress(chunks.size(), [data, &layout, &chunks, &destinations](
+		const size_t &begin, const size_t &end)
+	{
+		std::vector<double*> chunkDestinations(destinations.size());
+		size_t i;
+		for (i = begin; i < end; ++i)
+		{
+			unsigned int j;
+			for (j = 0; j < destinations.size(); ++j)
+				chunkDestinations[j] = destinations[j] + chunks[i].firstRow;
+
+			DelimitedParser::ParseRows(data + chunks[i].begin, data + chunks[i].end,
+				layout, chunkDestinations.data());
+		}
+	}, progress, 0.0, 1.0))
+		return false;
+
+	result.state = FileState();
+	result.state.layout = layout;
+	result.state.size = size;
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		CreateDataset
+//
+// Description:		Copies one of a loaded file's data columns, along with
+//					the time column, into a new dataset.
+//
+// Input Arguments:
+//		file	= const LoadedFile&
+//		column	= const unsigned int&, not counting the time column
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> DelimitedFileLoader::CreateDataset(
+	const LoadedFile &file, const unsigned int &column)
+{
+	const size_t count(file.columns.front().GetSize());
+	std::unique_ptr<LibPlot2D::Dataset2D> data(
+		new LibPlot2D::Dataset2D(static_cast<unsigned int>(count)));
+	memcpy(data->GetXPointer(), file.columns.front().GetData(), sizeof(double) * count);
+	memcpy(data->GetYPointer(), file.columns[column + 1].GetData(), sizeof(double) * count);
+	return data;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		LoadTail
+//
+// Description:		Parses the rows that have been appended to a file since
+//					it was last parsed.  The header and the bytes just before
+//					the old end of the data are compared against checksums
+//					taken at the time, so a file that was rewritten rather
+//					than appended to is reported as Modified.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//		state		= const FileState&
+//
+// Output Arguments:
+//		tail		= LoadedTail&
+//
+// Return Value:
+//		TailResult
+//
+//==========================================================================
+DelimitedFileLoader::TailResult DelimitedFileLoader::LoadTail(
+	const wxString &fileName, const FileState &state, LoadedTail &tail)
+{
+	uint64_t size;
+	wxLongLong_t modificationTime;
+	if (!GetFileInfo(fileName, size, modificationTime))
+		return TailResult::Failed;
+
+	if (size == state.size && modificationTime == state.modificationTime)
+		return TailResult::Unchanged;
+	else if (size < state.parsedLength)
+		return TailResult::Modified;
+
+	// The file is read rather than mapped:  it may be truncated (a log being
+	// rotated, for example) while we parse it, and touching a mapped page past
+	// its new end raises SIGBUS.  Only the header and the bytes from the
+	// checked end of the old data onwards are needed.
+	MappedFile file;
+	if (!file.OpenUnmapped(std::string(fileName.ToUTF8())))
+		return TailResult::Failed;
+	else if (file.GetSize() < state.parsedLength)
+		return TailResult::Modified;
+
+	const uint64_t checkedBegin(state.parsedLength - std::min(mTailChecksumLength,
+		state.parsedLength - state.layout.dataStart));
+	std::string header, contents;
+	if (!file.Read(0, state.layout.dataStart, header) ||
+		!file.Read(checkedBegin, file.GetSize() - checkedBegin, contents))
+		return TailResult::Modified;// Shrank since we opened it
+
+	// data[i] is the byte at checkedBegin + i
+	const char* data(contents.data());
+	const uint64_t oldEnd(state.parsedLength - checkedBegin);
+	if (ComputeChecksum(header.data(), header.data() + header.size()) != state.headerChecksum ||
+		ComputeChecksum(data, data + oldEnd) != state.tailChecksum)
+		return TailResult::Modified;
+
+	tail.state = state;
+	tail.state.modificationTime = modificationTime;
+	UpdateState(header.data(), data, checkedBegin, file.GetSize(), tail.state);
+	tail.replacedRows = state.hasPartialRow ? 1 : 0;
+
+	std::vector<DelimitedParser::Chunk> chunks(DelimitedParser::SplitIntoChunks(
+		data, oldEnd, contents.size(), mChunkSize));
+	mPool.ParallelFor(chunks.size(), 1, [&chunks, data](const size_t &begin, const size_t &end)
+	{
+		size_t j;
+		for (j = begin; j < end; ++j)
+			chunks[j].rowCount = DelimitedParser::CountRows(
+				data + chunks[j].begin, data + chunks[j].end);
+	});
+
+	size_t rowCount(0);
+	for (auto& chunk : chunks)
+	{
+		chunk.firstRow = rowCount;
+		rowCount += chunk.rowCount;
+	}
+
+	tail.columns.assign(state.layout.columnCount, std::vector<double>(rowCount));
+	mPool.ParallelFor(chunks.size(), 1, [&chunks, &tail, &state, data](const size_t &begin, const size_t &end)
+	{
+		std::vector<double*> destinations(tail.columns.size());
+		size_t j;
+		for (j = begin; j < end; ++j)
+		{
+			unsigned int c;
+			for (c = 0; c < destinations.size(); ++c)
+				destinations[c] = tail.columns[c].data() + chunks[j].firstRow;
+
+			DelimitedParser::ParseRows(data + chunks[j].begin, data + chunks[j].end,
+				state.layout, destinations.data());
+		}
+	});
+
+	return TailResult::Appended;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		GetFileInfo
+//
+// Description:		Gets the size and modification time of a file.
+//
+// Input Arguments:
+//		fileName			= const wxString&
+//
+// Output Arguments:
+//		size				= uint64_t&
+//		modificationTime	= wxLongLong_t&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool DelimitedFileLoader::GetFileInfo(const wxString &fileName, uint64_t &size,
+	wxLongLong_t &modificationTime)
+{
+	wxFileName file(fileName);
+	const wxULongLong fileSize(file.GetSize());
+	if (fileSize == wxInvalidSize)
+		return false;
+
+	const wxDateTime time(file.GetModificationTime());
+	if (!time.IsValid())
+		return false;
+
+	size = fileSize.GetValue();
+	modificationTime = time.GetValue().GetValue();
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		UpdateState
+//
+// Description:		Records where the complete rows end, whether anything
+//					follows them, and the checksums used to detect changes.
+//					The layout and modification time must already be set.
+//					Only the end of the file need be available, as long as
+//					it reaches back to the start of the bytes checksummed
+//					when the state was last updated.
+//
+// Input Arguments:
+//		header		= const char*, the file's first layout.dataStart bytes
+//		data		= const char*, the file from dataOffset to size
+//		dataOffset	= const uint64_t&, [bytes from the start of the file]
+//		size		= const uint64_t&, [bytes]
+//
+// Output Arguments:
+//		state		= FileState&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DelimitedFileLoader::UpdateState(const char* header, const char* data,
+	const uint64_t &dataOffset, const uint64_t &size, FileState &state)
+{
+	state.size = size;
+
+	state.parsedLength = state.size;
+	while (state.parsedLength > std::max<uint64_t>(state.layout.dataStart, dataOffset) &&
+		data[state.parsedLength - dataOffset - 1] != '\n')
+		--state.parsedLength;
+
+	state.hasPartialRow = DelimitedParser::CountRows(data + (state.parsedLength - dataOffset),
+		data + (state.size - dataOffset)) > 0;
+
+	const uint64_t checkedBegin(state.parsedLength - std::min(mTailChecksumLength,
+		state.parsedLength - state.layout.dataStart));
+	state.headerChecksum = ComputeChecksum(header, header + state.layout.dataStart);
+	state.tailChecksum = ComputeChecksum(data + (checkedBegin - dataOffset),
+		data + (state.parsedLength - dataOffset));
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		GetInCoreMemoryLimit
+//
+// Description:		Returns the most memory that loaded columns should use.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint64_t, [bytes]
+//
+//==========================================================================
+uint64_t DelimitedFileLoader::GetInCoreMemoryLimit()
+{
+	const wxLongLong_t freeMemory(wxGetFreeMemory().GetValue());
+	if (freeMemory < 0)// Unknown on this platform
+		return std::numeric_limits<uint64_t>::max();
+
+	return static_cast<uint64_t>(freeMemory * mMaxInCoreMemoryFraction);
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		UseCacheColumns
+//
+// Description:		Points the file's columns at the columns in the cache,
+//					which is kept open for as long as any of them are used.
+//
+// Input Arguments:
+//		cache	= const std::shared_ptr<const ColumnCache>&
+//
+// Output Arguments:
+//		file	= LoadedFile&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DelimitedFileLoader::UseCacheColumns(
+	const std::shared_ptr<const ColumnCache> &cache, LoadedFile &file)
+{
+	const size_t rowCount(static_cast<size_t>(cache->GetRowCount()));
+	file.columns.resize(cache->GetState().layout.columnCount);
+	unsigned int c;
+	for (c = 0; c < file.columns.size(); ++c)
+		file.columns[c] = SharedColumn(cache, cache->GetColumn(c), rowCount);
+	file.outOfCore = true;
+}
+
+//==========================================================================
+// Class:			DelimitedFileLoader
+// Function:		ComputeChecksum
+//
+// Description:		Computes the 64-bit FNV-1a hash of the specified bytes.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint64_t
+//
+//==========================================================================
+uint64_t DelimitedFileLoader::ComputeChecksum(const char* begin, const char* end)
+{
+	uint64_t hash(14695981039346656037ULL);
+	const char* p;
+	for (p = begin; p < end; ++p)
+	{
+		hash ^= static_cast<unsigned char>(*p);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
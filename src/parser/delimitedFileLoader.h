@@ -0,0 +1,184 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  delimitedFileLoader.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Loads delimited numeric files by memory mapping them and parsing
+//				 row chunks in parallel, writing values straight into Dataset2D
+//				 buffers.
+// History:
+
+#ifndef DELIMITED_FILE_LOADER_H_
+#define DELIMITED_FILE_LOADER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "parser/delimitedParser.h"
+#include "utilities/sharedColumn.h"
+
+// Local forward declarations
+class ThreadPool;
+class MappedFile;
+class CustomFormatMatcher;
+class ColumnCache;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Parallel loader for delimited text files
+class DelimitedFileLoader
+{
+public:
+	DelimitedFileLoader(ThreadPool &pool, const CustomFormatMatcher &formats);
+
+	// Large files are cached in binary form in this directory after they are
+	// parsed, and read from the cache while it is current.  Caching is off
+	// until a directory is set.  Files too large to hold in memory are
+	// parsed into the cache and used from there (only while caching is on).
+	void SetCacheDirectory(const wxString &directory) { mCacheDirectory = directory; }
+
+	// What we knew about the file the last time it was parsed; used to
+	// decide whether a reload can parse only the newly appended rows
+	struct FileState
+	{
+		DelimitedParser::Layout layout;
+		uint64_t size = 0;
+		wxLongLong_t modificationTime = 0;
+		uint64_t parsedLength = 0;// End of the last complete (newline-terminated) row
+		bool hasPartialRow = false;// True if a row without a line ending was parsed after parsedLength
+		uint64_t headerChecksum = 0;// Covers [0, layout.dataStart)
+		uint64_t tailChecksum = 0;// Covers the last few kB before parsedLength
+	};
+
+	// One flag per data column (time column not counted); empty selects all
+	typedef std::vector<bool> ColumnMask;
+
+	struct LoadedFile
+	{
+		wxString fileName;
+		wxArrayString descriptions;// One per data column
+		std::vector<SharedColumn> columns;// Time column first, then the data columns (empty if not selected)
+		FileState state;
+		bool outOfCore = false;// True if the columns refer to a mapped cache file
+		ColumnMask mask;// Columns which were parsed
+		std::vector<DelimitedParser::Chunk> rowIndex;// Only kept if some columns were skipped
+	};
+
+	// Copies the time column and a data column (zero-based, not counting the
+	// time column) into a new dataset
+	static std::unique_ptr<LibPlot2D::Dataset2D> CreateDataset(const LoadedFile &file,
+		const unsigned int &column);
+
+	enum class TailResult
+	{
+		Unchanged,
+		Appended,
+		Modified,// Data before the old end of the file changed; needs a full reload
+		Failed
+	};
+
+	struct LoadedTail
+	{
+		unsigned int replacedRows = 0;// Rows at the end of the old data to discard first
+		std::vector<std::vector<double>> columns;// Time column first
+		FileState state;
+	};
+
+	// Returns false for files which must be handled by one of the LibPlot2D
+	// file types instead (most custom formats, etc.)
+	bool CanLoad(const wxString &fileName) const;
+
+	// Called between stages of a long parse with the fraction completed;
+	// returns false to cancel
+	typedef std::function<bool(const double&)> ProgressFunction;
+
+	// Called with a file's name and column descriptions as soon as its
+	// layout is known (before its rows are parsed)
+	typedef std::function<void(const wxString&, const wxArrayString&)> LayoutFunction;
+
+	// All files are parsed concurrently; files that turn out not to be
+	// delimited numeric data are returned in failedFiles.  If progress
+	// cancels the load, nothing is returned (and no files are failed).
+	// masks may hold one entry per file to parse only some of its columns
+	// (the others are only skipped over); such files are kept in memory.
+	std::vector<LoadedFile> Load(const wxArrayString &fileList,
+		wxArrayString &failedFiles, const ProgressFunction &progress = nullptr,
+		const LayoutFunction &layoutKnown = nullptr,
+		const std::vector<ColumnMask> &masks = std::vector<ColumnMask>());
+
+	// Reads only the header; returns false if it isn't a delimited numeric file
+	bool ReadDescriptions(const wxString &fileName, wxArrayString &descriptions) const;
+
+	// Parses the columns selected by mask that file doesn't have yet (and
+	// the time column, if it is empty), using the file's row index to skip
+	// straight to each chunk of rows.  Returns false if the file has
+	// changed since file.state was recorded or progress returned false.
+	bool LoadColumns(LoadedFile &file, const ColumnMask &mask,
+		const ProgressFunction &progress = nullptr) const;
+
+	// Parses delimited text held in memory (pasted text, etc.) in place,
+	// filling the datasets directly.  Returns false if it isn't delimited
+	// numeric data or progress returned false.
+	bool LoadBuffer(const char* data, const size_t &size, const wxString &name,
+		LoadedFile &result, const ProgressFunction &progress = nullptr) const;
+
+	// Parses only the rows added since the file was in the specified state
+	TailResult LoadTail(const wxString &fileName, const FileState &state,
+		LoadedTail &tail);
+
+	// 64-bit FNV-1a hash
+	static uint64_t ComputeChecksum(const char* begin, const char* end);
+
+private:
+	ThreadPool &mPool;
+	const CustomFormatMatcher &mFormats;
+	wxString mCacheDirectory;
+
+	static const size_t mChunkSize;
+	static const size_t mBufferChunkSize;
+	static const uint64_t mTailChecksumLength;
+	static const uint64_t mMinCachedFileSize;
+	static const double mMaxInCoreMemoryFraction;
+	static const double mRowCountingEffort;
+
+	bool DetectLayout(const wxString &fileName, const MappedFile &file,
+		DelimitedParser::Layout &layout) const;
+
+	// Runs function over [0, count) on the pool, a few items per thread at a
+	// time when reporting progress (scaled to [progressBegin, progressEnd])
+	bool ParallelForWithProgress(const size_t &count,
+		const std::function<void(const size_t&, const size_t&)> &function,
+		const ProgressFunction &progress,
+		const double &progressBegin, const double &progressEnd) const;
+
+	static bool IsSelected(const ColumnMask &mask, const unsigned int &column);
+
+	static bool GetFileInfo(const wxString &fileName, uint64_t &size,
+		wxLongLong_t &modificationTime);
+	static void UpdateState(const char* header, const char* data,
+		const uint64_t &dataOffset, const uint64_t &size, FileState &state);
+
+	static uint64_t GetInCoreMemoryLimit();
+	static void UseCacheColumns(const std::shared_ptr<const ColumnCache> &cache,
+		LoadedFile &file);
+};
+
+#endif// DELIMITED_FILE_LOADER_H_
@@ -0,0 +1,780 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  delimitedParser.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Low-level routines for parsing delimited numeric text directly
+//				 out of a memory buffer.  Knows nothing about files or datasets,
+//				 so the same code serves mapped files, clipboard text, etc.
+// History:
+
+// Standard C++ headers
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <clocale>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+// Local headers
+#include "parser/delimitedParser.h"
+
+// Platform headers
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DELIMITED_PARSER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for DelimitedParser class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char DelimitedParser::mCandidateDelimiters[] = { ',', '\t', ';', ' ' };
+const size_t DelimitedParser::mMaxHeaderScanLength(1 << 20);
+const unsigned int DelimitedParser::mMaxTokenLength(64);
+const double DelimitedParser::mPowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+	1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+	1e20, 1e21, 1e22 };
+const int DelimitedParser::mMaxExactPowerOfTen(22);// Largest exactly representable
+const unsigned int DelimitedParser::mMaxMantissaDigits(19);// Always fit in 64 bits
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		DetectLayout
+//
+// Description:		Examines the beginning of the buffer to determine the
+//					delimiter, column count, column headings and the location
+//					of the first data row.  Data starts at the first row that
+//					is followed by more rows with the same number of numeric
+//					columns.  Unless the delimiter is a comma, numbers may
+//					also use a decimal comma.
+//
+// Input Arguments:
+//		data		= const char*
+//		size		= const size_t&
+//		delimiter	= const char&, zero to try each candidate
+//
+// Output Arguments:
+//		layout		= Layout&
+//
+// Return Value:
+//		bool, true if the buffer looks like delimited numeric data
+//
+//==========================================================================
+bool DelimitedParser::DetectLayout(const char* data, const size_t &size, Layout &layout,
+	const char &delimiter)
+{
+	const char* scanEnd(data + std::min(size, mMaxHeaderScanLength));
+
+	struct Line
+	{
+		const char* begin;
+		const char* end;
+	};
+	std::vector<Line> lines;
+	const char* p(data);
+	const unsigned int maxLines(200);
+	while (p < scanEnd && lines.size() < maxLines)
+	{
+		const char* lineEnd(FindLineEnd(p, scanEnd));
+		if (lineEnd == scanEnd && scanEnd != data + size)
+			break;// Don't examine a partial line
+
+		const char* stop(lineEnd);
+		if (stop > p && *(stop - 1) == '\r')
+			--stop;
+		if (!IsBlankLine(p, stop))
+			lines.push_back({ p, stop });
+		p = std::min(lineEnd + 1, scanEnd);
+	}
+
+	const std::string candidates(delimiter != 0 ? std::string(1, delimiter) :
+		std::string(mCandidateDelimiters, sizeof(mCandidateDelimiters)));
+
+	const unsigned int confirmationRows(3);
+	const char decimalSeparators[] = { '.', ',' };
+	bool found(false);
+	std::vector<std::string> tokens;
+	for (const char candidate : candidates)
+	{
+		for (const char decimalSeparator : decimalSeparators)
+		{
+			if (decimalSeparator == candidate)
+				continue;
+
+			unsigned int i;
+			for (i = 0; i < lines.size(); ++i)
+			{
+				SplitLine(lines[i].begin, lines[i].end, candidate, tokens);
+				if (tokens.size() < 2 || !IsNumericLine(tokens, decimalSeparator))
+					continue;
+
+				const unsigned int columnCount(static_cast<unsigned int>(tokens.size()));
+				unsigned int j;
+				for (j = i + 1; j < std::min(i + 1 + confirmationRows, static_cast<unsigned int>(lines.size())); ++j)
+				{
+					SplitLine(lines[j].begin, lines[j].end, candidate, tokens);
+					if (tokens.size() != columnCount || !IsNumericLine(tokens, decimalSeparator))
+						break;
+				}
+
+				if (j < std::min(i + 1 + confirmationRows, static_cast<unsigned int>(lines.size())))
+					continue;
+
+				if (!found || columnCount > layout.columnCount)
+				{
+					found = true;
+					layout.delimiter = candidate;
+					layout.decimalSeparator = decimalSeparator;
+					layout.columnCount = columnCount;
+					layout.dataStart = lines[i].begin - data;
+
+					layout.headings.clear();
+					if (i > 0)
+					{
+						SplitLine(lines[i - 1].begin, lines[i - 1].end, candidate, tokens);
+						if (tokens.size() == columnCount)
+							layout.headings = tokens;
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	if (!found)
+		return false;
+
+	if (layout.headings.empty())
+	{
+		unsigned int c;
+		for (c = 0; c < layout.columnCount; ++c)
+			layout.headings.push_back(c == 0 ? std::string("Time") :
+				"Column " + std::to_string(c));
+	}
+
+	for (auto& heading : layout.headings)
+	{
+		if (heading.size() >= 2 && heading.front() == '"' && heading.back() == '"')
+			heading = Trim(heading.substr(1, heading.size() - 2));
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		SplitIntoChunks
+//
+// Description:		Breaks the data region into chunks that begin and end on
+//					newline boundaries, suitable for parsing independently.
+//
+// Input Arguments:
+//		data		= const char*
+//		begin		= const size_t&
+//		end			= const size_t&
+//		targetSize	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<Chunk>
+//
+//==========================================================================
+std::vector<DelimitedParser::Chunk> DelimitedParser::SplitIntoChunks(
+	const char* data, const size_t &begin, const size_t &end, const size_t &targetSize)
+{
+	std::vector<Chunk> chunks;
+	size_t chunkBegin(begin);
+	while (chunkBegin < end)
+	{
+		Chunk chunk;
+		chunk.begin = chunkBegin;
+		if (end - chunkBegin <= targetSize)
+			chunk.end = end;
+		else
+		{
+			const char* lineEnd(FindLineEnd(data + chunkBegin + targetSize, data + end));
+			chunk.end = std::min(static_cast<size_t>(lineEnd - data) + 1, end);
+		}
+
+		chunks.push_back(chunk);
+		chunkBegin = chunk.end;
+	}
+
+	return chunks;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		CountRows
+//
+// Description:		Counts the non-blank lines in the specified range.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t DelimitedParser::CountRows(const char* begin, const char* end)
+{
+	size_t count(0);
+	const char* p(begin);
+	while (p < end)
+	{
+		const char* lineEnd(FindLineEnd(p, end));
+		const char* stop(lineEnd);
+		if (stop > p && *(stop - 1) == '\r')
+			--stop;
+		if (!IsBlankLine(p, stop))
+			++count;
+		p = std::min(lineEnd + 1, end);
+	}
+
+	return count;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		ParseRows
+//
+// Description:		Converts the rows in the specified range, writing values
+//					directly into the destination arrays.  Must be given the
+//					same range that was passed to CountRows() so that the
+//					destinations are large enough.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//		layout	= const Layout&
+//		columns	= double* const*, one destination per column (may be null)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DelimitedParser::ParseRows(const char* begin, const char* end,
+	const Layout &layout, double* const* columns)
+{
+	const double nan(std::numeric_limits<double>::quiet_NaN());
+	const bool collapseWhitespace(layout.delimiter == ' ');
+
+	auto store([columns, nan, &layout](const unsigned int &c, const size_t &row,
+		const char* tokenBegin, const char* tokenEnd)
+	{
+		if (!columns[c])
+			return;
+
+		double value;
+		if (!ToDouble(tokenBegin, tokenEnd, layout.decimalSeparator, value))
+			value = nan;
+		else if (!layout.scales.empty())
+			value *= layout.scales[c];
+		columns[c][row] = value;
+	});
+
+	size_t row(0);
+	const char* p(begin);
+	if (collapseWhitespace)
+	{
+		while (p < end)
+		{
+			const char* lineEnd(FindLineEnd(p, end));
+			const char* stop(lineEnd);
+			if (stop > p && *(stop - 1) == '\r')
+				--stop;
+
+			if (IsBlankLine(p, stop))
+			{
+				p = std::min(lineEnd + 1, end);
+				continue;
+			}
+
+			unsigned int c(0);
+			const char* t(p);
+			while (c < layout.columnCount)
+			{
+				while (t < stop && (*t == ' ' || *t == '\t'))
+					++t;
+				if (t == stop)
+					break;
+
+				const char* tokenEnd(t);
+				while (tokenEnd < stop && *tokenEnd != ' ' && *tokenEnd != '\t')
+					++tokenEnd;
+
+				store(c++, row, t, tokenEnd);
+				t = tokenEnd;
+			}
+
+			for (; c < layout.columnCount; ++c)
+			{
+				if (columns[c])
+					columns[c][row] = nan;
+			}
+
+			++row;
+			p = std::min(lineEnd + 1, end);
+		}
+
+		return;
+	}
+
+	// Blank lines are found the same way as in CountRows() (lines of only
+	// whitespace, which may include delimiters such as tabs); the rest of the
+	// row is then scanned once, stopping at either the delimiter or the newline
+	while (p < end)
+	{
+		const char* lineEnd(FindLineEnd(p, end));
+		if (IsBlankLine(p, lineEnd))
+		{
+			p = std::min(lineEnd + 1, end);
+			continue;
+		}
+
+		unsigned int c(0);
+		const char* t(p);
+		const char* tokenEnd(FindTokenEnd(t, end, layout.delimiter));
+
+		for (;;)
+		{
+			store(c++, row, t, tokenEnd);
+			if (tokenEnd == end || *tokenEnd == '\n')
+				break;
+			else if (c == layout.columnCount)
+			{
+				tokenEnd = lineEnd;
+				break;
+			}
+
+			t = tokenEnd + 1;
+			tokenEnd = FindTokenEnd(t, end, layout.delimiter);
+		}
+
+		for (; c < layout.columnCount; ++c)
+		{
+			if (columns[c])
+				columns[c][row] = nan;
+		}
+
+		++row;
+		p = std::min(tokenEnd + 1, end);
+	}
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		IsBlankLine
+//
+// Description:		Checks for lines containing only whitespace.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DelimitedParser::IsBlankLine(const char* begin, const char* end)
+{
+	const char* p(begin);
+	while (p < end)
+	{
+		if (!isspace(static_cast<unsigned char>(*p)))
+			return false;
+		++p;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		FindLineEnd
+//
+// Description:		Locates the next newline character.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char* pointing to the newline, or end if there is none
+//
+//==========================================================================
+const char* DelimitedParser::FindLineEnd(const char* begin, const char* end)
+{
+	if (begin >= end)
+		return end;
+
+	const char* lineEnd(static_cast<const char*>(memchr(begin, '\n', end - begin)));
+	if (!lineEnd)
+		return end;
+	return lineEnd;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		FindTokenEnd
+//
+// Description:		Locates the next delimiter or newline character.  Where
+//					SSE2 is available, sixteen characters are checked at once.
+//
+// Input Arguments:
+//		begin		= const char*
+//		end			= const char*
+//		delimiter	= const char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const char* pointing to the delimiter or newline, or end if there is
+//		neither
+//
+//==========================================================================
+const char* DelimitedParser::FindTokenEnd(const char* begin, const char* end,
+	const char &delimiter)
+{
+	const char* p(begin);
+#ifdef DELIMITED_PARSER_SSE2
+	const __m128i delimiters(_mm_set1_epi8(delimiter));
+	const __m128i newlines(_mm_set1_epi8('\n'));
+	while (end - p >= 16)
+	{
+		const __m128i block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		const unsigned int matches(static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, newlines)))));
+		if (matches != 0)
+		{
+#ifdef _MSC_VER
+			unsigned long first;
+			_BitScanForward(&first, matches);
+			return p + first;
+#else
+			return p + __builtin_ctz(matches);
+#endif
+		}
+
+		p += 16;
+	}
+#endif
+
+	while (p < end && *p != delimiter && *p != '\n')
+		++p;
+	return p;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		SplitLine
+//
+// Description:		Splits a line into trimmed tokens.  Only used while
+//					detecting the layout, where allocation doesn't matter.
+//
+// Input Arguments:
+//		begin		= const char*
+//		end			= const char*
+//		delimiter	= const char&
+//
+// Output Arguments:
+//		tokens		= std::vector<std::string>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DelimitedParser::SplitLine(const char* begin, const char* end,
+	const char &delimiter, std::vector<std::string> &tokens)
+{
+	tokens.clear();
+	const char* p(begin);
+	if (delimiter == ' ')
+	{
+		while (p < end)
+		{
+			while (p < end && (*p == ' ' || *p == '\t'))
+				++p;
+			if (p == end)
+				break;
+
+			const char* tokenEnd(p);
+			while (tokenEnd < end && *tokenEnd != ' ' && *tokenEnd != '\t')
+				++tokenEnd;
+			tokens.push_back(std::string(p, tokenEnd));
+			p = tokenEnd;
+		}
+		return;
+	}
+
+	for (;;)
+	{
+		const char* tokenEnd(static_cast<const char*>(memchr(p, delimiter, end - p)));
+		if (!tokenEnd)
+			tokenEnd = end;
+		tokens.push_back(Trim(std::string(p, tokenEnd)));
+		if (tokenEnd == end)
+			break;
+		p = tokenEnd + 1;
+	}
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		ToDouble
+//
+// Description:		Converts a token to a number.  Mapped data is not null
+//					terminated, so the digits are read directly.  When there
+//					are no more than 19 significant digits, the mantissa fits
+//					in 53 bits and the power of ten is exactly representable,
+//					a single multiplication or division gives the correctly
+//					rounded result.  Anything else is left to ToDoubleSlow().
+//
+// Input Arguments:
+//		begin				= const char*
+//		end					= const char*
+//		decimalSeparator	= const char&
+//
+// Output Arguments:
+//		value	= double&
+//
+// Return Value:
+//		bool, true if the whole token is a valid number
+//
+//==========================================================================
+bool DelimitedParser::ToDouble(const char* begin, const char* end,
+	const char &decimalSeparator, double &value)
+{
+	while (begin < end && isspace(static_cast<unsigned char>(*begin)))
+		++begin;
+	while (end > begin && isspace(static_cast<unsigned char>(*(end - 1))))
+		--end;
+
+	if (begin == end)
+		return false;
+
+	const char* p(begin);
+	const bool negative(*p == '-');
+	if (*p == '-' || *p == '+')
+		++p;
+
+	uint64_t mantissa(0);
+	unsigned int digitCount(0);// Significant digits in mantissa
+	int exponent(0);
+	bool truncated(false);
+	bool foundDigit(false);
+	bool inFraction(false);
+	for (; p < end; ++p)
+	{
+		const unsigned int digit(static_cast<unsigned char>(*p - '0'));
+		if (digit > 9)
+		{
+			if (*p != decimalSeparator || inFraction)
+				break;
+			inFraction = true;
+			continue;
+		}
+
+		foundDigit = true;
+		if (digitCount < mMaxMantissaDigits)
+		{
+			mantissa = mantissa * 10 + digit;
+			if (mantissa > 0)
+				++digitCount;
+			if (inFraction)
+				--exponent;
+		}
+		else
+		{
+			if (!inFraction)
+				++exponent;
+			truncated = truncated || digit != 0;
+		}
+	}
+
+	if (foundDigit && p < end && (*p == 'e' || *p == 'E'))
+	{
+		++p;
+		const bool negativeExponent(p < end && *p == '-');
+		if (p < end && (*p == '-' || *p == '+'))
+			++p;
+
+		const int maxExponent(100000);
+		int writtenExponent(0);
+		const char* exponentStart(p);
+		for (; p < end && *p >= '0' && *p <= '9'; ++p)
+		{
+			if (writtenExponent < maxExponent)
+				writtenExponent = writtenExponent * 10 + *p - '0';
+		}
+
+		if (p == exponentStart)
+			return ToDoubleSlow(begin, end, decimalSeparator, value);
+		exponent += negativeExponent ? -writtenExponent : writtenExponent;
+	}
+
+	// Also catches things like "nan" and "inf", which we still accept
+	if (!foundDigit || p != end)
+		return ToDoubleSlow(begin, end, decimalSeparator, value);
+
+	if (mantissa == 0)
+		value = 0.0;
+	else if (!truncated && mantissa <= (static_cast<uint64_t>(1) << 53) &&
+		exponent >= -mMaxExactPowerOfTen && exponent <= mMaxExactPowerOfTen)
+	{
+		value = static_cast<double>(mantissa);
+		if (exponent < 0)
+			value /= mPowersOfTen[-exponent];
+		else
+			value *= mPowersOfTen[exponent];
+	}
+	else
+		return ToDoubleSlow(begin, end, decimalSeparator, value);
+
+	if (negative)
+		value = -value;
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		ToDoubleSlow
+//
+// Description:		Converts a token using strtod().  The token is copied to
+//					a stack buffer first, because mapped data is not null
+//					terminated, and the decimal separator is replaced with
+//					the one strtod() expects in the current locale.
+//
+// Input Arguments:
+//		begin				= const char*, whitespace already removed
+//		end					= const char*
+//		decimalSeparator	= const char&
+//
+// Output Arguments:
+//		value	= double&
+//
+// Return Value:
+//		bool, true if the whole token is a valid number
+//
+//==========================================================================
+bool DelimitedParser::ToDoubleSlow(const char* begin, const char* end,
+	const char &decimalSeparator, double &value)
+{
+	const size_t length(end - begin);
+	if (length == 0 || length >= mMaxTokenLength)
+		return false;
+
+	const char localeSeparator(*localeconv()->decimal_point);
+	char buffer[mMaxTokenLength];
+	size_t i;
+	for (i = 0; i < length; ++i)
+	{
+		if (begin[i] == decimalSeparator)
+			buffer[i] = localeSeparator;
+		else if (begin[i] == '.' || begin[i] == ',')
+			return false;
+		else
+			buffer[i] = begin[i];
+	}
+	buffer[length] = '\0';
+
+	char* stop;
+	value = strtod(buffer, &stop);
+	return stop == buffer + length;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		IsNumericLine
+//
+// Description:		Checks to see if every token is a number.
+//
+// Input Arguments:
+//		tokens				= const std::vector<std::string>&
+//		decimalSeparator	= const char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DelimitedParser::IsNumericLine(const std::vector<std::string> &tokens,
+	const char &decimalSeparator)
+{
+	double value;
+	for (const auto& token : tokens)
+	{
+		if (!ToDouble(token.data(), token.data() + token.size(), decimalSeparator, value))
+			return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DelimitedParser
+// Function:		Trim
+//
+// Description:		Removes leading and trailing whitespace.
+//
+// Input Arguments:
+//		s	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string DelimitedParser::Trim(const std::string &s)
+{
+	const size_t first(s.find_first_not_of(" \t\r\n"));
+	if (first == std::string::npos)
+		return std::string();
+
+	const size_t last(s.find_last_not_of(" \t\r\n"));
+	return s.substr(first, last - first + 1);
+}
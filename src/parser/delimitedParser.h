@@ -0,0 +1,98 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  delimitedParser.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Low-level routines for parsing delimited numeric text directly
+//				 out of a memory buffer.  Knows nothing about files or datasets,
+//				 so the same code serves mapped files, clipboard text, etc.
+// History:
+
+#ifndef DELIMITED_PARSER_H_
+#define DELIMITED_PARSER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// Parser for buffers of delimited numeric text
+class DelimitedParser
+{
+public:
+	// Description of the buffer's structure, found by DetectLayout()
+	struct Layout
+	{
+		char delimiter = ',';
+		char decimalSeparator = '.';// ',' is recognized if the delimiter isn't
+		unsigned int columnCount = 0;
+		size_t dataStart = 0;// Byte offset of the first data row
+		std::vector<std::string> headings;// One per column (time column included)
+		std::vector<double> scales;// Applied by ParseRows(); empty if all are 1
+		double timeScale = 1.0;// [sec/unit] of the time column; not applied by ParseRows()
+	};
+
+	// Piece of the buffer that starts and ends on row boundaries
+	struct Chunk
+	{
+		size_t begin;
+		size_t end;
+		size_t rowCount = 0;
+		size_t firstRow = 0;
+	};
+
+	// If delimiter is zero, each of the usual delimiters is tried
+	static bool DetectLayout(const char* data, const size_t &size, Layout &layout,
+		const char &delimiter = 0);
+
+	// Breaks [begin, end) into pieces of roughly targetSize bytes
+	static std::vector<Chunk> SplitIntoChunks(const char* data, const size_t &begin,
+		const size_t &end, const size_t &targetSize);
+
+	static size_t CountRows(const char* begin, const char* end);
+
+	// Converts each row in [begin, end) and writes one value per column into
+	// columns[c][row]; columns with a null destination are skipped.  Empty or
+	// unreadable cells are stored as NaN.
+	static void ParseRows(const char* begin, const char* end, const Layout &layout,
+		double* const* columns);
+
+	// Converts a token without regard to the current locale.  Leading and
+	// trailing whitespace is ignored.  Returns false unless the whole token
+	// is a number.
+	static bool ToDouble(const char* begin, const char* end,
+		const char &decimalSeparator, double &value);
+
+private:
+	static const char mCandidateDelimiters[];
+	static const size_t mMaxHeaderScanLength;
+	static const unsigned int mMaxTokenLength;
+	static const double mPowersOfTen[];
+	static const int mMaxExactPowerOfTen;
+	static const unsigned int mMaxMantissaDigits;
+
+	static bool IsBlankLine(const char* begin, const char* end);
+	static const char* FindLineEnd(const char* begin, const char* end);
+
+	// Returns a pointer to the first delimiter or newline, or end
+	static const char* FindTokenEnd(const char* begin, const char* end,
+		const char &delimiter);
+
+	static void SplitLine(const char* begin, const char* end, const char &delimiter,
+		std::vector<std::string> &tokens);
+	// Handles what ToDouble() can't convert exactly by itself
+	static bool ToDoubleSlow(const char* begin, const char* end,
+		const char &decimalSeparator, double &value);
+	static bool IsNumericLine(const std::vector<std::string> &tokens,
+		const char &decimalSeparator);
+	static std::string Trim(const std::string &s);
+};
+
+#endif// DELIMITED_PARSER_H_
@@ -0,0 +1,472 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  mappedFile.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Memory mapping of a file.
+// History:
+
+// Standard C++ headers
+#include <utility>
+#include <algorithm>
+#include <cerrno>
+
+// OS headers
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Local headers
+#include "parser/mappedFile.h"
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		MappedFile
+//
+// Description:		Constructor for MappedFile class.
+//
+// Input Arguments:
+//		fileName	= const std::string&, UTF-8 encoded
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MappedFile::MappedFile(const std::string &fileName)
+{
+	Open(fileName);
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		~MappedFile
+//
+// Description:		Destructor for MappedFile class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		MappedFile
+//
+// Description:		Move constructor for MappedFile class.
+//
+// Input Arguments:
+//		other	= MappedFile&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MappedFile::MappedFile(MappedFile&& other)
+{
+	Swap(other);
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		operator=
+//
+// Description:		Move assignment operator for MappedFile class.
+//
+// Input Arguments:
+//		other	= MappedFile&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		MappedFile&
+//
+//==========================================================================
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+	if (this != &other)
+	{
+		Close();
+		Swap(other);
+	}
+
+	return *this;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		Swap
+//
+// Description:		Exchanges contents with another object.
+//
+// Input Arguments:
+//		other	= MappedFile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MappedFile::Swap(MappedFile &other)
+{
+	std::swap(mData, other.mData);
+	std::swap(mSize, other.mSize);
+	std::swap(mIsEmptyFile, other.mIsEmptyFile);
+	std::swap(mWritable, other.mWritable);
+	std::swap(mIsUnmapped, other.mIsUnmapped);
+#ifdef _WIN32
+	std::swap(mFileHandle, other.mFileHandle);
+	std::swap(mMappingHandle, other.mMappingHandle);
+#else
+	std::swap(mFileDescriptor, other.mFileDescriptor);
+#endif
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		Open
+//
+// Description:		Maps the specified file into memory.
+//
+// Input Arguments:
+//		fileName	= const std::string&, UTF-8 encoded
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool MappedFile::Open(const std::string &fileName)
+{
+	if (!OpenUnmapped(fileName))
+		return false;
+
+	mIsUnmapped = false;
+	if (mSize == 0)
+	{
+		mIsEmptyFile = true;
+		return true;
+	}
+
+#ifdef _WIN32
+	mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mMappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	mData = static_cast<const char*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+	void* address(mmap(nullptr, mSize, PROT_READ, MAP_SHARED, mFileDescriptor, 0));
+	if (address != MAP_FAILED)
+		mData = static_cast<const char*>(address);
+#endif
+
+	if (!mData)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		OpenUnmapped
+//
+// Description:		Opens the specified file for reading with Read().
+//
+// Input Arguments:
+//		fileName	= const std::string&, UTF-8 encoded
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool MappedFile::OpenUnmapped(const std::string &fileName)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file(CreateFileW(ToWide(fileName).c_str(), GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	mFileHandle = file;
+	mSize = static_cast<uint64_t>(size.QuadPart);
+#else
+	mFileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (mFileDescriptor < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(mFileDescriptor, &info) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	mSize = static_cast<uint64_t>(info.st_size);
+#endif
+
+	mIsUnmapped = true;
+	return true;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		Read
+//
+// Description:		Copies part of the file without going through the
+//					mapping.  Works whether or not the file is mapped.
+//
+// Input Arguments:
+//		offset		= const uint64_t&, [bytes from the start of the file]
+//		size		= const uint64_t&, [bytes]
+//
+// Output Arguments:
+//		contents	= std::string&
+//
+// Return Value:
+//		bool, false unless all of the bytes were read
+//
+//==========================================================================
+bool MappedFile::Read(const uint64_t &offset, const uint64_t &size,
+	std::string &contents) const
+{
+	contents.resize(static_cast<size_t>(size));
+	uint64_t done(0);
+	while (done < size)
+	{
+		// Large reads are split, as the count is 32 bits on Windows
+		const uint64_t request(std::min<uint64_t>(size - done, 1 << 30));
+#ifdef _WIN32
+		OVERLAPPED position = {};
+		position.Offset = static_cast<DWORD>((offset + done) & 0xFFFFFFFF);
+		position.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+		DWORD count;
+		if (!mFileHandle || !ReadFile(mFileHandle, &contents[static_cast<size_t>(done)],
+			static_cast<DWORD>(request), &count, &position) || count == 0)
+			return false;
+#else
+		const ssize_t count(pread(mFileDescriptor, &contents[static_cast<size_t>(done)],
+			static_cast<size_t>(request), static_cast<off_t>(offset + done)));
+		if (count < 0 && errno == EINTR)
+			continue;
+		else if (count <= 0)// Error, or the file ends early
+			return false;
+#endif
+		done += static_cast<uint64_t>(count);
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		Create
+//
+// Description:		Creates a file of the specified size and maps it for
+//					reading and writing.  An existing file is replaced.
+//
+// Input Arguments:
+//		fileName	= const std::string&, UTF-8 encoded
+//		size		= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool MappedFile::Create(const std::string &fileName, const uint64_t &size)
+{
+	Close();
+	if (size == 0)
+		return false;
+
+#ifdef _WIN32
+	HANDLE file(CreateFileW(ToWide(fileName).c_str(), GENERIC_READ | GENERIC_WRITE,
+		0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	mFileHandle = file;
+	mSize = size;
+
+	// Creating the mapping extends the file to the mapping's size
+	mMappingHandle = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+	if (mMappingHandle)
+		mData = static_cast<const char*>(MapViewOfFile(mMappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+#else
+	mFileDescriptor = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (mFileDescriptor < 0)
+		return false;
+
+	mSize = size;
+
+	// Reserve the space up front where we can; otherwise running out of disk
+	// space while writing through the mapping would raise SIGBUS
+#ifdef __linux__
+	const bool sized(posix_fallocate(mFileDescriptor, 0, static_cast<off_t>(size)) == 0);
+#else
+	const bool sized(ftruncate(mFileDescriptor, static_cast<off_t>(size)) == 0);
+#endif
+	if (sized)
+	{
+		void* address(mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFileDescriptor, 0));
+		if (address != MAP_FAILED)
+			mData = static_cast<const char*>(address);
+	}
+#endif
+
+	if (!mData)
+	{
+		Close();
+		return false;
+	}
+
+	mWritable = true;
+	return true;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		Close
+//
+// Description:		Unmaps the file.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (mData)
+		UnmapViewOfFile(mData);
+	if (mMappingHandle)
+		CloseHandle(mMappingHandle);
+	if (mFileHandle)
+		CloseHandle(mFileHandle);
+	mMappingHandle = nullptr;
+	mFileHandle = nullptr;
+#else
+	if (mData)
+		munmap(const_cast<char*>(mData), mSize);
+	if (mFileDescriptor >= 0)
+		close(mFileDescriptor);
+	mFileDescriptor = -1;
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+	mIsEmptyFile = false;
+	mWritable = false;
+	mIsUnmapped = false;
+}
+
+//==========================================================================
+// Class:			MappedFile
+// Function:		AdviseSequential
+//
+// Description:		Tells the OS to read ahead aggressively.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MappedFile::AdviseSequential() const
+{
+#ifndef _WIN32
+	if (mData)
+		madvise(const_cast<char*>(mData), mSize, MADV_SEQUENTIAL);
+#endif
+}
+
+#ifdef _WIN32
+//==========================================================================
+// Class:			MappedFile
+// Function:		ToWide
+//
+// Description:		Converts a UTF-8 string to UTF-16 for the Windows API.
+//
+// Input Arguments:
+//		s	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::wstring
+//
+//==========================================================================
+std::wstring MappedFile::ToWide(const std::string &s)
+{
+	const int wideLength(MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, nullptr, 0));
+	std::wstring wide(wideLength, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, &wide[0], wideLength);
+	return wide;
+}
+#endif
@@ -0,0 +1,81 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  mappedFile.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Read-only memory mapping of a file.
+// History:
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstdint>
+
+// View of a file's contents; read-only unless created with Create()
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string &fileName);// UTF-8 path
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other);
+	MappedFile& operator=(MappedFile&& other);
+
+	bool Open(const std::string &fileName);
+
+	// Opens the file without mapping it; its contents are copied out with
+	// Read() instead.  For files that may shrink while they are read, as
+	// touching a mapped page past the new end of the file raises SIGBUS.
+	bool OpenUnmapped(const std::string &fileName);
+
+	// Copies size bytes starting at offset; false if they can't all be read
+	// (because the file was truncated, for example)
+	bool Read(const uint64_t &offset, const uint64_t &size, std::string &contents) const;
+
+	// Creates (or replaces) a file of the specified size and maps it for
+	// writing.  What is written reaches the file as the OS sees fit (and by
+	// Close() at the latest), so the contents need not fit in memory.
+	bool Create(const std::string &fileName, const uint64_t &size);
+
+	void Close();
+
+	bool IsOpen() const { return mData != nullptr || mIsEmptyFile || mIsUnmapped; }
+	const char* GetData() const { return mData; }
+	char* GetWritableData() { return mWritable ? const_cast<char*>(mData) : nullptr; }
+	uint64_t GetSize() const { return mSize; }
+
+	// Hint to the OS that the file will be read front to back
+	void AdviseSequential() const;
+
+private:
+	const char* mData = nullptr;
+	uint64_t mSize = 0;
+	bool mIsEmptyFile = false;// Zero-length files can't be mapped, but are valid
+	bool mWritable = false;
+	bool mIsUnmapped = false;// Opened with OpenUnmapped()
+
+#ifdef _WIN32
+	void* mFileHandle = nullptr;
+	void* mMappingHandle = nullptr;
+
+	static std::wstring ToWide(const std::string &s);
+#else
+	int mFileDescriptor = -1;
+#endif
+
+	void Swap(MappedFile &other);
+};
+
+#endif// MAPPED_FILE_H_
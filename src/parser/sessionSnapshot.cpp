@@ -0,0 +1,780 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  sessionSnapshot.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Saved session:  the files that were open, their parsed columns,
+//				 the derived curves (with their results) and the view.  Columns
+//				 are stored as independently compressed chunks listed in a
+//				 directory at the end of the file, so any column can be read
+//				 (in parallel) without reading the others.
+// History:
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+
+// wxWidgets headers
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+
+// Local headers
+#include "parser/sessionSnapshot.h"
+#include "parser/columnCache.h"
+#include "utilities/threadPool.h"
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for SessionSnapshot class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const char SessionSnapshot::mMagic[4] = { 'D', 'P', 'S', 'S' };
+const uint32_t SessionSnapshot::mVersion(1);
+const uint64_t SessionSnapshot::mHeaderLength(sizeof(mMagic) + sizeof(mVersion) + sizeof(uint64_t));
+const size_t SessionSnapshot::mChunkValues(1 << 17);// 1 MB
+const unsigned int SessionSnapshot::mWriteBatchChunks(64);
+const int SessionSnapshot::mCompressionLevel(1);// Fastest; shuffling does most of the work
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		SessionSnapshot
+//
+// Description:		Constructor for SessionSnapshot class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SessionSnapshot::SessionSnapshot(ThreadPool &pool) : mPool(pool)
+{
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		AddColumn
+//
+// Description:		Adds a column to be written.
+//
+// Input Arguments:
+//		values	= const double*
+//		count	= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, index of the column
+//
+//==========================================================================
+uint32_t SessionSnapshot::AddColumn(const double* values, const uint64_t &count)
+{
+	mColumns.push_back({ values, count, 0 });
+	return static_cast<uint32_t>(mColumns.size() - 1);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Write
+//
+// Description:		Writes the snapshot.  The metadata comes first, then the
+//					chunks of each column in turn and finally the directory
+//					of chunks.  Chunks are compressed on the pool a batch at
+//					a time, so only one batch is held in memory.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionSnapshot::Write(const wxString &fileName)
+{
+	uint32_t chunkCount(1);
+	for (auto& column : mColumns)
+	{
+		column.firstChunk = chunkCount;
+		chunkCount += GetChunkCount(column.count);
+	}
+
+	std::ostringstream metadataStream;
+	WriteMetadata(metadataStream);
+	const std::string metadata(metadataStream.str());
+	std::string compressedMetadata;
+	if (!Compress(metadata.data(), metadata.size(), compressedMetadata))
+		return false;
+
+	// Column and first row of each chunk
+	std::vector<std::pair<uint32_t, uint64_t>> pieces;
+	uint32_t c;
+	for (c = 0; c < mColumns.size(); ++c)
+	{
+		uint64_t first;
+		for (first = 0; first < mColumns[c].count; first += mChunkValues)
+			pieces.push_back(std::make_pair(c, first));
+	}
+
+	const wxString tempFile(fileName + _T(".tmp"));
+	{
+		std::ofstream stream(tempFile.fn_str(), std::ios::binary | std::ios::trunc);
+		if (!stream.is_open())
+			return false;
+
+		uint64_t offset(0);// Of the directory; filled in at the end
+		stream.write(mMagic, sizeof(mMagic));
+		stream.write(reinterpret_cast<const char*>(&mVersion), sizeof(mVersion));
+		stream.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+
+		mChunks.assign(1, { mHeaderLength, compressedMetadata.size(), metadata.size() });
+		stream.write(compressedMetadata.data(), compressedMetadata.size());
+		offset = mHeaderLength + compressedMetadata.size();
+
+		std::vector<std::string> batch(mWriteBatchChunks);
+		std::atomic<bool> compressed(true);
+		size_t start;
+		for (start = 0; start < pieces.size() && stream && compressed; start += batch.size())
+		{
+			const size_t batchCount(std::min(batch.size(), pieces.size() - start));
+			mPool.ParallelFor(batchCount, 1, [this, &pieces, &batch, &compressed,
+				start](const size_t &begin, const size_t &end)
+			{
+				std::vector<char> bytes;
+				size_t i;
+				for (i = begin; i < end; ++i)
+				{
+					const Column& column(mColumns[pieces[start + i].first]);
+					const uint64_t first(pieces[start + i].second);
+					const size_t count(static_cast<size_t>(
+						std::min<uint64_t>(mChunkValues, column.count - first)));
+					bytes.resize(sizeof(double) * count);
+					Shuffle(column.values + first, count, bytes.data());
+					if (!Compress(bytes.data(), bytes.size(), batch[i]))
+						compressed = false;
+				}
+			});
+
+			size_t i;
+			for (i = 0; i < batchCount; ++i)
+			{
+				const Column& column(mColumns[pieces[start + i].first]);
+				const uint64_t count(std::min<uint64_t>(mChunkValues,
+					column.count - pieces[start + i].second));
+				mChunks.push_back({ offset, batch[i].size(), sizeof(double) * count });
+				stream.write(batch[i].data(), batch[i].size());
+				offset += batch[i].size();
+			}
+		}
+
+		const uint64_t directoryChunkCount(mChunks.size());
+		stream.write(reinterpret_cast<const char*>(&directoryChunkCount), sizeof(directoryChunkCount));
+		for (const auto& chunk : mChunks)
+		{
+			stream.write(reinterpret_cast<const char*>(&chunk.offset), sizeof(chunk.offset));
+			stream.write(reinterpret_cast<const char*>(&chunk.compressedLength), sizeof(chunk.compressedLength));
+			stream.write(reinterpret_cast<const char*>(&chunk.length), sizeof(chunk.length));
+		}
+
+		stream.seekp(sizeof(mMagic) + sizeof(mVersion));
+		stream.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+
+		if (!stream || !compressed || mChunks.size() != chunkCount)
+		{
+			stream.close();
+			wxRemoveFile(tempFile);
+			return false;
+		}
+	}
+
+	return wxRenameFile(tempFile, fileName, true);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		IsSnapshot
+//
+// Description:		Checks the start of a file to see if it is a snapshot.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool SessionSnapshot::IsSnapshot(const wxString &fileName)
+{
+	std::ifstream stream(fileName.fn_str(), std::ios::binary);
+	char magic[sizeof(mMagic)];
+	stream.read(magic, sizeof(magic));
+	return stream && memcmp(magic, mMagic, sizeof(mMagic)) == 0;
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Open
+//
+// Description:		Maps the snapshot and reads its directory and metadata.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionSnapshot::Open(const wxString &fileName)
+{
+	if (!mFile.Open(std::string(fileName.ToUTF8())) || !mFile.GetData() ||
+		mFile.GetSize() < mHeaderLength ||
+		memcmp(mFile.GetData(), mMagic, sizeof(mMagic)) != 0)
+		return false;
+
+	const char* data(mFile.GetData());
+	uint32_t version;
+	uint64_t directoryOffset;
+	uint64_t chunkCount;
+	memcpy(&version, data + sizeof(mMagic), sizeof(version));
+	memcpy(&directoryOffset, data + sizeof(mMagic) + sizeof(version), sizeof(directoryOffset));
+	const uint64_t entryLength(3 * sizeof(uint64_t));
+	if (version != mVersion || directoryOffset < mHeaderLength ||
+		directoryOffset > mFile.GetSize() - sizeof(chunkCount))
+		return false;
+
+	memcpy(&chunkCount, data + directoryOffset, sizeof(chunkCount));
+	if (chunkCount == 0 || chunkCount > (mFile.GetSize() - directoryOffset
+		- sizeof(chunkCount)) / entryLength)
+		return false;
+
+	mChunks.resize(static_cast<size_t>(chunkCount));
+	const char* entry(data + directoryOffset + sizeof(chunkCount));
+	for (auto& chunk : mChunks)
+	{
+		memcpy(&chunk.offset, entry, sizeof(chunk.offset));
+		memcpy(&chunk.compressedLength, entry + sizeof(uint64_t), sizeof(chunk.compressedLength));
+		memcpy(&chunk.length, entry + 2 * sizeof(uint64_t), sizeof(chunk.length));
+		entry += entryLength;
+
+		if (chunk.offset < mHeaderLength || chunk.offset > directoryOffset ||
+			chunk.compressedLength > directoryOffset - chunk.offset)
+			return false;
+	}
+
+	const uint64_t maxMetadataLength(1 << 30);
+	if (mChunks.front().length > maxMetadataLength)
+		return false;
+
+	std::string metadata(static_cast<size_t>(mChunks.front().length), '\0');
+	if (!metadata.empty() && !Decompress(mChunks.front(), &metadata[0]))
+		return false;
+
+	std::istringstream stream(metadata);
+	return ReadMetadata(stream) && IsValid(directoryOffset);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		ReadColumn
+//
+// Description:		Decompresses a column's chunks (in parallel).
+//
+// Input Arguments:
+//		column	= const uint32_t&
+//
+// Output Arguments:
+//		values	= double*, GetColumnSize(column) values
+//
+// Return Value:
+//		bool, false if the column is damaged
+//
+//==========================================================================
+bool SessionSnapshot::ReadColumn(const uint32_t &column, double* values) const
+{
+	const Column& c(mColumns[column]);
+	std::atomic<bool> decompressed(true);
+	mPool.ParallelFor(GetChunkCount(c.count), 1, [this, &c, &decompressed,
+		values](const size_t &begin, const size_t &end)
+	{
+		std::vector<char> bytes;
+		size_t i;
+		for (i = begin; i < end; ++i)
+		{
+			const Chunk& chunk(mChunks[c.firstChunk + i]);
+			bytes.resize(static_cast<size_t>(chunk.length));
+			if (!Decompress(chunk, bytes.data()))
+			{
+				decompressed = false;
+				continue;
+			}
+
+			Unshuffle(bytes.data(), bytes.size() / sizeof(double), values + i * mChunkValues);
+		}
+	});
+
+	return decompressed;
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		WriteMetadata
+//
+// Description:		Writes the column sizes, files, curves and view.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionSnapshot::WriteMetadata(std::ostream &stream) const
+{
+	auto writeCount([&stream](const size_t &count)
+	{
+		const uint32_t value(static_cast<uint32_t>(count));
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	});
+
+	writeCount(mColumns.size());
+	for (const auto& column : mColumns)
+		stream.write(reinterpret_cast<const char*>(&column.count), sizeof(column.count));
+
+	writeCount(files.size());
+	for (const auto& file : files)
+	{
+		ColumnCache::WriteMetadata(stream, file.fileName, 0, file.state);
+		WriteMask(stream, file.mask);
+		stream.write(reinterpret_cast<const char*>(&file.time), sizeof(file.time));
+		writeCount(file.curves.size());
+		for (const auto& curve : file.curves)
+		{
+			ColumnCache::WriteString(stream, curve.name);
+			stream.write(reinterpret_cast<const char*>(&curve.plotIndex), sizeof(curve.plotIndex));
+			stream.write(reinterpret_cast<const char*>(&curve.column), sizeof(curve.column));
+			stream.write(reinterpret_cast<const char*>(&curve.values), sizeof(curve.values));
+			ColumnCache::WriteString(stream, curve.expression);
+			stream.write(reinterpret_cast<const char*>(&curve.alignment), sizeof(curve.alignment));
+
+			writeCount(curve.operands.size());
+			for (const auto& operand : curve.operands)
+			{
+				stream.write(reinterpret_cast<const char*>(&operand.reference), sizeof(operand.reference));
+				stream.write(reinterpret_cast<const char*>(&operand.file), sizeof(operand.file));
+				stream.write(reinterpret_cast<const char*>(&operand.curve), sizeof(operand.curve));
+			}
+		}
+	}
+
+	writeCount(referencedFiles.size());
+	for (const auto& file : referencedFiles)
+	{
+		ColumnCache::WriteString(stream, file.fileName);
+		WriteMask(stream, file.mask);
+	}
+
+	writeCount(interfaceFiles.size());
+	for (const auto& fileName : interfaceFiles)
+		ColumnCache::WriteString(stream, fileName);
+
+	stream.write(reinterpret_cast<const char*>(&view), sizeof(view));
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		ReadMetadata
+//
+// Description:		Reads what WriteMetadata() wrote.  The columns' chunks
+//					follow one another, starting after the metadata.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionSnapshot::ReadMetadata(std::istream &stream)
+{
+	const uint32_t maxCount(1 << 24);
+	auto readCount([&stream, &maxCount](uint32_t &count)
+	{
+		stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+		return stream && count <= maxCount;
+	});
+
+	uint32_t count;
+	if (!readCount(count))
+		return false;
+
+	mColumns.resize(count);
+	uint64_t firstChunk(1);
+	for (auto& column : mColumns)
+	{
+		stream.read(reinterpret_cast<char*>(&column.count), sizeof(column.count));
+		if (!stream || firstChunk > mChunks.size())
+			return false;
+
+		column.values = nullptr;
+		column.firstChunk = static_cast<uint32_t>(firstChunk);
+		firstChunk += GetChunkCount(column.count);
+	}
+
+	if (firstChunk != mChunks.size() || !readCount(count))
+		return false;
+
+	files.resize(count);
+	for (auto& file : files)
+	{
+		uint64_t formatStamp;
+		if (!ColumnCache::ReadMetadata(stream, file.fileName, formatStamp, file.state) ||
+			!ReadMask(stream, file.mask))
+			return false;
+
+		stream.read(reinterpret_cast<char*>(&file.time), sizeof(file.time));
+		if (!readCount(count))
+			return false;
+
+		file.curves.resize(count);
+		for (auto& curve : file.curves)
+		{
+			if (!ColumnCache::ReadString(stream, curve.name))
+				return false;
+
+			stream.read(reinterpret_cast<char*>(&curve.plotIndex), sizeof(curve.plotIndex));
+			stream.read(reinterpret_cast<char*>(&curve.column), sizeof(curve.column));
+			stream.read(reinterpret_cast<char*>(&curve.values), sizeof(curve.values));
+			if (!ColumnCache::ReadString(stream, curve.expression))
+				return false;
+
+			stream.read(reinterpret_cast<char*>(&curve.alignment), sizeof(curve.alignment));
+			if (!readCount(count))
+				return false;
+
+			curve.operands.resize(count);
+			for (auto& operand : curve.operands)
+			{
+				stream.read(reinterpret_cast<char*>(&operand.reference), sizeof(operand.reference));
+				stream.read(reinterpret_cast<char*>(&operand.file), sizeof(operand.file));
+				stream.read(reinterpret_cast<char*>(&operand.curve), sizeof(operand.curve));
+			}
+		}
+	}
+
+	if (!readCount(count))
+		return false;
+
+	referencedFiles.resize(count);
+	for (auto& file : referencedFiles)
+	{
+		if (!ColumnCache::ReadString(stream, file.fileName) || !ReadMask(stream, file.mask))
+			return false;
+	}
+
+	if (!readCount(count))
+		return false;
+
+	interfaceFiles.resize(count);
+	for (auto& fileName : interfaceFiles)
+	{
+		if (!ColumnCache::ReadString(stream, fileName))
+			return false;
+	}
+
+	stream.read(reinterpret_cast<char*>(&view), sizeof(view));
+	return static_cast<bool>(stream);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		WriteMask
+//
+// Description:		Writes a column mask, one byte per column.
+//
+// Input Arguments:
+//		stream	= std::ostream&
+//		mask	= const DelimitedFileLoader::ColumnMask&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionSnapshot::WriteMask(std::ostream &stream, const DelimitedFileLoader::ColumnMask &mask)
+{
+	const uint32_t count(static_cast<uint32_t>(mask.size()));
+	stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	for (const auto& selected : mask)
+		stream.put(selected ? 1 : 0);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		ReadMask
+//
+// Description:		Reads what WriteMask() wrote.
+//
+// Input Arguments:
+//		stream	= std::istream&
+//
+// Output Arguments:
+//		mask	= DelimitedFileLoader::ColumnMask&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionSnapshot::ReadMask(std::istream &stream, DelimitedFileLoader::ColumnMask &mask)
+{
+	const uint32_t maxCount(1 << 24);
+	uint32_t count;
+	stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!stream || count > maxCount)
+		return false;
+
+	mask.resize(count);
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		mask[i] = stream.get() != 0;
+
+	return static_cast<bool>(stream);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		IsValid
+//
+// Description:		Checks that everything read from the metadata refers to
+//					something which exists, so the snapshot can be used
+//					without further checks.
+//
+// Input Arguments:
+//		directoryOffset	= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool SessionSnapshot::IsValid(const uint64_t &directoryOffset) const
+{
+	const uint32_t maxReference(1 << 20);
+
+	for (const auto& column : mColumns)
+	{
+		const uint32_t chunkCount(GetChunkCount(column.count));
+		uint32_t i;
+		for (i = 0; i < chunkCount; ++i)
+		{
+			const uint64_t count(std::min<uint64_t>(mChunkValues, column.count - i * mChunkValues));
+			if (mChunks[column.firstChunk + i].length != sizeof(double) * count)
+				return false;
+		}
+	}
+
+	for (const auto& file : files)
+	{
+		if (file.time >= mColumns.size())
+			return false;
+
+		for (const auto& curve : file.curves)
+		{
+			if (curve.values >= mColumns.size() ||
+				mColumns[curve.values].count != mColumns[file.time].count)
+				return false;
+
+			for (const auto& operand : curve.operands)
+			{
+				if (operand.reference == 0 || operand.reference > maxReference ||
+					operand.file >= files.size() ||
+					operand.curve >= files[operand.file].curves.size())
+					return false;
+			}
+		}
+	}
+
+	return mChunks.front().offset + mChunks.front().compressedLength <= directoryOffset;
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		GetChunkCount
+//
+// Description:		Returns the number of chunks a column is stored in.
+//
+// Input Arguments:
+//		count	= const uint64_t&, number of values
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t
+//
+//==========================================================================
+uint32_t SessionSnapshot::GetChunkCount(const uint64_t &count)
+{
+	return static_cast<uint32_t>((count + mChunkValues - 1) / mChunkValues);
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Shuffle
+//
+// Description:		Stores the first byte of every value, then the second
+//					byte of every value, etc.  Neighbouring samples usually
+//					share their sign, exponent and leading mantissa bits.
+//
+// Input Arguments:
+//		values	= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		bytes	= char*, sizeof(double) * count bytes
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionSnapshot::Shuffle(const double* values, const size_t &count, char* bytes)
+{
+	const char* in(reinterpret_cast<const char*>(values));
+	size_t b, i;
+	for (b = 0; b < sizeof(double); ++b)
+	{
+		char* out(bytes + b * count);
+		for (i = 0; i < count; ++i)
+			out[i] = in[i * sizeof(double) + b];
+	}
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Unshuffle
+//
+// Description:		Undoes Shuffle().
+//
+// Input Arguments:
+//		bytes	= const char*, sizeof(double) * count bytes
+//		count	= const size_t&
+//
+// Output Arguments:
+//		values	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SessionSnapshot::Unshuffle(const char* bytes, const size_t &count, double* values)
+{
+	char* out(reinterpret_cast<char*>(values));
+	size_t b, i;
+	for (b = 0; b < sizeof(double); ++b)
+	{
+		const char* in(bytes + b * count);
+		for (i = 0; i < count; ++i)
+			out[i * sizeof(double) + b] = in[i];
+	}
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Compress
+//
+// Description:		Compresses a block of data with zlib.
+//
+// Input Arguments:
+//		data		= const char*
+//		length		= const size_t&
+//
+// Output Arguments:
+//		compressed	= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SessionSnapshot::Compress(const char* data, const size_t &length, std::string &compressed)
+{
+	wxMemoryOutputStream memory;
+	{
+		wxZlibOutputStream zlib(memory, mCompressionLevel, wxZLIB_ZLIB);
+		zlib.Write(data, length);
+		if (zlib.LastWrite() != length || !zlib.Close())
+			return false;
+	}
+
+	compressed.resize(static_cast<size_t>(memory.GetLength()));
+	return !compressed.empty() &&
+		memory.CopyTo(&compressed[0], compressed.size()) == compressed.size();
+}
+
+//==========================================================================
+// Class:			SessionSnapshot
+// Function:		Decompress
+//
+// Description:		Decompresses a chunk straight out of the mapping.
+//
+// Input Arguments:
+//		chunk	= const Chunk&
+//
+// Output Arguments:
+//		data	= char*, chunk.length bytes
+//
+// Return Value:
+//		bool, false if the chunk is damaged
+//
+//==========================================================================
+bool SessionSnapshot::Decompress(const Chunk &chunk, char* data) const
+{
+	wxMemoryInputStream memory(mFile.GetData() + chunk.offset,
+		static_cast<size_t>(chunk.compressedLength));
+	wxZlibInputStream zlib(memory, wxZLIB_ZLIB);
+	zlib.Read(data, static_cast<size_t>(chunk.length));
+	return zlib.LastRead() == chunk.length;
+}
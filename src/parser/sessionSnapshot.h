@@ -0,0 +1,149 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  sessionSnapshot.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Saved session:  the files that were open, their parsed columns,
+//				 the derived curves (with their results) and the view.  Columns
+//				 are stored as independently compressed chunks listed in a
+//				 directory at the end of the file, so any column can be read
+//				 (in parallel) without reading the others.
+// History:
+
+#ifndef SESSION_SNAPSHOT_H_
+#define SESSION_SNAPSHOT_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iosfwd>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "parser/delimitedFileLoader.h"
+#include "parser/mappedFile.h"
+
+// Local forward declarations
+class ThreadPool;
+
+// Reads and writes session snapshot files
+class SessionSnapshot
+{
+public:
+	explicit SessionSnapshot(ThreadPool &pool);
+
+	struct View
+	{
+		double xMin = 0.0;
+		double xMax = 0.0;
+		double leftYMin = 0.0;
+		double leftYMax = 0.0;
+		double rightYMin = 0.0;
+		double rightYMax = 0.0;
+	};
+
+	// Curve [reference] of a derived curve's expression
+	struct Operand
+	{
+		uint32_t reference;
+		uint32_t file;// Index in files
+		uint32_t curve;// Index in that file's curves
+	};
+
+	struct Curve
+	{
+		std::string name;// UTF-8
+		uint32_t plotIndex;// Position in the plot list
+		uint32_t column;// Data column (time column not counted); derived curves have none
+		uint32_t values;// Stored column
+		std::string expression;// Empty unless derived
+		uint8_t alignment = 0;// Resampling method for operands from other files
+		std::vector<Operand> operands;
+	};
+
+	struct File
+	{
+		std::string fileName;// UTF-8; empty for pasted data
+		DelimitedFileLoader::FileState state;
+		DelimitedFileLoader::ColumnMask mask;
+		uint32_t time;// Stored column
+		std::vector<Curve> curves;
+	};
+
+	std::vector<File> files;
+	std::vector<File> referencedFiles;// To be loaded again; only the name and mask are kept
+	std::vector<std::string> interfaceFiles;// Loaded by LibPlot2D
+	View view;
+
+	// Columns must remain valid until Write() returns.  Returns the index
+	// by which curves and files refer to the column.
+	uint32_t AddColumn(const double* values, const uint64_t &count);
+
+	// Written under a temporary name and renamed, like ColumnCache
+	bool Write(const wxString &fileName);
+
+	static bool IsSnapshot(const wxString &fileName);
+
+	// Maps the file and reads everything except the columns, which are read
+	// (decompressed) on request.  Fails if the file is damaged.
+	bool Open(const wxString &fileName);
+	uint64_t GetColumnSize(const uint32_t &column) const { return mColumns[column].count; }
+	bool ReadColumn(const uint32_t &column, double* values) const;
+
+private:
+	static const char mMagic[4];
+	static const uint32_t mVersion;
+	static const uint64_t mHeaderLength;
+	static const size_t mChunkValues;
+	static const unsigned int mWriteBatchChunks;
+	static const int mCompressionLevel;
+
+	ThreadPool &mPool;
+	MappedFile mFile;
+
+	struct Chunk
+	{
+		uint64_t offset;
+		uint64_t compressedLength;
+		uint64_t length;// [bytes]
+	};
+
+	std::vector<Chunk> mChunks;// The first holds the metadata
+
+	struct Column
+	{
+		const double* values;// Only while writing
+		uint64_t count;
+		uint32_t firstChunk;
+	};
+
+	std::vector<Column> mColumns;
+
+	void WriteMetadata(std::ostream &stream) const;
+	bool ReadMetadata(std::istream &stream);
+	bool IsValid(const uint64_t &directoryOffset) const;
+
+	static void WriteMask(std::ostream &stream, const DelimitedFileLoader::ColumnMask &mask);
+	static bool ReadMask(std::istream &stream, DelimitedFileLoader::ColumnMask &mask);
+	static uint32_t GetChunkCount(const uint64_t &count);
+
+	// Bytes of the values are grouped by significance before compression,
+	// which makes runs of similar values much more compressible
+	static void Shuffle(const double* values, const size_t &count, char* bytes);
+	static void Unshuffle(const char* bytes, const size_t &count, double* values);
+
+	static bool Compress(const char* data, const size_t &length, std::string &compressed);
+	bool Decompress(const Chunk &chunk, char* data) const;
+};
+
+#endif// SESSION_SNAPSHOT_H_
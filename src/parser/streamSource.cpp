@@ -0,0 +1,456 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  streamSource.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Reads delimited rows from a growing file, FIFO or UNIX domain
+//				 socket on a producer thread and passes them to the GUI thread
+//				 through a lock-free ring buffer.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Platform headers
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// wxWidgets headers
+#include <wx/crt.h>
+
+// Local headers
+#include "parser/streamSource.h"
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for StreamSource class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t StreamSource::mReadSize(1 << 16);
+const size_t StreamSource::mBufferCapacity(1 << 22);// Over a second at 100 kHz x 32 channels
+const size_t StreamSource::mMaxHeaderLength(1 << 20);
+const unsigned int StreamSource::mPollInterval(20);
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		StreamSource
+//
+// Description:		Constructor for StreamSource class.
+//
+// Input Arguments:
+//		path	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+StreamSource::StreamSource(const wxString &path) : mPath(path),
+	mBuffer(mBufferCapacity), mStopping(false), mReady(false), mFinished(false)
+{
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		~StreamSource
+//
+// Description:		Destructor for StreamSource class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+StreamSource::~StreamSource()
+{
+	Stop();
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Start
+//
+// Description:		Opens the source and starts the producer thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool StreamSource::Start()
+{
+	if (mThread.joinable() || !Open())
+		return false;
+
+	mThread = std::thread(&StreamSource::Run, this);
+	return true;
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Stop
+//
+// Description:		Stops the producer thread and closes the source.  Rows
+//					that have already been pushed can still be read.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void StreamSource::Stop()
+{
+	mStopping = true;
+	if (mThread.joinable())
+		mThread.join();
+	Close();
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Open
+//
+// Description:		Opens the path.  FIFOs and sockets are only supported
+//					on POSIX systems; anything else is read as a file which
+//					is expected to grow.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool StreamSource::Open()
+{
+#ifndef _WIN32
+	const std::string path(mPath.ToUTF8());
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+		return false;
+
+	if (S_ISFIFO(info.st_mode))
+	{
+		// Non-blocking so that waiting for a writer can be interrupted
+		mDescriptor = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+		return mDescriptor >= 0;
+	}
+	else if (S_ISSOCK(info.st_mode))
+	{
+		sockaddr_un address;
+		memset(&address, 0, sizeof(address));
+		if (path.size() >= sizeof(address.sun_path))
+			return false;
+
+		address.sun_family = AF_UNIX;
+		memcpy(address.sun_path, path.c_str(), path.size());
+
+		mDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (mDescriptor < 0)
+			return false;
+
+		if (connect(mDescriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			Close();
+			return false;
+		}
+
+		mIsSocket = true;
+		return true;
+	}
+#endif
+
+	mFile = wxFopen(mPath, "rb");
+	return mFile != nullptr;
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Close
+//
+// Description:		Closes the source.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void StreamSource::Close()
+{
+	if (mFile)
+	{
+		fclose(mFile);
+		mFile = nullptr;
+	}
+
+#ifndef _WIN32
+	if (mDescriptor >= 0)
+	{
+		close(mDescriptor);
+		mDescriptor = -1;
+	}
+#endif
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		ReadSome
+//
+// Description:		Reads whatever is available from the source, waiting up
+//					to one poll interval for more to arrive.
+//
+// Input Arguments:
+//		size		= const size_t&
+//
+// Output Arguments:
+//		buffer		= char*
+//		endOfStream	= bool&, set true if no more data will ever arrive
+//
+// Return Value:
+//		size_t, number of bytes read
+//
+//==========================================================================
+size_t StreamSource::ReadSome(char* buffer, const size_t &size, bool &endOfStream)
+{
+	if (mFile)
+	{
+		const size_t bytesRead(fread(buffer, 1, size, mFile));
+		if (bytesRead == 0)
+		{
+			// Reached the current end of the file; wait for it to grow
+			clearerr(mFile);
+			std::this_thread::sleep_for(std::chrono::milliseconds(mPollInterval));
+		}
+
+		return bytesRead;
+	}
+
+#ifndef _WIN32
+	pollfd request;
+	request.fd = mDescriptor;
+	request.events = POLLIN;
+	if (poll(&request, 1, mPollInterval) <= 0)
+		return 0;
+
+	const ssize_t bytesRead(read(mDescriptor, buffer, size));
+	if (bytesRead > 0)
+		return static_cast<size_t>(bytesRead);
+	else if (bytesRead == 0 && mIsSocket)
+		endOfStream = true;
+	else if (bytesRead == 0)
+	{
+		// FIFO with no writer; keep waiting in case another one connects
+		std::this_thread::sleep_for(std::chrono::milliseconds(mPollInterval));
+	}
+	else if (errno != EAGAIN && errno != EINTR)
+		endOfStream = true;
+#else
+	endOfStream = true;
+#endif
+
+	return 0;
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		Run
+//
+// Description:		Producer thread.  Collects bytes until the layout can
+//					be detected, then parses each batch of complete rows and
+//					pushes them into the ring buffer.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void StreamSource::Run()
+{
+	std::vector<char> block(mReadSize);
+	std::vector<char> pending;
+	std::vector<std::vector<double>> columns;
+	std::vector<double> rows;
+
+	bool endOfStream(false);
+	while (!mStopping && !endOfStream)
+	{
+		const size_t bytesRead(ReadSome(block.data(), block.size(), endOfStream));
+		pending.insert(pending.end(), block.begin(), block.begin() + bytesRead);
+
+		size_t complete(pending.size());
+		while (complete > 0 && pending[complete - 1] != '\n')
+			--complete;
+
+		if (complete == 0)
+			continue;
+
+		size_t begin(0);
+		if (!IsReady())
+		{
+			if (!DelimitedParser::DetectLayout(pending.data(), complete, mLayout))
+			{
+				if (pending.size() > mMaxHeaderLength)
+					break;// Not delimited numeric data
+				continue;
+			}
+
+			begin = mLayout.dataStart;
+			mReady.store(true, std::memory_order_release);
+		}
+
+		PushRows(pending.data() + begin, pending.data() + complete, columns, rows);
+		pending.erase(pending.begin(), pending.begin() + complete);
+	}
+
+	// A socket may close without ending its last row
+	if (endOfStream && IsReady() && !pending.empty())
+		PushRows(pending.data(), pending.data() + pending.size(), columns, rows);
+
+	mFinished.store(true, std::memory_order_release);
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		PushRows
+//
+// Description:		Parses the rows in [begin, end) and pushes them into the
+//					ring buffer, waiting for the consumer to make room if
+//					necessary.  Each push holds whole rows only.
+//
+// Input Arguments:
+//		begin	= const char*
+//		end		= const char*
+//		columns	= std::vector<std::vector<double>>&, scratch space
+//		rows	= std::vector<double>&, scratch space
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void StreamSource::PushRows(const char* begin, const char* end,
+	std::vector<std::vector<double>> &columns, std::vector<double> &rows)
+{
+	const size_t rowCount(DelimitedParser::CountRows(begin, end));
+	if (rowCount == 0)
+		return;
+
+	const unsigned int columnCount(mLayout.columnCount);
+	columns.resize(columnCount);
+	std::vector<double*> destinations(columnCount);
+	unsigned int c;
+	for (c = 0; c < columnCount; ++c)
+	{
+		columns[c].resize(rowCount);
+		destinations[c] = columns[c].data();
+	}
+
+	DelimitedParser::ParseRows(begin, end, mLayout, destinations.data());
+
+	rows.resize(rowCount * columnCount);
+	size_t r;
+	for (r = 0; r < rowCount; ++r)
+	{
+		for (c = 0; c < columnCount; ++c)
+			rows[r * columnCount + c] = columns[c][r];
+	}
+
+	const size_t batchRows(std::max<size_t>(1, mBuffer.GetCapacity() / 2 / columnCount));
+	for (r = 0; r < rowCount && !mStopping; )
+	{
+		const size_t count(std::min(batchRows, rowCount - r));
+		if (mBuffer.TryPush(rows.data() + r * columnCount, count * columnCount))
+			r += count;
+		else
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+//==========================================================================
+// Class:			StreamSource
+// Function:		ReadRows
+//
+// Description:		Takes rows out of the ring buffer.  Called from the GUI
+//					thread only.
+//
+// Input Arguments:
+//		maxRows	= const size_t&
+//
+// Output Arguments:
+//		rows	= std::vector<double>&, grown if necessary; only the first
+//				  (returned count) rows are valid
+//
+// Return Value:
+//		size_t, number of rows read
+//
+//==========================================================================
+size_t StreamSource::ReadRows(std::vector<double> &rows, const size_t &maxRows)
+{
+	if (!IsReady())
+		return 0;
+
+	const size_t columnCount(mLayout.columnCount);
+	if (rows.size() < maxRows * columnCount)
+		rows.resize(maxRows * columnCount);
+
+	return mBuffer.Pop(rows.data(), maxRows * columnCount) / columnCount;
+}
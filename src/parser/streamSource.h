@@ -0,0 +1,91 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  streamSource.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Reads delimited rows from a growing file, FIFO or UNIX domain
+//				 socket on a producer thread and passes them to the GUI thread
+//				 through a lock-free ring buffer.
+// History:
+
+#ifndef STREAM_SOURCE_H_
+#define STREAM_SOURCE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+
+// wxWidgets headers
+#include <wx/wx.h>
+
+// Local headers
+#include "parser/delimitedParser.h"
+#include "utilities/spscRingBuffer.h"
+
+// Live source of delimited rows
+class StreamSource
+{
+public:
+	explicit StreamSource(const wxString &path);
+	~StreamSource();
+
+	StreamSource(const StreamSource&) = delete;
+	StreamSource& operator=(const StreamSource&) = delete;
+
+	// Returns false if the path could not be opened
+	bool Start();
+	void Stop();
+
+	const wxString& GetPath() const { return mPath; }
+
+	// The layout is valid once this returns true
+	bool IsReady() const { return mReady.load(std::memory_order_acquire); }
+	const DelimitedParser::Layout& GetLayout() const { return mLayout; }
+
+	// True once the producer has stopped (end of stream, or the data
+	// turned out not to be delimited numbers)
+	bool IsFinished() const { return mFinished.load(std::memory_order_acquire); }
+
+	// Copies up to maxRows complete rows to the start of rows, stored one
+	// after another with the time column first.  Returns the row count.
+	size_t ReadRows(std::vector<double> &rows, const size_t &maxRows);
+
+private:
+	static const size_t mReadSize;
+	static const size_t mBufferCapacity;
+	static const size_t mMaxHeaderLength;
+	static const unsigned int mPollInterval;// [msec]
+
+	const wxString mPath;
+	DelimitedParser::Layout mLayout;
+	SpscRingBuffer<double> mBuffer;
+
+	std::thread mThread;
+	std::atomic<bool> mStopping;
+	std::atomic<bool> mReady;
+	std::atomic<bool> mFinished;
+
+	// Exactly one of these is open while streaming
+	FILE* mFile = nullptr;// Regular files
+	int mDescriptor = -1;// FIFOs and sockets
+	bool mIsSocket = false;
+
+	bool Open();
+	void Close();
+	size_t ReadSome(char* buffer, const size_t &size, bool &endOfStream);
+
+	void Run();
+	void PushRows(const char* begin, const char* end,
+		std::vector<std::vector<double>> &columns, std::vector<double> &rows);
+};
+
+#endif// STREAM_SOURCE_H_
@@ -19,6 +19,8 @@
 // Local headers
 #include "plotterApp.h"
 #include "mainFrame.h"
+#include "batchProcessor.h"
+#include "utilities/perfMonitor.h"
 
 // Implement the application (have wxWidgets set up the appropriate entry points, etc.)
 IMPLEMENT_APP(DataPlotterApp);
@@ -44,6 +46,57 @@ const wxString DataPlotterApp::dataPlotterName = _T("DataPlotterApplication");
 const wxString DataPlotterApp::creator = _T("Kerry Loux");
 // gitHash and versionString are defined in gitHash.cpp, which is automatically generated during the build
 
+//==========================================================================
+// Class:			DataPlotterApp
+// Function:		Initialize
+//
+// Description:		Initializes wxWidgets.  Batch mode skips the GUI toolkit,
+//					which would fail without a display.
+//
+// Input Arguments:
+//		argc	= int&
+//		argv	= wxChar**
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool = true for success
+//
+//==========================================================================
+bool DataPlotterApp::Initialize(int &argc, wxChar **argv)
+{
+	mBatchMode = BatchProcessor::IsBatchMode(argc, argv);
+	if (mBatchMode)
+		return wxAppConsole::Initialize(argc, argv);
+
+	return wxApp::Initialize(argc, argv);
+}
+
+//==========================================================================
+// Class:			DataPlotterApp
+// Function:		CleanUp
+//
+// Description:		Undoes whichever initialization was done.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DataPlotterApp::CleanUp()
+{
+	if (mBatchMode)
+		wxAppConsole::CleanUp();
+	else
+		wxApp::CleanUp();
+}
+
 //==========================================================================
 // Class:			DataPlotterApp
 // Function:		OnInit
@@ -66,6 +119,12 @@ bool DataPlotterApp::OnInit()
 	SetAppName(dataPlotterName);
 	SetVendorName(creator);
 
+	if (mBatchMode)
+		return true;
+
+	// Start-up times are measured from here
+	PerfMonitor::GetSharedMonitor();
+
 	// Create the MainFrame object - this is the parent for all other objects
 	mainFrame = new MainFrame();
 
@@ -81,3 +140,29 @@ bool DataPlotterApp::OnInit()
 
 	return true;
 }
+
+//==========================================================================
+// Class:			DataPlotterApp
+// Function:		OnRun
+//
+// Description:		Runs the event loop, or in batch mode, processes the
+//					files named on the command line.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int = exit code for the process
+//
+//==========================================================================
+int DataPlotterApp::OnRun()
+{
+	if (!mBatchMode)
+		return wxApp::OnRun();
+
+	BatchProcessor processor;
+	return processor.Run(argc, argv);
+}
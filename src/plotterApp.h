@@ -26,8 +26,14 @@ class MainFrame;
 class DataPlotterApp : public wxApp
 {
 public:
+	// In batch mode (see BatchProcessor) only the non-GUI parts of wxWidgets
+	// are initialized, so no display is required
+	bool Initialize(int &argc, wxChar **argv);
+	void CleanUp();
+
 	// Initialization function
 	bool OnInit();
+	int OnRun();
 
 	// The name of the application
 	static const wxString dataPlotterTitle;// As displayed
@@ -39,6 +45,8 @@ public:
 private:
 	// The main class for the application - this object is the parent for all other objects
 	MainFrame *mainFrame = nullptr;
+
+	bool mBatchMode = false;
 };
 
 // Declare the application object (have wxWidgets create the wxGetApp() function)
@@ -0,0 +1,632 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  decimationPyramid.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Multi-resolution min/max summary of a curve, used to draw very
+//				 long curves with roughly one bucket per pixel column.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <limits>
+#include <atomic>
+
+// Local headers
+#include "renderer/decimationPyramid.h"
+#include "utilities/threadPool.h"
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for DecimationPyramid class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t DecimationPyramid::defaultBaseBucketSize(16);
+const size_t DecimationPyramid::mMinBucketSize(16);
+const size_t DecimationPyramid::mMinViewBucketCount(256);
+const unsigned int DecimationPyramid::mEmptyBucket(std::numeric_limits<unsigned int>::max());
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		DecimationPyramid
+//
+// Description:		Constructor for DecimationPyramid class.
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count			= const size_t&
+//		pool			= ThreadPool&
+//		baseBucketSize	= const size_t&, points per bucket in the finest level
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DecimationPyramid::DecimationPyramid(const double* x, const double* y,
+	const size_t &count, ThreadPool &pool, const size_t &baseBucketSize)
+	: mX(x), mY(y), mCount(count),
+	mBaseBucketSize(std::max(baseBucketSize, mMinBucketSize))
+{
+	Build(0, pool);
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		Update
+//
+// Description:		Points the pyramid at new data and recomputes the
+//					buckets that cover changed points.  Used when rows are
+//					appended to a curve, which leaves the earlier buckets
+//					untouched.
+//
+// Input Arguments:
+//		x					= const double*
+//		y					= const double*
+//		count				= const size_t&
+//		firstChangedIndex	= const size_t&
+//		pool				= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::Update(const double* x, const double* y,
+	const size_t &count, const size_t &firstChangedIndex, ThreadPool &pool)
+{
+	mX = x;
+	mY = y;
+	mCount = count;
+	Build(std::min(firstChangedIndex, count), pool);
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		IsMonotonic
+//
+// Description:		Checks that x is non-decreasing and not NaN.  Blocks are
+//					checked in parallel.
+//
+// Input Arguments:
+//		x		= const double*
+//		count	= const size_t&
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool DecimationPyramid::IsMonotonic(const double* x, const size_t &count, ThreadPool &pool)
+{
+	if (count == 0)
+		return true;
+	else if (x[0] != x[0])// NaN
+		return false;
+
+	std::atomic<bool> monotonic(true);
+	pool.ParallelFor(count - 1, 1 << 16, [x, &monotonic](const size_t &begin, const size_t &end)
+	{
+		if (!monotonic)
+			return;
+
+		size_t i;
+		for (i = begin + 1; i <= end; ++i)
+		{
+			if (!(x[i] >= x[i - 1]))// Also false for NaN
+			{
+				monotonic = false;
+				return;
+			}
+		}
+	});
+
+	return monotonic;
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		Build
+//
+// Description:		Computes the levels of the pyramid.  The base level is
+//					computed from the data; each level above is computed by
+//					merging pairs of buckets from the level below.  Buckets
+//					entirely before firstChangedIndex are kept as they are.
+//
+// Input Arguments:
+//		firstChangedIndex	= const size_t&
+//		pool				= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::Build(const size_t &firstChangedIndex, ThreadPool &pool)
+{
+	if (mCount == 0)
+	{
+		mLevels.clear();
+		return;
+	}
+
+	const size_t parallelBlock(4096);
+
+	if (mLevels.empty())
+		mLevels.emplace_back();
+
+	size_t firstBucket(firstChangedIndex / mBaseBucketSize);
+	std::vector<Bucket>& base(mLevels.front());
+	base.resize((mCount + mBaseBucketSize - 1) / mBaseBucketSize);
+	pool.ParallelFor(base.size() - firstBucket, parallelBlock,
+		[this, &base, firstBucket](const size_t &begin, const size_t &end)
+	{
+		size_t b;
+		for (b = firstBucket + begin; b < firstBucket + end; ++b)
+		{
+			Bucket bucket{ 0.0, 0.0, mEmptyBucket, mEmptyBucket };
+			const size_t last(std::min(mCount, (b + 1) * mBaseBucketSize));
+			size_t i;
+			for (i = b * mBaseBucketSize; i < last; ++i)
+			{
+				const double value(mY[i]);
+				if (value != value)// NaN
+					continue;
+
+				if (bucket.minIndex == mEmptyBucket || value < bucket.minY)
+				{
+					bucket.minY = value;
+					bucket.minIndex = static_cast<unsigned int>(i);
+				}
+
+				if (bucket.maxIndex == mEmptyBucket || value > bucket.maxY)
+				{
+					bucket.maxY = value;
+					bucket.maxIndex = static_cast<unsigned int>(i);
+				}
+			}
+
+			base[b] = bucket;
+		}
+	});
+
+	unsigned int k;
+	for (k = 1; mLevels[k - 1].size() > 1; ++k)
+	{
+		if (k == mLevels.size())
+			mLevels.emplace_back();
+
+		const std::vector<Bucket>& below(mLevels[k - 1]);
+		std::vector<Bucket>& level(mLevels[k]);
+		firstBucket /= 2;
+		level.resize((below.size() + 1) / 2);
+		pool.ParallelFor(level.size() - firstBucket, parallelBlock,
+			[&below, &level, firstBucket](const size_t &begin, const size_t &end)
+		{
+			size_t b;
+			for (b = firstBucket + begin; b < firstBucket + end; ++b)
+			{
+				level[b] = below[2 * b];
+				if (2 * b + 1 < below.size())
+					Merge(below[2 * b + 1], level[b]);
+			}
+		});
+	}
+
+	mLevels.resize(k);
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		Merge
+//
+// Description:		Combines bucket a into target.
+//
+// Input Arguments:
+//		a		= const Bucket&
+//
+// Output Arguments:
+//		target	= Bucket&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::Merge(const Bucket &a, Bucket &target)
+{
+	if (a.minIndex == mEmptyBucket)
+		return;
+
+	if (target.minIndex == mEmptyBucket || a.minY < target.minY)
+	{
+		target.minY = a.minY;
+		target.minIndex = a.minIndex;
+	}
+
+	if (target.maxIndex == mEmptyBucket || a.maxY > target.maxY)
+	{
+		target.maxY = a.maxY;
+		target.maxIndex = a.maxIndex;
+	}
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		SelectLevel
+//
+// Description:		Returns the coarsest level whose buckets are no larger
+//					than the desired size.
+//
+// Input Arguments:
+//		desiredBucketSize	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int DecimationPyramid::SelectLevel(const size_t &desiredBucketSize) const
+{
+	unsigned int level(0);
+	while (level + 1 < mLevels.size() && GetBucketSize(level + 1) <= desiredBucketSize)
+		++level;
+
+	return level;
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		Decimate
+//
+// Description:		Builds the list of points to draw for the current view.
+//					Cost depends on the number of pixel columns, not on the
+//					number of points in the curve.
+//
+// Input Arguments:
+//		xMin			= const double&
+//		xMax			= const double&
+//		pixelColumns	= const unsigned int&
+//
+// Output Arguments:
+//		x				= std::vector<double>&
+//		y				= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::Decimate(const double &xMin, const double &xMax,
+	const unsigned int &pixelColumns, std::vector<double> &x,
+	std::vector<double> &y) const
+{
+	x.clear();
+	y.clear();
+	if (mLevels.empty())
+		return;
+
+	// Include one point on either side of the view so lines reach the edges
+	size_t first(std::lower_bound(mX, mX + mCount, xMin) - mX);
+	size_t last(std::upper_bound(mX, mX + mCount, xMax) - mX);
+	if (first > 0)
+		--first;
+	if (last < mCount)
+		++last;
+	if (last <= first)
+		last = std::min(first + 1, mCount);
+
+	// Align the visible range to whole buckets of the level used to draw it
+	// (never so coarse that the view has fewer than mMinViewBucketCount), or
+	// of the size used when drawing from the raw data
+	const size_t desiredBucketSize((last - first) / std::max(pixelColumns, 1U));
+	const unsigned int level(std::min(SelectLevel(desiredBucketSize),
+		SelectLevel(mCount / mMinViewBucketCount)));
+	size_t bucketSize(GetBucketSize(level));
+	if (desiredBucketSize < mMinBucketSize)
+		bucketSize = 1;
+	else if (desiredBucketSize < mBaseBucketSize)
+		bucketSize = desiredBucketSize;
+
+	const size_t viewBegin((first / bucketSize) * bucketSize);
+	const size_t viewEnd(std::min(mCount, ((last + bucketSize - 1) / bucketSize) * bucketSize));
+
+	// Outside the view only the ends and the extremes are needed; the lines
+	// to them are never visible, but they keep the overall extents (and
+	// auto-scaling) unchanged
+	AppendExtremes(0, viewBegin, x, y);
+
+	if (desiredBucketSize < mMinBucketSize)
+		AppendPoints(viewBegin, viewEnd, x, y);
+	else if (desiredBucketSize < mBaseBucketSize)
+		AppendScannedBuckets(viewBegin, viewEnd, desiredBucketSize, x, y);
+	else
+		AppendBuckets(level, viewBegin / bucketSize, (viewEnd + bucketSize - 1) / bucketSize, x, y);
+
+	AppendExtremes(viewEnd, mCount, x, y);
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		GetYRange
+//
+// Description:		Finds the smallest and largest y-values with x-values
+//					in the specified range.  Takes O(log n) time.
+//
+// Input Arguments:
+//		xMin	= const double&
+//		xMax	= const double&
+//
+// Output Arguments:
+//		yMin	= double&
+//		yMax	= double&
+//
+// Return Value:
+//		bool, false if there are no (non-NaN) points in the range
+//
+//==========================================================================
+bool DecimationPyramid::GetYRange(const double &xMin, const double &xMax,
+	double &yMin, double &yMax) const
+{
+	const size_t begin(std::lower_bound(mX, mX + mCount, xMin) - mX);
+	const size_t end(std::upper_bound(mX, mX + mCount, xMax) - mX);
+	const Bucket extremes(FindExtremes(begin, end));
+	if (extremes.minIndex == mEmptyBucket)
+		return false;
+
+	yMin = extremes.minY;
+	yMax = extremes.maxY;
+	return true;
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		FindExtremes
+//
+// Description:		Finds the smallest and largest values in [begin, end).
+//					The range is covered with the largest buckets that fit;
+//					only the parts of base buckets at the ends are read from
+//					the raw data.
+//
+// Input Arguments:
+//		begin	= const size_t&
+//		end		= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Bucket, empty if there are no (non-NaN) values in the range
+//
+//==========================================================================
+DecimationPyramid::Bucket DecimationPyramid::FindExtremes(const size_t &begin,
+	const size_t &end) const
+{
+	Bucket extremes{ 0.0, 0.0, mEmptyBucket, mEmptyBucket };
+	size_t position(begin);
+	while (position < std::min(end, mCount))
+	{
+		if (position % mBaseBucketSize != 0 || position + mBaseBucketSize > end)
+		{
+			const size_t stop(std::min(end, (position / mBaseBucketSize + 1) * mBaseBucketSize));
+			for (; position < stop; ++position)
+			{
+				const Bucket point{ mY[position], mY[position],
+					static_cast<unsigned int>(position), static_cast<unsigned int>(position) };
+				if (point.minY == point.minY)// Not NaN
+					Merge(point, extremes);
+			}
+			continue;
+		}
+
+		unsigned int level(0);
+		while (level + 1 < mLevels.size() && position % GetBucketSize(level + 1) == 0 &&
+			position + GetBucketSize(level + 1) <= end)
+			++level;
+
+		Merge(mLevels[level][position / GetBucketSize(level)], extremes);
+		position += GetBucketSize(level);
+	}
+
+	return extremes;
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		AppendExtremes
+//
+// Description:		Adds the first and last points in [begin, end) and the
+//					points with the smallest and largest values, in the order
+//					they appear in the data.
+//
+// Input Arguments:
+//		begin	= const size_t&
+//		end		= const size_t&
+//
+// Output Arguments:
+//		x		= std::vector<double>&
+//		y		= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::AppendExtremes(const size_t &begin, const size_t &end,
+	std::vector<double> &x, std::vector<double> &y) const
+{
+	if (begin >= end)
+		return;
+
+	std::vector<size_t> indices({ begin, end - 1 });
+	const Bucket extremes(FindExtremes(begin, end));
+	if (extremes.minIndex != mEmptyBucket)
+	{
+		indices.push_back(extremes.minIndex);
+		indices.push_back(extremes.maxIndex);
+	}
+
+	std::sort(indices.begin(), indices.end());
+	indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+	for (const auto& i : indices)
+	{
+		x.push_back(mX[i]);
+		y.push_back(mY[i]);
+	}
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		AppendPoints
+//
+// Description:		Copies raw data points to the output.
+//
+// Input Arguments:
+//		begin	= const size_t&
+//		end		= const size_t&
+//
+// Output Arguments:
+//		x		= std::vector<double>&
+//		y		= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::AppendPoints(const size_t &begin, const size_t &end,
+	std::vector<double> &x, std::vector<double> &y) const
+{
+	x.insert(x.end(), mX + begin, mX + end);
+	y.insert(y.end(), mY + begin, mY + end);
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		AppendBuckets
+//
+// Description:		Adds the min and max points from each bucket in the
+//					specified range, in the order they appear in the data.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		begin	= const size_t&
+//		end		= const size_t&
+//
+// Output Arguments:
+//		x		= std::vector<double>&
+//		y		= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::AppendBuckets(const unsigned int &level,
+	const size_t &begin, const size_t &end, std::vector<double> &x,
+	std::vector<double> &y) const
+{
+	const std::vector<Bucket>& buckets(mLevels[level]);
+	size_t b;
+	for (b = begin; b < std::min(end, buckets.size()); ++b)
+	{
+		const Bucket& bucket(buckets[b]);
+		if (bucket.minIndex == mEmptyBucket)
+			continue;
+
+		const bool minFirst(bucket.minIndex <= bucket.maxIndex);
+		const unsigned int firstIndex(minFirst ? bucket.minIndex : bucket.maxIndex);
+		const unsigned int secondIndex(minFirst ? bucket.maxIndex : bucket.minIndex);
+
+		x.push_back(mX[firstIndex]);
+		y.push_back(mY[firstIndex]);
+		if (secondIndex != firstIndex)
+		{
+			x.push_back(mX[secondIndex]);
+			y.push_back(mY[secondIndex]);
+		}
+	}
+}
+
+//==========================================================================
+// Class:			DecimationPyramid
+// Function:		AppendScannedBuckets
+//
+// Description:		Adds the min and max points from buckets of the
+//					specified size, found by reading the raw data.  Used
+//					when the desired buckets are smaller than the base level.
+//
+// Input Arguments:
+//		begin		= const size_t&
+//		end			= const size_t&
+//		bucketSize	= const size_t&
+//
+// Output Arguments:
+//		x			= std::vector<double>&
+//		y			= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DecimationPyramid::AppendScannedBuckets(const size_t &begin,
+	const size_t &end, const size_t &bucketSize, std::vector<double> &x,
+	std::vector<double> &y) const
+{
+	size_t bucketBegin;
+	for (bucketBegin = begin; bucketBegin < end; bucketBegin += bucketSize)
+	{
+		const size_t bucketEnd(std::min(end, bucketBegin + bucketSize));
+		size_t minIndex(mCount), maxIndex(mCount);
+		size_t i;
+		for (i = bucketBegin; i < bucketEnd; ++i)
+		{
+			const double value(mY[i]);
+			if (value != value)// NaN
+				continue;
+
+			if (minIndex == mCount || value < mY[minIndex])
+				minIndex = i;
+			if (maxIndex == mCount || value > mY[maxIndex])
+				maxIndex = i;
+		}
+
+		if (minIndex == mCount)
+			continue;
+
+		const size_t firstIndex(std::min(minIndex, maxIndex));
+		const size_t secondIndex(std::max(minIndex, maxIndex));
+		x.push_back(mX[firstIndex]);
+		y.push_back(mY[firstIndex]);
+		if (secondIndex != firstIndex)
+		{
+			x.push_back(mX[secondIndex]);
+			y.push_back(mY[secondIndex]);
+		}
+	}
+}
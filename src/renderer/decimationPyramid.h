@@ -0,0 +1,102 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  decimationPyramid.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Multi-resolution min/max summary of a curve, used to draw very
+//				 long curves with roughly one bucket per pixel column.
+// History:
+
+#ifndef DECIMATION_PYRAMID_H_
+#define DECIMATION_PYRAMID_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+
+// Local forward declarations
+class ThreadPool;
+
+// Min/max decimation pyramid over a curve with monotonic x-data
+class DecimationPyramid
+{
+public:
+	// The data must outlive this object.  Larger base buckets use less
+	// memory (for curves too large to keep in memory, for example), at the
+	// cost of reading the raw data when zoomed in closer than one base bucket
+	// per pixel column.
+	DecimationPyramid(const double* x, const double* y, const size_t &count,
+		ThreadPool &pool, const size_t &baseBucketSize = defaultBaseBucketSize);
+
+	// Fills x and y with the points to draw when [xMin, xMax] spans the
+	// specified number of pixel columns.  The visible range uses the level
+	// with about one bucket per column; the rest of the curve is represented
+	// by its end points and extremes so the overall extents (and
+	// auto-scaling) are unchanged.
+	void Decimate(const double &xMin, const double &xMax,
+		const unsigned int &pixelColumns, std::vector<double> &x,
+		std::vector<double> &y) const;
+
+	// Called after the data has moved or grown (or its end has changed);
+	// only buckets at or after firstChangedIndex are recomputed
+	void Update(const double* x, const double* y, const size_t &count,
+		const size_t &firstChangedIndex, ThreadPool &pool);
+
+	size_t GetPointCount() const { return mCount; }
+
+	// Range of y over the points with x in [xMin, xMax], in O(log n) time
+	bool GetYRange(const double &xMin, const double &xMax,
+		double &yMin, double &yMax) const;
+
+	// True if x never decreases (and holds no NaNs), which the pyramid relies
+	// on to find the view; curves whose x-data isn't should be drawn in full
+	static bool IsMonotonic(const double* x, const size_t &count, ThreadPool &pool);
+
+	static const size_t defaultBaseBucketSize;
+
+private:
+	static const size_t mMinBucketSize;
+	static const size_t mMinViewBucketCount;
+	static const unsigned int mEmptyBucket;
+
+	struct Bucket
+	{
+		double minY;
+		double maxY;
+		unsigned int minIndex;
+		unsigned int maxIndex;
+	};
+
+	const double* mX;
+	const double* mY;
+	size_t mCount;
+	const size_t mBaseBucketSize;
+
+	// mLevels[k] has buckets of mBaseBucketSize << k points
+	std::vector<std::vector<Bucket>> mLevels;
+
+	void Build(const size_t &firstChangedIndex, ThreadPool &pool);
+	static void Merge(const Bucket &a, Bucket &target);
+
+	size_t GetBucketSize(const unsigned int &level) const { return mBaseBucketSize << level; }
+	unsigned int SelectLevel(const size_t &desiredBucketSize) const;
+
+	void AppendPoints(const size_t &begin, const size_t &end,
+		std::vector<double> &x, std::vector<double> &y) const;
+	void AppendBuckets(const unsigned int &level, const size_t &begin,
+		const size_t &end, std::vector<double> &x, std::vector<double> &y) const;
+	void AppendScannedBuckets(const size_t &begin, const size_t &end,
+		const size_t &bucketSize, std::vector<double> &x, std::vector<double> &y) const;
+	Bucket FindExtremes(const size_t &begin, const size_t &end) const;
+	void AppendExtremes(const size_t &begin, const size_t &end,
+		std::vector<double> &x, std::vector<double> &y) const;
+};
+
+#endif// DECIMATION_PYRAMID_H_
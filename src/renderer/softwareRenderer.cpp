@@ -0,0 +1,483 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  softwareRenderer.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Draws curves into an image on the CPU, for exporting plots in
+//				 batch mode where there is no display or OpenGL context.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Local headers
+#include "renderer/softwareRenderer.h"
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for SoftwareRenderer class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const unsigned int SoftwareRenderer::mMargin(20);
+const unsigned int SoftwareRenderer::mTargetTickCount(8);
+const unsigned char SoftwareRenderer::mBackgroundColor[3] = { 255, 255, 255 };
+const unsigned char SoftwareRenderer::mGridColor[3] = { 220, 220, 220 };
+const unsigned char SoftwareRenderer::mAxisColor[3] = { 0, 0, 0 };
+const unsigned char SoftwareRenderer::mCurveColors[][3] = {
+	{ 0, 0, 255 },
+	{ 255, 0, 0 },
+	{ 0, 160, 0 },
+	{ 255, 0, 255 },
+	{ 0, 190, 190 },
+	{ 255, 128, 0 },
+	{ 128, 0, 255 },
+	{ 128, 128, 128 } };
+const unsigned int SoftwareRenderer::mCurveColorCount(
+	sizeof(SoftwareRenderer::mCurveColors) / sizeof(SoftwareRenderer::mCurveColors[0]));
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		SoftwareRenderer
+//
+// Description:		Constructor for SoftwareRenderer class.
+//
+// Input Arguments:
+//		width	= const unsigned int&
+//		height	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SoftwareRenderer::SoftwareRenderer(const unsigned int &width,
+	const unsigned int &height) : mWidth(std::max(width, 3 * mMargin)),
+	mHeight(std::max(height, 3 * mMargin))
+{
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		AddCurve
+//
+// Description:		Adds a curve to the plot.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::AddCurve(const LibPlot2D::Dataset2D &data)
+{
+	mCurves.push_back(&data);
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		Render
+//
+// Description:		Draws the grid and curves into the image.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const wxImage&
+//
+//==========================================================================
+const wxImage& SoftwareRenderer::Render()
+{
+	mImage.Create(mWidth, mHeight, false);
+	unsigned char* pixel(mImage.GetData());
+	const unsigned char* end(pixel + 3 * mWidth * mHeight);
+	for (; pixel < end; pixel += 3)
+		std::copy(mBackgroundColor, mBackgroundColor + 3, pixel);
+
+	FindLimits();
+	DrawGrid();
+
+	unsigned int i;
+	for (i = 0; i < mCurves.size(); ++i)
+		DrawCurve(*mCurves[i], mCurveColors[i % mCurveColorCount]);
+
+	return mImage;
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		SavePNG
+//
+// Description:		Renders the plot and saves it.
+//
+// Input Arguments:
+//		fileName	= const wxString&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool SoftwareRenderer::SavePNG(const wxString &fileName)
+{
+	return Render().SaveFile(fileName, wxBITMAP_TYPE_PNG);
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		FindLimits
+//
+// Description:		Sets the axis limits to the extents of the finite data,
+//					rounded out to the nearest grid lines.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::FindLimits()
+{
+	mXMin = std::numeric_limits<double>::max();
+	mXMax = -mXMin;
+	mYMin = mXMin;
+	mYMax = mXMax;
+
+	for (const auto& curve : mCurves)
+	{
+		unsigned int i;
+		for (i = 0; i < curve->GetNumberOfPoints(); ++i)
+		{
+			const double x(curve->GetXData(i));
+			const double y(curve->GetYData(i));
+			if (!std::isfinite(x) || !std::isfinite(y))
+				continue;
+
+			mXMin = std::min(mXMin, x);
+			mXMax = std::max(mXMax, x);
+			mYMin = std::min(mYMin, y);
+			mYMax = std::max(mYMax, y);
+		}
+	}
+
+	auto roundOut([](double &minimum, double &maximum)
+	{
+		if (minimum > maximum)
+		{
+			minimum = 0.0;
+			maximum = 1.0;
+		}
+		else if (minimum == maximum)
+		{
+			const double offset(std::max(1.0, std::abs(minimum) * 0.1));
+			minimum -= offset;
+			maximum += offset;
+		}
+
+		const double spacing(GetTickSpacing(maximum - minimum, mTargetTickCount));
+		minimum = std::floor(minimum / spacing) * spacing;
+		maximum = std::ceil(maximum / spacing) * spacing;
+	});
+
+	roundOut(mXMin, mXMax);
+	roundOut(mYMin, mYMax);
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		DrawGrid
+//
+// Description:		Draws the grid lines and the border of the plot area.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::DrawGrid()
+{
+	const int left(mMargin), right(mWidth - mMargin - 1);
+	const int top(mMargin), bottom(mHeight - mMargin - 1);
+
+	const double xSpacing(GetTickSpacing(mXMax - mXMin, mTargetTickCount));
+	double value;
+	for (value = mXMin + xSpacing; value < mXMax - 0.5 * xSpacing; value += xSpacing)
+		DrawLine(ToPixelX(value), top, ToPixelX(value), bottom, mGridColor);
+
+	const double ySpacing(GetTickSpacing(mYMax - mYMin, mTargetTickCount));
+	for (value = mYMin + ySpacing; value < mYMax - 0.5 * ySpacing; value += ySpacing)
+		DrawLine(left, ToPixelY(value), right, ToPixelY(value), mGridColor);
+
+	DrawLine(left, top, right, top, mAxisColor);
+	DrawLine(right, top, right, bottom, mAxisColor);
+	DrawLine(right, bottom, left, bottom, mAxisColor);
+	DrawLine(left, bottom, left, top, mAxisColor);
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		DrawCurve
+//
+// Description:		Draws a curve.  Points that fall in the same pixel column
+//					are reduced to a vertical span between the lowest and
+//					highest of them, so the cost is linear in the number of
+//					points regardless of how densely they are packed.
+//					Non-finite points break the line.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//		color	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::DrawCurve(const LibPlot2D::Dataset2D &data,
+	const unsigned char* color)
+{
+	bool started(false);
+	int column(0), minY(0), maxY(0), lastY(0);
+
+	auto flush([&]()
+	{
+		if (started)
+			DrawLine(column, minY, column, maxY, color);
+	});
+
+	unsigned int i;
+	for (i = 0; i < data.GetNumberOfPoints(); ++i)
+	{
+		const double x(data.GetXData(i));
+		const double y(data.GetYData(i));
+		if (!std::isfinite(x) || !std::isfinite(y))
+		{
+			flush();
+			started = false;
+			continue;
+		}
+
+		const int px(ToPixelX(x));
+		const int py(ToPixelY(y));
+		if (started && px == column)
+		{
+			minY = std::min(minY, py);
+			maxY = std::max(maxY, py);
+		}
+		else
+		{
+			flush();
+			if (started)
+				DrawLine(column, lastY, px, py, color);
+
+			started = true;
+			column = px;
+			minY = py;
+			maxY = py;
+		}
+
+		lastY = py;
+	}
+
+	flush();
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		ToPixelX
+//
+// Description:		Converts an x-value to a pixel column.
+//
+// Input Arguments:
+//		x	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int
+//
+//==========================================================================
+int SoftwareRenderer::ToPixelX(const double &x) const
+{
+	const double span(mWidth - 2 * mMargin - 1);
+	return static_cast<int>(mMargin + std::round((x - mXMin) / (mXMax - mXMin) * span));
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		ToPixelY
+//
+// Description:		Converts a y-value to a pixel row.
+//
+// Input Arguments:
+//		y	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int
+//
+//==========================================================================
+int SoftwareRenderer::ToPixelY(const double &y) const
+{
+	const double span(mHeight - 2 * mMargin - 1);
+	return static_cast<int>(mHeight - mMargin - 1
+		- std::round((y - mYMin) / (mYMax - mYMin) * span));
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		DrawLine
+//
+// Description:		Draws a one pixel wide line (Bresenham's algorithm).
+//
+// Input Arguments:
+//		x0		= int
+//		y0		= int
+//		x1		= const int&
+//		y1		= const int&
+//		color	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::DrawLine(int x0, int y0, const int &x1, const int &y1,
+	const unsigned char* color)
+{
+	const int dx(std::abs(x1 - x0)), dy(-std::abs(y1 - y0));
+	const int stepX(x0 < x1 ? 1 : -1), stepY(y0 < y1 ? 1 : -1);
+	int error(dx + dy);
+
+	while (true)
+	{
+		SetPixel(x0, y0, color);
+		if (x0 == x1 && y0 == y1)
+			break;
+
+		const int twiceError(2 * error);
+		if (twiceError >= dy)
+		{
+			error += dy;
+			x0 += stepX;
+		}
+
+		if (twiceError <= dx)
+		{
+			error += dx;
+			y0 += stepY;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		SetPixel
+//
+// Description:		Colors a pixel, if it lies within the image.
+//
+// Input Arguments:
+//		x		= const int&
+//		y		= const int&
+//		color	= const unsigned char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwareRenderer::SetPixel(const int &x, const int &y, const unsigned char* color)
+{
+	if (x < 0 || y < 0 || x >= static_cast<int>(mWidth) || y >= static_cast<int>(mHeight))
+		return;
+
+	std::copy(color, color + 3, mImage.GetData() + 3 * (y * mWidth + x));
+}
+
+//==========================================================================
+// Class:			SoftwareRenderer
+// Function:		GetTickSpacing
+//
+// Description:		Returns a spacing of 1, 2 or 5 times a power of ten that
+//					divides the range into about targetCount intervals.
+//
+// Input Arguments:
+//		range		= const double&
+//		targetCount	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double SoftwareRenderer::GetTickSpacing(const double &range,
+	const unsigned int &targetCount)
+{
+	const double rawSpacing(range / targetCount);
+	const double magnitude(std::pow(10.0, std::floor(std::log10(rawSpacing))));
+	const double normalized(rawSpacing / magnitude);
+
+	if (normalized < 1.5)
+		return magnitude;
+	else if (normalized < 3.5)
+		return 2.0 * magnitude;
+	else if (normalized < 7.5)
+		return 5.0 * magnitude;
+
+	return 10.0 * magnitude;
+}
@@ -0,0 +1,80 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  softwareRenderer.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Draws curves into an image on the CPU, for exporting plots in
+//				 batch mode where there is no display or OpenGL context.
+// History:
+
+#ifndef SOFTWARE_RENDERER_H_
+#define SOFTWARE_RENDERER_H_
+
+// Standard C++ headers
+#include <vector>
+
+// wxWidgets headers
+#include <wx/wx.h>
+#include <wx/image.h>
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Off-screen plot renderer
+class SoftwareRenderer
+{
+public:
+	SoftwareRenderer(const unsigned int &width, const unsigned int &height);
+
+	// The data must outlive the call to Render() or SavePNG()
+	void AddCurve(const LibPlot2D::Dataset2D &data);
+
+	// Draws the grid and curves, scaled to fit
+	const wxImage& Render();
+
+	// Renders and writes the image.  The PNG handler must have been added to
+	// wxImage first.
+	bool SavePNG(const wxString &fileName);
+
+private:
+	static const unsigned int mMargin;// [pixels]
+	static const unsigned int mTargetTickCount;
+	static const unsigned char mBackgroundColor[3];
+	static const unsigned char mGridColor[3];
+	static const unsigned char mAxisColor[3];
+	static const unsigned char mCurveColors[][3];
+	static const unsigned int mCurveColorCount;
+
+	const unsigned int mWidth;
+	const unsigned int mHeight;
+	std::vector<const LibPlot2D::Dataset2D*> mCurves;
+
+	wxImage mImage;
+
+	double mXMin, mXMax;
+	double mYMin, mYMax;
+
+	void FindLimits();
+	void DrawGrid();
+	void DrawCurve(const LibPlot2D::Dataset2D &data, const unsigned char* color);
+
+	int ToPixelX(const double &x) const;
+	int ToPixelY(const double &y) const;
+
+	void DrawLine(int x0, int y0, const int &x1, const int &y1, const unsigned char* color);
+	void SetPixel(const int &x, const int &y, const unsigned char* color);
+
+	static double GetTickSpacing(const double &range, const unsigned int &targetCount);
+};
+
+#endif// SOFTWARE_RENDERER_H_
@@ -0,0 +1,569 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  biquadFilter.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Digital filter designed from a continuous-time transfer function
+//				 and factored into cascaded second order sections, so high order
+//				 filters stay well conditioned.  Many channels are filtered at
+//				 once, four to a group in an interleaved layout, with groups
+//				 spread across the thread pool.
+// History:
+
+// Standard C++ headers
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Local headers
+#include "signals/biquadFilter.h"
+#include "signals/vectorKernels.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for BiquadFilter class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t BiquadFilter::mCoefficientsPerSection(5);
+const size_t BiquadFilter::mLanes(4);// Must match VectorKernels::SecondOrderSection()
+const size_t BiquadFilter::mBlockSize(1024);// [frames]
+const unsigned int BiquadFilter::mMaxRootIterations(1000);
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		BiquadFilter
+//
+// Description:		Constructor for BiquadFilter class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+BiquadFilter::BiquadFilter(ThreadPool &pool) : mPool(pool)
+{
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		Design
+//
+// Description:		Computes the second order sections.  The poles and zeros
+//					of the continuous-time filter are found and mapped with
+//					the bilinear transform; zeros at infinity map to z = -1.
+//					Each pair of poles (closest to the unit circle first) is
+//					given the nearest remaining pair of zeros, and the
+//					sections are ordered with the most lightly damped last.
+//
+// Input Arguments:
+//		sampleRate	= const double& [Hz]
+//		numerator	= const std::vector<double>&
+//		denominator	= const std::vector<double>&
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool BiquadFilter::Design(const double &sampleRate, const std::vector<double> &numerator,
+	const std::vector<double> &denominator, std::string &error)
+{
+	mCoefficients.clear();
+	auto isNonZero([](const double &value)
+	{
+		return value != 0.0;
+	});
+	const std::vector<double> b(std::find_if(numerator.begin(), numerator.end(), isNonZero),
+		numerator.end());
+	const std::vector<double> a(std::find_if(denominator.begin(), denominator.end(), isNonZero),
+		denominator.end());
+
+	if (!(sampleRate > 0.0))
+	{
+		error = "Sample rate must be positive";
+		return false;
+	}
+	else if (a.empty() || b.empty())
+	{
+		error = "Numerator and denominator must not be zero";
+		return false;
+	}
+	else if (b.size() > a.size())
+	{
+		error = "Numerator order must not exceed denominator order";
+		return false;
+	}
+
+	std::vector<Complex> zeros, poles;
+	if (!FindRoots(b, zeros) || !FindRoots(a, poles))
+	{
+		error = "Failed to factor the transfer function";
+		return false;
+	}
+
+	// (s - r) = (k - r) * (z - (k + r) / (k - r)) / (z + 1)
+	const double k(2.0 * sampleRate);
+	Complex gain(b.front() / a.front());
+	for (auto& zero : zeros)
+	{
+		gain *= k - zero;
+		zero = (k + zero) / (k - zero);
+	}
+
+	for (auto& pole : poles)
+	{
+		if (pole == Complex(k))
+		{
+			error = "Pole maps to infinity at this sample rate";
+			return false;
+		}
+
+		gain /= k - pole;
+		pole = (k + pole) / (k - pole);
+	}
+
+	zeros.resize(poles.size(), Complex(-1.0));
+	if (poles.empty())
+	{
+		mCoefficients.assign(mCoefficientsPerSection, 0.0);
+		mCoefficients.front() = gain.real();
+		return true;
+	}
+
+	std::vector<RootPair> polePairs(PairRoots(poles)), zeroPairs(PairRoots(zeros));
+	std::sort(polePairs.begin(), polePairs.end(), [](const RootPair &x, const RootPair &y)
+	{
+		return std::abs(x.first) > std::abs(y.first);
+	});
+
+	// Built with the most lightly damped section first, then reversed
+	std::vector<double> sections;
+	for (const auto& polePair : polePairs)
+	{
+		std::vector<RootPair>::iterator nearest(zeroPairs.end());
+		for (auto it = zeroPairs.begin(); it != zeroPairs.end(); ++it)
+		{
+			if (it->single == polePair.single && (nearest == zeroPairs.end() ||
+				std::abs(it->first - polePair.first) < std::abs(nearest->first - polePair.first)))
+				nearest = it;
+		}
+
+		if (nearest == zeroPairs.end())
+			nearest = zeroPairs.begin();
+
+		const RootPair zeroPair(*nearest);
+		zeroPairs.erase(nearest);
+
+		// (z - r1) * (z - r2) / z^2 = 1 - (r1 + r2) z^-1 + r1 * r2 z^-2
+		sections.push_back(1.0);
+		sections.push_back(-(zeroPair.first + zeroPair.second).real());
+		sections.push_back((zeroPair.first * zeroPair.second).real());
+		sections.push_back(-(polePair.first + polePair.second).real());
+		sections.push_back((polePair.first * polePair.second).real());
+	}
+
+	size_t section;
+	for (section = polePairs.size(); section > 0; --section)
+		mCoefficients.insert(mCoefficients.end(), sections.begin()
+			+ (section - 1) * mCoefficientsPerSection, sections.begin()
+			+ section * mCoefficientsPerSection);
+
+	mCoefficients[0] *= gain.real();
+	mCoefficients[1] *= gain.real();
+	mCoefficients[2] *= gain.real();
+	return true;
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		Apply
+//
+// Description:		Filters the channels in place.  Each thread handles
+//					whole groups of four channels.  A group is copied a block
+//					at a time into an interleaved buffer, which every section
+//					is run over before the block is copied back, so the data
+//					is read and written once per pass.
+//
+// Input Arguments:
+//		channels	= const std::vector<double*>&
+//		count		= const size_t&, values in each channel
+//		zeroPhase	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BiquadFilter::Apply(const std::vector<double*> &channels, const size_t &count,
+	const bool &zeroPhase) const
+{
+	PerfMonitor::ScopedTimer timer("Filter");
+
+	if (channels.empty() || count == 0 || mCoefficients.empty())
+		return;
+
+	const size_t groupCount((channels.size() + mLanes - 1) / mLanes);
+	mPool.ParallelFor(groupCount, 1, [this, &channels, &count, &zeroPhase](
+		const size_t &begin, const size_t &end)
+	{
+		std::vector<double> block(mBlockSize * mLanes);
+		std::vector<double> state(GetSectionCount() * 2 * mLanes);
+		std::vector<double*> lanes(mLanes);
+		size_t group;
+		for (group = begin; group < end; ++group)
+		{
+			size_t lane;
+			for (lane = 0; lane < mLanes; ++lane)
+			{
+				const size_t channel(group * mLanes + lane);
+				lanes[lane] = channel < channels.size() ? channels[channel] : nullptr;
+			}
+
+			FilterGroup(lanes.data(), count, false, block.data(), state.data());
+			if (zeroPhase)
+				FilterGroup(lanes.data(), count, true, block.data(), state.data());
+		}
+	});
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		Apply
+//
+// Description:		Returns a filtered copy of a curve.
+//
+// Input Arguments:
+//		data		= const LibPlot2D::Dataset2D&
+//		zeroPhase	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> BiquadFilter::Apply(
+	const LibPlot2D::Dataset2D &data, const bool &zeroPhase) const
+{
+	std::unique_ptr<LibPlot2D::Dataset2D> result(new LibPlot2D::Dataset2D(data));
+	Apply(std::vector<double*>(1, result->GetYPointer()),
+		result->GetNumberOfPoints(), zeroPhase);
+	return result;
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		FindRoots
+//
+// Description:		Finds the roots of a polynomial.  Roots at zero are
+//					removed first (they are exact); the rest are found with
+//					the Durand-Kerner iteration, starting from a circle with
+//					the roots' geometric mean radius.
+//
+// Input Arguments:
+//		coefficients	= const std::vector<double>&
+//
+// Output Arguments:
+//		roots			= std::vector<Complex>&
+//
+// Return Value:
+//		bool, false if the iteration did not find the roots
+//
+//==========================================================================
+bool BiquadFilter::FindRoots(const std::vector<double> &coefficients,
+	std::vector<Complex> &roots)
+{
+	roots.clear();
+	std::vector<double> monic(coefficients);
+	while (monic.size() > 1 && monic.back() == 0.0)
+	{
+		monic.pop_back();
+		roots.push_back(Complex(0.0));
+	}
+
+	const size_t order(monic.size() - 1);
+	if (order == 0)
+		return true;
+
+	for (auto& coefficient : monic)
+		coefficient /= coefficients.front();
+
+	const double radius(pow(std::abs(monic.back()), 1.0 / order));
+	const double pi(4.0 * atan(1.0));// M_PI isn't standard
+	std::vector<Complex> estimates(order);
+	size_t i, j;
+	for (i = 0; i < order; ++i)
+		estimates[i] = std::polar(radius, 2.0 * pi * i / order + 0.4);
+
+	unsigned int iteration;
+	for (iteration = 0; iteration < mMaxRootIterations && order > 1; ++iteration)
+	{
+		double largestChange(0.0);
+		for (i = 0; i < order; ++i)
+		{
+			Complex denominator(1.0);
+			for (j = 0; j < order; ++j)
+			{
+				if (j != i)
+					denominator *= estimates[i] - estimates[j];
+			}
+
+			if (denominator == Complex(0.0))
+				denominator = std::numeric_limits<double>::epsilon() * radius;
+
+			const Complex change(EvaluatePolynomial(monic, estimates[i]) / denominator);
+			estimates[i] -= change;
+			largestChange = std::max(largestChange, std::abs(change) / radius);
+		}
+
+		if (largestChange < 4.0 * std::numeric_limits<double>::epsilon())
+			break;
+	}
+
+	if (order == 1)
+		estimates.front() = -monic.back();
+
+	// Repeated roots converge slowly and less precisely, so check the residual
+	// rather than the last change
+	for (const auto& estimate : estimates)
+	{
+		double scale(0.0);
+		for (const auto& coefficient : monic)
+			scale = scale * std::abs(estimate) + std::abs(coefficient);
+
+		if (!(std::abs(EvaluatePolynomial(monic, estimate)) <= 1.0e-6 * scale))
+			return false;
+	}
+
+	roots.insert(roots.end(), estimates.begin(), estimates.end());
+	return true;
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		EvaluatePolynomial
+//
+// Description:		Evaluates a polynomial with Horner's method.
+//
+// Input Arguments:
+//		coefficients	= const std::vector<double>&, descending powers
+//		x				= const Complex&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Complex
+//
+//==========================================================================
+BiquadFilter::Complex BiquadFilter::EvaluatePolynomial(
+	const std::vector<double> &coefficients, const Complex &x)
+{
+	Complex result(0.0);
+	for (const auto& coefficient : coefficients)
+		result = result * x + coefficient;
+	return result;
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		PairRoots
+//
+// Description:		Groups roots into conjugate pairs and pairs of real
+//					roots.  The root furthest from the real axis is taken
+//					first and paired with the root nearest its conjugate;
+//					a pair which is nearly real is made exactly real, and
+//					otherwise exactly conjugate.  With an odd number of
+//					roots, the last (real) root is left single.
+//
+// Input Arguments:
+//		roots	= const std::vector<Complex>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<RootPair>
+//
+//==========================================================================
+std::vector<BiquadFilter::RootPair> BiquadFilter::PairRoots(
+	const std::vector<Complex> &roots)
+{
+	std::vector<Complex> remaining(roots);
+	std::sort(remaining.begin(), remaining.end(), [](const Complex &x, const Complex &y)
+	{
+		return std::abs(x.imag()) < std::abs(y.imag());
+	});
+
+	std::vector<RootPair> pairs;
+	while (!remaining.empty())
+	{
+		RootPair pair;
+		pair.first = remaining.back();
+		remaining.pop_back();
+		pair.single = remaining.empty();
+		if (pair.single)
+		{
+			pair.first = pair.first.real();
+			pair.second = 0.0;
+			pairs.push_back(pair);
+			break;
+		}
+
+		std::vector<Complex>::iterator partner(std::min_element(remaining.begin(),
+			remaining.end(), [&pair](const Complex &x, const Complex &y)
+		{
+			return std::abs(x - std::conj(pair.first)) < std::abs(y - std::conj(pair.first));
+		}));
+		pair.second = *partner;
+		remaining.erase(partner);
+
+		if (std::abs(pair.first.imag()) <= 1.0e-6 * std::abs(pair.first))
+		{
+			pair.first = pair.first.real();
+			pair.second = pair.second.real();
+		}
+		else
+		{
+			pair.first = 0.5 * (pair.first + std::conj(pair.second));
+			pair.second = std::conj(pair.first);
+		}
+
+		pairs.push_back(pair);
+	}
+
+	return pairs;
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		FilterGroup
+//
+// Description:		Runs one pass of the filter over a group of channels.
+//
+// Input Arguments:
+//		lanes	= double* const*, mLanes channels (nullptr for unused lanes)
+//		count	= const size_t&
+//		reverse	= const bool&, true to run from the last value to the first
+//		block	= double*, space for mBlockSize frames
+//		state	= double*, space for two values per lane per section
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BiquadFilter::FilterGroup(double* const* lanes, const size_t &count,
+	const bool &reverse, double* block, double* state) const
+{
+	InitializeState(lanes, reverse ? count - 1 : 0, state);
+
+	const size_t sectionCount(GetSectionCount());
+	size_t start, i, lane, section;
+	for (start = 0; start < count; start += mBlockSize)
+	{
+		const size_t frames(std::min(mBlockSize, count - start));
+		for (i = 0; i < frames; ++i)
+		{
+			const size_t index(reverse ? count - 1 - start - i : start + i);
+			for (lane = 0; lane < mLanes; ++lane)
+				block[i * mLanes + lane] = lanes[lane] ? lanes[lane][index] : 0.0;
+		}
+
+		for (section = 0; section < sectionCount; ++section)
+			VectorKernels::SecondOrderSection(GetSection(section), block,
+				state + section * 2 * mLanes, frames);
+
+		for (i = 0; i < frames; ++i)
+		{
+			const size_t index(reverse ? count - 1 - start - i : start + i);
+			for (lane = 0; lane < mLanes; ++lane)
+			{
+				if (lanes[lane])
+					lanes[lane][index] = block[i * mLanes + lane];
+			}
+		}
+	}
+}
+
+//==========================================================================
+// Class:			BiquadFilter
+// Function:		InitializeState
+//
+// Description:		Sets each section's state to its steady state for a
+//					constant input equal to the first value of the pass.
+//					Sections with a pole at z = 1 start from rest.
+//
+// Input Arguments:
+//		lanes	= double* const*
+//		first	= const size_t&, index of the first value of the pass
+//
+// Output Arguments:
+//		state	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void BiquadFilter::InitializeState(double* const* lanes, const size_t &first,
+	double* state) const
+{
+	size_t lane, section;
+	for (lane = 0; lane < mLanes; ++lane)
+	{
+		double x(lanes[lane] ? lanes[lane][first] : 0.0);
+		for (section = 0; section < GetSectionCount(); ++section)
+		{
+			const double* c(GetSection(section));
+			const double poleSum(1.0 + c[3] + c[4]);
+			double* z(state + section * 2 * mLanes);
+			if (std::abs(poleSum) < std::numeric_limits<double>::epsilon())
+			{
+				z[lane] = 0.0;
+				z[lane + mLanes] = 0.0;
+				x = 0.0;
+				continue;
+			}
+
+			const double y(x * (c[0] + c[1] + c[2]) / poleSum);
+			z[lane] = y - c[0] * x;
+			z[lane + mLanes] = c[2] * x - c[4] * y;
+			x = y;
+		}
+	}
+}
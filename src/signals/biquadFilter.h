@@ -0,0 +1,101 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  biquadFilter.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Digital filter designed from a continuous-time transfer function
+//				 and factored into cascaded second order sections, so high order
+//				 filters stay well conditioned.  Many channels are filtered at
+//				 once, four to a group in an interleaved layout, with groups
+//				 spread across the thread pool.
+// History:
+
+#ifndef BIQUAD_FILTER_H_
+#define BIQUAD_FILTER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <memory>
+#include <complex>
+
+// Local forward declarations
+class ThreadPool;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Cascade of second order sections applied to many channels at once
+class BiquadFilter
+{
+public:
+	explicit BiquadFilter(ThreadPool &pool);
+
+	// Coefficients are in descending powers of s, as for LibPlot2D::Filter
+	// (e.g. wc^2 / (s^2 + 2 wc s + wc^2) is {wc^2} over {1, 2 wc, wc^2}).  The
+	// transfer function is discretized with the bilinear transform.  Returns
+	// false (with a description in error) if the filter is improper or the
+	// denominator can't be factored.
+	bool Design(const double &sampleRate, const std::vector<double> &numerator,
+		const std::vector<double> &denominator, std::string &error);
+
+	size_t GetSectionCount() const { return mCoefficients.size() / mCoefficientsPerSection; }
+
+	// b0, b1, b2, a1, a2 (a0 is one)
+	const double* GetSection(const size_t &i) const
+		{ return mCoefficients.data() + i * mCoefficientsPerSection; }
+
+	// Filters each channel (all count values long) in place.  Each pass starts
+	// in the steady state for its first value, so a constant signal passes
+	// through unchanged (apart from the DC gain).  Zero-phase filtering runs
+	// the filter forward, then backward over the result, which cancels the
+	// phase lag and squares the magnitude response.
+	void Apply(const std::vector<double*> &channels, const size_t &count,
+		const bool &zeroPhase) const;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> Apply(const LibPlot2D::Dataset2D &data,
+		const bool &zeroPhase) const;
+
+private:
+	static const size_t mCoefficientsPerSection;
+	static const size_t mLanes;// Channels per group
+	static const size_t mBlockSize;// [frames]
+	static const unsigned int mMaxRootIterations;
+
+	ThreadPool &mPool;
+	std::vector<double> mCoefficients;// mCoefficientsPerSection per section
+
+	typedef std::complex<double> Complex;
+
+	// Roots of a real polynomial, in descending powers, leading term non-zero
+	static bool FindRoots(const std::vector<double> &coefficients,
+		std::vector<Complex> &roots);
+	static Complex EvaluatePolynomial(const std::vector<double> &coefficients,
+		const Complex &x);
+
+	// A root and its partner; second is zero if first is alone
+	struct RootPair
+	{
+		Complex first;
+		Complex second;
+		bool single;
+	};
+
+	static std::vector<RootPair> PairRoots(const std::vector<Complex> &roots);
+
+	void FilterGroup(double* const* lanes, const size_t &count, const bool &reverse,
+		double* block, double* state) const;
+	void InitializeState(double* const* lanes, const size_t &first, double* state) const;
+};
+
+#endif// BIQUAD_FILTER_H_
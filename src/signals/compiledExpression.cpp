@@ -0,0 +1,1091 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  compiledExpression.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  User-specified arithmetic on columns of data (e.g.
+//				 "[3]*[5]-sqrt([7])"), compiled once into a short list of array
+//				 operations which is run over blocks of rows in parallel.
+//				 Repeated subexpressions are computed once and constant operands
+//				 are folded into the operations that use them.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <locale>
+
+// Local headers
+#include "signals/compiledExpression.h"
+#include "signals/vectorKernels.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for CompiledExpression class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t CompiledExpression::mBlockSize(2048);// Registers stay in cache
+const unsigned int CompiledExpression::mOutputRegister(std::numeric_limits<unsigned int>::max());
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		CompiledExpression
+//
+// Description:		Constructor for CompiledExpression class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CompiledExpression::CompiledExpression(ThreadPool &pool) : mPool(pool)
+{
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		Compile
+//
+// Description:		Parses the expression into a graph of shared nodes and
+//					turns the graph into instructions.
+//
+// Input Arguments:
+//		expression	= const std::string&
+//
+// Output Arguments:
+//		error		= std::string&
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool CompiledExpression::Compile(const std::string &expression, std::string &error)
+{
+	mInstructions.clear();
+	mRegisterCount = 0;
+	mColumns.clear();
+
+	ParseState state(expression);
+	const int root(ParseSum(state));
+	if (root >= 0 && SkipTo(state, '\0'))
+		state.error = "unexpected '" + expression.substr(state.position, 1)
+			+ "' at position " + std::to_string(state.position + 1);
+
+	if (root < 0 || !state.error.empty())
+	{
+		error = state.error;
+		return false;
+	}
+
+	GenerateInstructions(state.nodes, root);
+	return true;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ParseSum
+//
+// Description:		Parses terms separated by + or -.
+//
+// Input Arguments:
+//		state	= ParseState&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the resulting node, or -1 on error
+//
+//==========================================================================
+int CompiledExpression::ParseSum(ParseState &state)
+{
+	int node(ParseProduct(state));
+	while (node >= 0)
+	{
+		if (SkipTo(state, '+'))
+		{
+			++state.position;
+			const int right(ParseProduct(state));
+			node = right < 0 ? -1 : AddBinary(state, OpCode::Add, node, right);
+		}
+		else if (SkipTo(state, '-'))
+		{
+			++state.position;
+			const int right(ParseProduct(state));
+			node = right < 0 ? -1 : AddBinary(state, OpCode::Subtract, node, right);
+		}
+		else
+			break;
+	}
+
+	return node;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ParseProduct
+//
+// Description:		Parses factors separated by * or /.
+//
+// Input Arguments:
+//		state	= ParseState&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the resulting node, or -1 on error
+//
+//==========================================================================
+int CompiledExpression::ParseProduct(ParseState &state)
+{
+	int node(ParseUnary(state));
+	while (node >= 0)
+	{
+		if (SkipTo(state, '*'))
+		{
+			++state.position;
+			const int right(ParseUnary(state));
+			node = right < 0 ? -1 : AddBinary(state, OpCode::Multiply, node, right);
+		}
+		else if (SkipTo(state, '/'))
+		{
+			++state.position;
+			const int right(ParseUnary(state));
+			node = right < 0 ? -1 : AddBinary(state, OpCode::Divide, node, right);
+		}
+		else
+			break;
+	}
+
+	return node;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ParseUnary
+//
+// Description:		Parses a factor with an optional leading sign.
+//
+// Input Arguments:
+//		state	= ParseState&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the resulting node, or -1 on error
+//
+//==========================================================================
+int CompiledExpression::ParseUnary(ParseState &state)
+{
+	if (SkipTo(state, '+'))
+	{
+		++state.position;
+		return ParseUnary(state);
+	}
+	else if (SkipTo(state, '-'))
+	{
+		++state.position;
+		const int node(ParseUnary(state));
+		return node < 0 ? -1 : AddScaleAndOffset(state, node, -1.0, 0.0);
+	}
+
+	return ParsePower(state);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ParsePower
+//
+// Description:		Parses a primary raised to an optional power.  The
+//					exponent may have a sign, and a^b^c is a^(b^c).
+//
+// Input Arguments:
+//		state	= ParseState&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the resulting node, or -1 on error
+//
+//==========================================================================
+int CompiledExpression::ParsePower(ParseState &state)
+{
+	const int node(ParsePrimary(state));
+	if (node < 0 || !SkipTo(state, '^'))
+		return node;
+
+	++state.position;
+	const int exponent(ParseUnary(state));
+	return exponent < 0 ? -1 : AddBinary(state, OpCode::Power, node, exponent);
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ParsePrimary
+//
+// Description:		Parses a number, column reference, constant, function
+//					call or parenthesized expression.
+//
+// Input Arguments:
+//		state	= ParseState&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the resulting node, or -1 on error
+//
+//==========================================================================
+int CompiledExpression::ParsePrimary(ParseState &state)
+{
+	const std::string& text(state.text);
+	SkipTo(state, '\0');
+	const size_t start(state.position);
+	if (start >= text.size())
+	{
+		state.error = "unexpected end of expression";
+		return -1;
+	}
+
+	if (text[start] == '(')
+	{
+		++state.position;
+		const int node(ParseSum(state));
+		if (node < 0)
+			return -1;
+		else if (!SkipTo(state, ')'))
+		{
+			state.error = "missing ')' at position " + std::to_string(state.position + 1);
+			return -1;
+		}
+
+		++state.position;
+		return node;
+	}
+	else if (text[start] == '[')
+	{
+		++state.position;
+		unsigned long column(0);
+		const size_t digitsStart(state.position);
+		while (state.position < text.size() && isdigit(static_cast<unsigned char>(text[state.position])) &&
+			column <= std::numeric_limits<unsigned int>::max())
+			column = column * 10 + (text[state.position++] - '0');
+
+		if (state.position == digitsStart || column > std::numeric_limits<unsigned int>::max() ||
+			!SkipTo(state, ']'))
+		{
+			state.error = "invalid column reference at position " + std::to_string(start + 1);
+			return -1;
+		}
+
+		++state.position;
+		return AddColumn(state, static_cast<unsigned int>(column));
+	}
+	else if (isdigit(static_cast<unsigned char>(text[start])) || text[start] == '.')
+	{
+		while (state.position < text.size() && (isdigit(static_cast<unsigned char>(text[state.position])) ||
+			text[state.position] == '.'))
+			++state.position;
+
+		if (state.position < text.size() && (text[state.position] == 'e' || text[state.position] == 'E'))
+		{
+			size_t end(state.position + 1);
+			if (end < text.size() && (text[end] == '+' || text[end] == '-'))
+				++end;
+			if (end < text.size() && isdigit(static_cast<unsigned char>(text[end])))
+			{
+				state.position = end;
+				while (state.position < text.size() && isdigit(static_cast<unsigned char>(text[state.position])))
+					++state.position;
+			}
+		}
+
+		// Always with a '.' decimal separator, whatever the locale
+		std::istringstream stream(text.substr(start, state.position - start));
+		stream.imbue(std::locale::classic());
+		double value;
+		if (!(stream >> value) || !stream.eof())
+		{
+			state.error = "invalid number at position " + std::to_string(start + 1);
+			return -1;
+		}
+
+		return AddConstant(state, value);
+	}
+	else if (isalpha(static_cast<unsigned char>(text[start])))
+	{
+		while (state.position < text.size() && isalnum(static_cast<unsigned char>(text[state.position])))
+			++state.position;
+
+		std::string name(text.substr(start, state.position - start));
+		std::transform(name.begin(), name.end(), name.begin(), [](const char &c)
+		{
+			return static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		});
+
+		// M_PI and M_E aren't standard (MSVC only has them with _USE_MATH_DEFINES)
+		if (name == "pi")
+			return AddConstant(state, 4.0 * atan(1.0));
+		else if (name == "e")
+			return AddConstant(state, exp(1.0));
+
+		OpCode code;
+		if (!FindFunction(name, code))
+		{
+			state.error = "unknown name '" + name + "' at position " + std::to_string(start + 1);
+			return -1;
+		}
+		else if (!SkipTo(state, '('))
+		{
+			state.error = "missing '(' after " + name;
+			return -1;
+		}
+
+		++state.position;
+		const int argument(ParseSum(state));
+		if (argument < 0)
+			return -1;
+		else if (!SkipTo(state, ')'))
+		{
+			state.error = "missing ')' at position " + std::to_string(state.position + 1);
+			return -1;
+		}
+
+		++state.position;
+		return AddUnary(state, code, argument);
+	}
+
+	state.error = "unexpected '" + text.substr(start, 1) + "' at position "
+		+ std::to_string(start + 1);
+	return -1;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		SkipTo
+//
+// Description:		Skips whitespace and checks the next character.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		c		= const char&, '\0' to check for anything but the end
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		bool, true if the next character is c (or, for '\0', if there
+//		is a next character)
+//
+//==========================================================================
+bool CompiledExpression::SkipTo(ParseState &state, const char &c)
+{
+	while (state.position < state.text.size() &&
+		isspace(static_cast<unsigned char>(state.text[state.position])))
+		++state.position;
+
+	if (state.position >= state.text.size())
+		return false;
+
+	return c == '\0' || state.text[state.position] == c;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		FindFunction
+//
+// Description:		Looks up a function by its (lower case) name.
+//
+// Input Arguments:
+//		name	= const std::string&
+//
+// Output Arguments:
+//		code	= OpCode&
+//
+// Return Value:
+//		bool, true if found
+//
+//==========================================================================
+bool CompiledExpression::FindFunction(const std::string &name, OpCode &code)
+{
+	static const std::map<std::string, OpCode> functions = {
+		{ "sqrt", OpCode::SquareRoot },
+		{ "abs", OpCode::AbsoluteValue },
+		{ "exp", OpCode::Exponential },
+		{ "ln", OpCode::NaturalLog },
+		{ "log", OpCode::NaturalLog },
+		{ "log10", OpCode::Log10 },
+		{ "sin", OpCode::Sine },
+		{ "cos", OpCode::Cosine },
+		{ "tan", OpCode::Tangent },
+		{ "asin", OpCode::ArcSine },
+		{ "acos", OpCode::ArcCosine },
+		{ "atan", OpCode::ArcTangent }
+	};
+
+	const auto function(functions.find(name));
+	if (function == functions.end())
+		return false;
+
+	code = function->second;
+	return true;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddConstant
+//
+// Description:		Adds a constant node.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		value	= const double&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddConstant(ParseState &state, const double &value)
+{
+	return AddNode(state, { Node::Type::Constant, OpCode::Copy, -1, -1, value, 1.0, 0.0 });
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddColumn
+//
+// Description:		Adds a column reference node.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		column	= const unsigned int&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddColumn(ParseState &state, const unsigned int &column)
+{
+	return AddNode(state, { Node::Type::Column, OpCode::Copy, -1, -1,
+		static_cast<double>(column), 1.0, 0.0 });
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddUnary
+//
+// Description:		Adds a function of one operand, or its value if the
+//					operand is constant.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		code	= const OpCode&
+//		a		= const int&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddUnary(ParseState &state, const OpCode &code, const int &a)
+{
+	if (state.nodes[a].type == Node::Type::Constant)
+		return AddConstant(state, ApplyScalar(code, state.nodes[a].value, 0.0));
+
+	return AddNode(state, { Node::Type::Operation, code, a, -1, 0.0, 1.0, 0.0 });
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddBinary
+//
+// Description:		Adds an operation on two operands.  Constant operands of
+//					+, - and * become a scale and offset on the other
+//					operand, and a few special cases are simplified.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		code	= const OpCode&
+//		a		= const int&
+//		b		= const int&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddBinary(ParseState &state, const OpCode &code,
+	const int &a, const int &b)
+{
+	const bool aConstant(state.nodes[a].type == Node::Type::Constant);
+	const bool bConstant(state.nodes[b].type == Node::Type::Constant);
+	const double aValue(state.nodes[a].value);
+	const double bValue(state.nodes[b].value);
+	if (aConstant && bConstant)
+		return AddConstant(state, ApplyScalar(code, aValue, bValue));
+
+	switch (code)
+	{
+	case OpCode::Add:
+		if (aConstant)
+			return AddScaleAndOffset(state, b, 1.0, aValue);
+		else if (bConstant)
+			return AddScaleAndOffset(state, a, 1.0, bValue);
+		else if (a == b)
+			return AddScaleAndOffset(state, a, 2.0, 0.0);
+		break;
+
+	case OpCode::Subtract:
+		if (aConstant)
+			return AddScaleAndOffset(state, b, -1.0, aValue);
+		else if (bConstant)
+			return AddScaleAndOffset(state, a, 1.0, -bValue);
+		break;
+
+	case OpCode::Multiply:
+		if (aConstant)
+			return AddScaleAndOffset(state, b, aValue, 0.0);
+		else if (bConstant)
+			return AddScaleAndOffset(state, a, bValue, 0.0);
+		else if (a == b)
+			return AddNode(state, { Node::Type::Operation, OpCode::Square, a, -1, 0.0, 1.0, 0.0 });
+		break;
+
+	case OpCode::Power:
+		if (bConstant && bValue == 1.0)
+			return a;
+		else if (bConstant && bValue == 2.0)
+			return AddNode(state, { Node::Type::Operation, OpCode::Square, a, -1, 0.0, 1.0, 0.0 });
+		else if (bConstant && bValue == 0.5)
+			return AddNode(state, { Node::Type::Operation, OpCode::SquareRoot, a, -1, 0.0, 1.0, 0.0 });
+		break;
+
+	default:
+		break;
+	}
+
+	return AddNode(state, { Node::Type::Operation, code, a, b, 0.0, 1.0, 0.0 });
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddScaleAndOffset
+//
+// Description:		Adds a * scale + offset.  If a is itself scaled and
+//					offset, the two are combined into one operation.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		a		= const int&
+//		scale	= const double&
+//		offset	= const double&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddScaleAndOffset(ParseState &state, const int &a,
+	const double &scale, const double &offset)
+{
+	const Node operand(state.nodes[a]);
+	if (scale == 1.0 && offset == 0.0)
+		return a;
+	else if (operand.type == Node::Type::Constant)
+		return AddConstant(state, operand.value * scale + offset);
+	else if (operand.type == Node::Type::Operation && operand.code == OpCode::ScaleAndOffset)
+		return AddScaleAndOffset(state, operand.a, operand.scale * scale,
+			operand.offset * scale + offset);
+
+	return AddNode(state, { Node::Type::Operation, OpCode::ScaleAndOffset, a, -1,
+		0.0, scale, offset });
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		AddNode
+//
+// Description:		Returns the index of an identical node if there is one;
+//					otherwise adds the node.
+//
+// Input Arguments:
+//		state	= ParseState&
+//		node	= const Node&
+//
+// Output Arguments:
+//		state	= ParseState&
+//
+// Return Value:
+//		int, index of the node
+//
+//==========================================================================
+int CompiledExpression::AddNode(ParseState &state, const Node &node)
+{
+	const NodeKey key(static_cast<int>(node.type), static_cast<int>(node.code),
+		node.a, node.b, node.value, node.scale, node.offset);
+	const auto existing(state.nodeIndices.find(key));
+	if (existing != state.nodeIndices.end())
+		return existing->second;
+
+	const int index(static_cast<int>(state.nodes.size()));
+	state.nodes.push_back(node);
+	state.nodeIndices[key] = index;
+	return index;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyScalar
+//
+// Description:		Applies an operation to single values (for folding
+//					constants).
+//
+// Input Arguments:
+//		code	= const OpCode&
+//		a		= const double&
+//		b		= const double&, binary operations only
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+double CompiledExpression::ApplyScalar(const OpCode &code, const double &a, const double &b)
+{
+	switch (code)
+	{
+	case OpCode::Add:
+		return a + b;
+
+	case OpCode::Subtract:
+		return a - b;
+
+	case OpCode::Multiply:
+		return a * b;
+
+	case OpCode::Divide:
+		return a / b;
+
+	case OpCode::Power:
+		return pow(a, b);
+
+	default:
+		break;
+	}
+
+	double result;
+	ApplyFunction(code, &a, &result, 1);
+	return result;
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		GenerateInstructions
+//
+// Description:		Emits an instruction for each operation the result
+//					depends on (nodes are already in dependency order).
+//					Column and constant operands are read in place, and a
+//					register is reused as soon as its last reader has run,
+//					so few temporaries are needed and each stays in cache
+//					between the instructions of a block.  The last
+//					instruction writes straight to the output.
+//
+// Input Arguments:
+//		nodes	= const std::vector<Node>&
+//		root	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::GenerateInstructions(const std::vector<Node> &nodes, const int &root)
+{
+	std::vector<bool> used(nodes.size(), false);
+	used[root] = true;
+	int i;
+	for (i = root; i >= 0; --i)
+	{
+		if (!used[i])
+			continue;
+		else if (nodes[i].type == Node::Type::Column)
+			mColumns.push_back(static_cast<unsigned int>(nodes[i].value));
+
+		if (nodes[i].a >= 0)
+			used[nodes[i].a] = true;
+		if (nodes[i].b >= 0)
+			used[nodes[i].b] = true;
+	}
+	std::sort(mColumns.begin(), mColumns.end());
+
+	std::vector<int> lastReader(nodes.size(), -1);
+	for (i = 0; i <= root; ++i)
+	{
+		if (!used[i])
+			continue;
+
+		if (nodes[i].a >= 0)
+			lastReader[nodes[i].a] = i;
+		if (nodes[i].b >= 0)
+			lastReader[nodes[i].b] = i;
+	}
+
+	auto getOperand([&nodes](const int &node, const std::vector<unsigned int> &registers)
+	{
+		Operand operand;
+		if (nodes[node].type == Node::Type::Constant)
+			operand.value = nodes[node].value;
+		else if (nodes[node].type == Node::Type::Column)
+		{
+			operand.type = Operand::Type::Column;
+			operand.index = static_cast<unsigned int>(nodes[node].value);
+		}
+		else
+		{
+			operand.type = Operand::Type::Register;
+			operand.index = registers[node];
+		}
+
+		return operand;
+	});
+
+	if (nodes[root].type != Node::Type::Operation)
+	{
+		Instruction instruction;
+		instruction.code = OpCode::Copy;
+		instruction.a = getOperand(root, std::vector<unsigned int>());
+		instruction.out = mOutputRegister;
+		mInstructions.push_back(instruction);
+		return;
+	}
+
+	std::vector<unsigned int> registers(nodes.size(), 0);
+	std::vector<unsigned int> freeRegisters;
+	for (i = 0; i <= root; ++i)
+	{
+		if (!used[i] || nodes[i].type != Node::Type::Operation)
+			continue;
+
+		Instruction instruction;
+		instruction.code = nodes[i].code;
+		instruction.a = getOperand(nodes[i].a, registers);
+		if (nodes[i].b >= 0)
+			instruction.b = getOperand(nodes[i].b, registers);
+		instruction.scale = nodes[i].scale;
+		instruction.offset = nodes[i].offset;
+
+		// Every kernel allows its output to be one of its inputs
+		for (const auto& operand : { nodes[i].a, nodes[i].b })
+		{
+			if (operand >= 0 && lastReader[operand] == i &&
+				nodes[operand].type == Node::Type::Operation &&
+				std::find(freeRegisters.begin(), freeRegisters.end(),
+				registers[operand]) == freeRegisters.end())
+				freeRegisters.push_back(registers[operand]);
+		}
+
+		if (i == root)
+			instruction.out = mOutputRegister;
+		else if (freeRegisters.empty())
+			instruction.out = mRegisterCount++;
+		else
+		{
+			instruction.out = freeRegisters.back();
+			freeRegisters.pop_back();
+		}
+
+		registers[i] = instruction.out;
+		mInstructions.push_back(instruction);
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		Evaluate
+//
+// Description:		Runs the instructions over blocks of mBlockSize rows;
+//					blocks are divided among the pool's threads, each with
+//					its own registers.
+//
+// Input Arguments:
+//		columns	= const std::vector<const double*>&
+//		begin	= const size_t&
+//		end		= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::Evaluate(const std::vector<const double*> &columns,
+	const size_t &begin, const size_t &end, double* out) const
+{
+	PerfMonitor::ScopedTimer timer("Expression");
+
+	if (end <= begin || mInstructions.empty())
+		return;
+
+	const size_t blockCount((end - begin + mBlockSize - 1) / mBlockSize);
+	mPool.ParallelFor(blockCount, 1, [this, &columns, &begin, &end, out](
+		const size_t &firstBlock, const size_t &lastBlock)
+	{
+		std::vector<double> registers(mRegisterCount * mBlockSize);
+		size_t block;
+		for (block = firstBlock; block < lastBlock; ++block)
+		{
+			const size_t blockBegin(begin + block * mBlockSize);
+			EvaluateBlock(columns, blockBegin, std::min(end, blockBegin + mBlockSize),
+				out, registers.data());
+		}
+	});
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		EvaluateBlock
+//
+// Description:		Runs the instructions over one block of rows.
+//
+// Input Arguments:
+//		columns		= const std::vector<const double*>&
+//		begin		= const size_t&
+//		end			= const size_t&
+//		registers	= double*, mRegisterCount * mBlockSize values
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::EvaluateBlock(const std::vector<const double*> &columns,
+	const size_t &begin, const size_t &end, double* out, double* registers) const
+{
+	const size_t count(end - begin);
+	auto getArray([&columns, &begin, registers](const Operand &operand) -> const double*
+	{
+		if (operand.type == Operand::Type::Column)
+			return columns[operand.index] + begin;
+		else if (operand.type == Operand::Type::Register)
+			return registers + operand.index * mBlockSize;
+		return nullptr;
+	});
+
+	size_t i;
+	for (const auto& instruction : mInstructions)
+	{
+		double* result(instruction.out == mOutputRegister ?
+			out + begin : registers + instruction.out * mBlockSize);
+		const double* a(getArray(instruction.a));
+		const double* b(getArray(instruction.b));
+		const double aValue(instruction.a.value);
+		const double bValue(instruction.b.value);
+
+		switch (instruction.code)
+		{
+		case OpCode::Copy:
+			if (a)
+				memcpy(result, a, sizeof(double) * count);
+			else
+				std::fill(result, result + count, aValue);
+			break;
+
+		case OpCode::ScaleAndOffset:
+			VectorKernels::ScaleAndOffset(a, instruction.scale, instruction.offset, result, count);
+			break;
+
+		case OpCode::Add:
+			VectorKernels::Add(a, b, result, count);
+			break;
+
+		case OpCode::Subtract:
+			VectorKernels::Subtract(a, b, result, count);
+			break;
+
+		case OpCode::Multiply:
+			VectorKernels::Multiply(a, b, result, count);
+			break;
+
+		case OpCode::Divide:
+			if (a && b)
+				VectorKernels::Divide(a, b, result, count);
+			else if (a)
+			{
+				for (i = 0; i < count; ++i)
+					result[i] = a[i] / bValue;
+			}
+			else
+			{
+				for (i = 0; i < count; ++i)
+					result[i] = aValue / b[i];
+			}
+			break;
+
+		case OpCode::Power:
+			if (a && b)
+			{
+				for (i = 0; i < count; ++i)
+					result[i] = pow(a[i], b[i]);
+			}
+			else if (a)
+			{
+				for (i = 0; i < count; ++i)
+					result[i] = pow(a[i], bValue);
+			}
+			else
+			{
+				for (i = 0; i < count; ++i)
+					result[i] = pow(aValue, b[i]);
+			}
+			break;
+
+		case OpCode::Square:
+			VectorKernels::Square(a, result, count);
+			break;
+
+		default:
+			ApplyFunction(instruction.code, a, result, count);
+		}
+	}
+}
+
+//==========================================================================
+// Class:			CompiledExpression
+// Function:		ApplyFunction
+//
+// Description:		Applies a function of one operand to an array.
+//
+// Input Arguments:
+//		code	= const OpCode&
+//		a		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*, may be a
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CompiledExpression::ApplyFunction(const OpCode &code, const double* a,
+	double* out, const size_t &count)
+{
+	size_t i;
+	switch (code)
+	{
+	case OpCode::Square:
+		for (i = 0; i < count; ++i)
+			out[i] = a[i] * a[i];
+		break;
+
+	case OpCode::SquareRoot:
+		for (i = 0; i < count; ++i)
+			out[i] = sqrt(a[i]);
+		break;
+
+	case OpCode::AbsoluteValue:
+		for (i = 0; i < count; ++i)
+			out[i] = fabs(a[i]);
+		break;
+
+	case OpCode::Exponential:
+		for (i = 0; i < count; ++i)
+			out[i] = exp(a[i]);
+		break;
+
+	case OpCode::NaturalLog:
+		for (i = 0; i < count; ++i)
+			out[i] = log(a[i]);
+		break;
+
+	case OpCode::Log10:
+		for (i = 0; i < count; ++i)
+			out[i] = log10(a[i]);
+		break;
+
+	case OpCode::Sine:
+		for (i = 0; i < count; ++i)
+			out[i] = sin(a[i]);
+		break;
+
+	case OpCode::Cosine:
+		for (i = 0; i < count; ++i)
+			out[i] = cos(a[i]);
+		break;
+
+	case OpCode::Tangent:
+		for (i = 0; i < count; ++i)
+			out[i] = tan(a[i]);
+		break;
+
+	case OpCode::ArcSine:
+		for (i = 0; i < count; ++i)
+			out[i] = asin(a[i]);
+		break;
+
+	case OpCode::ArcCosine:
+		for (i = 0; i < count; ++i)
+			out[i] = acos(a[i]);
+		break;
+
+	case OpCode::ArcTangent:
+		for (i = 0; i < count; ++i)
+			out[i] = atan(a[i]);
+		break;
+
+	default:
+		for (i = 0; i < count; ++i)
+			out[i] = a[i];
+	}
+}
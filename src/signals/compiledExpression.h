@@ -0,0 +1,173 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  compiledExpression.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  User-specified arithmetic on columns of data (e.g.
+//				 "[3]*[5]-sqrt([7])"), compiled once into a short list of array
+//				 operations which is run over blocks of rows in parallel.
+//				 Repeated subexpressions are computed once and constant operands
+//				 are folded into the operations that use them.
+// History:
+
+#ifndef COMPILED_EXPRESSION_H_
+#define COMPILED_EXPRESSION_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+
+// Local forward declarations
+class ThreadPool;
+
+// Element-wise expression compiled for evaluation over whole columns
+class CompiledExpression
+{
+public:
+	explicit CompiledExpression(ThreadPool &pool);
+
+	// [n] refers to column n, where column zero is time.  Supports + - * / ^,
+	// unary minus, parentheses, the constants pi and e, and sqrt, abs, exp,
+	// ln (or log), log10, sin, cos, tan, asin, acos and atan.  Returns false
+	// (with a description in error) if the expression can't be parsed.
+	bool Compile(const std::string &expression, std::string &error);
+
+	// Columns the expression refers to, in ascending order
+	const std::vector<unsigned int>& GetColumns() const { return mColumns; }
+
+	// Computes out[i] for i in [begin, end).  columns[n] must hold at least
+	// end values for every column n the expression refers to.
+	void Evaluate(const std::vector<const double*> &columns, const size_t &begin,
+		const size_t &end, double* out) const;
+
+	size_t GetInstructionCount() const { return mInstructions.size(); }
+
+private:
+	static const size_t mBlockSize;// [rows]
+	static const unsigned int mOutputRegister;
+
+	ThreadPool &mPool;
+
+	enum class OpCode
+	{
+		Copy,
+		ScaleAndOffset,// a * scale + offset
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Power,
+		Square,
+		SquareRoot,
+		AbsoluteValue,
+		Exponential,
+		NaturalLog,
+		Log10,
+		Sine,
+		Cosine,
+		Tangent,
+		ArcSine,
+		ArcCosine,
+		ArcTangent
+	};
+
+	struct Operand
+	{
+		enum class Type
+		{
+			Register,
+			Column,
+			Constant
+		};
+
+		Type type = Type::Constant;
+		unsigned int index = 0;// Register or column
+		double value = 0.0;// Constant only
+	};
+
+	// Operations have array operands, except that either operand of Copy,
+	// Divide and Power may be a constant
+	struct Instruction
+	{
+		OpCode code;
+		Operand a;
+		Operand b;// Binary operations only
+		double scale = 1.0;// ScaleAndOffset only
+		double offset = 0.0;
+		unsigned int out;// Register, or mOutputRegister
+	};
+
+	std::vector<Instruction> mInstructions;
+	unsigned int mRegisterCount = 0;// Each holds mBlockSize rows
+	std::vector<unsigned int> mColumns;
+
+	// Graph built while parsing; identical nodes are only stored once, so
+	// repeated subexpressions are shared
+	struct Node
+	{
+		enum class Type
+		{
+			Constant,
+			Column,
+			Operation
+		};
+
+		Type type;
+		OpCode code;
+		int a;// Operand nodes (-1 if unused)
+		int b;
+		double value;// Constant value or column number
+		double scale;// ScaleAndOffset only
+		double offset;
+	};
+
+	typedef std::tuple<int, int, int, int, double, double, double> NodeKey;
+
+	struct ParseState
+	{
+		explicit ParseState(const std::string &text) : text(text) {}
+
+		const std::string &text;
+		size_t position = 0;
+		std::vector<Node> nodes;
+		std::map<NodeKey, int> nodeIndices;
+		std::string error;
+	};
+
+	static int ParseSum(ParseState &state);
+	static int ParseProduct(ParseState &state);
+	static int ParseUnary(ParseState &state);
+	static int ParsePower(ParseState &state);
+	static int ParsePrimary(ParseState &state);
+	static bool SkipTo(ParseState &state, const char &c);
+	static bool FindFunction(const std::string &name, OpCode &code);
+
+	// These fold constants and combine scales and offsets as they go
+	static int AddConstant(ParseState &state, const double &value);
+	static int AddColumn(ParseState &state, const unsigned int &column);
+	static int AddUnary(ParseState &state, const OpCode &code, const int &a);
+	static int AddBinary(ParseState &state, const OpCode &code, const int &a, const int &b);
+	static int AddScaleAndOffset(ParseState &state, const int &a,
+		const double &scale, const double &offset);
+	static int AddNode(ParseState &state, const Node &node);
+
+	static double ApplyScalar(const OpCode &code, const double &a, const double &b);
+
+	void GenerateInstructions(const std::vector<Node> &nodes, const int &root);
+
+	void EvaluateBlock(const std::vector<const double*> &columns, const size_t &begin,
+		const size_t &end, double* out, double* registers) const;
+	static void ApplyFunction(const OpCode &code, const double* a, double* out,
+		const size_t &count);
+};
+
+#endif// COMPILED_EXPRESSION_H_
@@ -0,0 +1,197 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  realFFT.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Fast Fourier transform of real data with a fixed, power of two
+//				 length.  The twiddle factors and bit reversal permutation are
+//				 computed once, so one object can transform many windows (from
+//				 any number of threads).
+// History:
+
+// Standard C++ headers
+#include <cmath>
+#include <cassert>
+
+// Local headers
+#include "signals/realFFT.h"
+
+//==========================================================================
+// Class:			RealFFT
+// Function:		RealFFT
+//
+// Description:		Constructor for RealFFT class.
+//
+// Input Arguments:
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+RealFFT::RealFFT(const size_t &size) : mSize(size), mHalfSize(size / 2)
+{
+	assert(IsValidSize(size));
+	const double pi(4.0 * atan(1.0));// M_PI isn't standard
+
+	mTwiddles.resize(mHalfSize / 2);
+	size_t k;
+	for (k = 0; k < mTwiddles.size(); ++k)
+	{
+		const double angle(-2.0 * pi * k / mHalfSize);
+		mTwiddles[k] = std::complex<double>(cos(angle), sin(angle));
+	}
+
+	mSplitTwiddles.resize(mHalfSize / 2 + 1);
+	for (k = 0; k < mSplitTwiddles.size(); ++k)
+	{
+		const double angle(-2.0 * pi * k / mSize);
+		mSplitTwiddles[k] = std::complex<double>(cos(angle), sin(angle));
+	}
+
+	mBitReversed.resize(mHalfSize);
+	unsigned int bits(0);
+	while ((static_cast<size_t>(1) << bits) < mHalfSize)
+		++bits;
+	for (k = 0; k < mHalfSize; ++k)
+	{
+		size_t reversed(0);
+		unsigned int b;
+		for (b = 0; b < bits; ++b)
+			reversed |= ((k >> b) & 1) << (bits - 1 - b);
+		mBitReversed[k] = reversed;
+	}
+}
+
+//==========================================================================
+// Class:			RealFFT
+// Function:		IsValidSize
+//
+// Description:		Checks for a power of two of at least four.
+//
+// Input Arguments:
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool RealFFT::IsValidSize(const size_t &size)
+{
+	return size >= 4 && (size & (size - 1)) == 0;
+}
+
+//==========================================================================
+// Class:			RealFFT
+// Function:		Transform
+//
+// Description:		Transforms real data.  The even and odd samples are
+//					packed into the real and imaginary parts of a complex
+//					signal of half the length, and the two interleaved
+//					transforms are separated afterwards.
+//
+// Input Arguments:
+//		in	= const double*, GetSize() values
+//
+// Output Arguments:
+//		out	= std::complex<double>*, GetBinCount() values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RealFFT::Transform(const double* in, std::complex<double>* out) const
+{
+	size_t k;
+	for (k = 0; k < mHalfSize; ++k)
+		out[mBitReversed[k]] = std::complex<double>(in[2 * k], in[2 * k + 1]);
+
+	TransformComplex(out);
+
+	// With Z = FFT(z), the even and odd samples' transforms are
+	// E[k] = (Z[k] + conj(Z[N/2 - k])) / 2 and
+	// O[k] = -i (Z[k] - conj(Z[N/2 - k])) / 2, and X[k] = E[k] + W^k O[k]
+	const double z0Real(out[0].real());
+	const double z0Imaginary(out[0].imag());
+	out[0] = std::complex<double>(z0Real + z0Imaginary, 0.0);
+	out[mHalfSize] = std::complex<double>(z0Real - z0Imaginary, 0.0);
+
+	for (k = 1; k <= mHalfSize / 2; ++k)
+	{
+		const size_t j(mHalfSize - k);
+		const double aReal(out[k].real()), aImaginary(out[k].imag());
+		const double bReal(out[j].real()), bImaginary(-out[j].imag());// conj(Z[j])
+
+		const double evenReal(0.5 * (aReal + bReal));
+		const double evenImaginary(0.5 * (aImaginary + bImaginary));
+		const double oddReal(0.5 * (aImaginary - bImaginary));
+		const double oddImaginary(-0.5 * (aReal - bReal));
+
+		// X[k] = E + W^k O; X[N/2 - k] = conj(E) + W^(N/2 - k) conj(O), and
+		// W^(N/2 - k) = -conj(W^k)
+		const double wReal(mSplitTwiddles[k].real()), wImaginary(mSplitTwiddles[k].imag());
+		const double productReal(wReal * oddReal - wImaginary * oddImaginary);
+		const double productImaginary(wReal * oddImaginary + wImaginary * oddReal);
+		out[k] = std::complex<double>(evenReal + productReal, evenImaginary + productImaginary);
+		out[j] = std::complex<double>(evenReal - productReal, productImaginary - evenImaginary);
+	}
+}
+
+//==========================================================================
+// Class:			RealFFT
+// Function:		TransformComplex
+//
+// Description:		In-place radix-2 decimation in time transform of
+//					mHalfSize values, which must already be in bit reversed
+//					order.
+//
+// Input Arguments:
+//		data	= std::complex<double>*
+//
+// Output Arguments:
+//		data	= std::complex<double>*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void RealFFT::TransformComplex(std::complex<double>* data) const
+{
+	// Written out in real arithmetic; std::complex multiplication checks for
+	// infinities, which is much slower
+	size_t length;
+	for (length = 2; length <= mHalfSize; length <<= 1)
+	{
+		const size_t half(length / 2);
+		const size_t stride(mHalfSize / length);
+		size_t start;
+		for (start = 0; start < mHalfSize; start += length)
+		{
+			size_t j;
+			for (j = 0; j < half; ++j)
+			{
+				const std::complex<double>& w(mTwiddles[j * stride]);
+				std::complex<double>& a(data[start + j]);
+				std::complex<double>& b(data[start + j + half]);
+				const double vReal(b.real() * w.real() - b.imag() * w.imag());
+				const double vImaginary(b.real() * w.imag() + b.imag() * w.real());
+				const double uReal(a.real()), uImaginary(a.imag());
+				a = std::complex<double>(uReal + vReal, uImaginary + vImaginary);
+				b = std::complex<double>(uReal - vReal, uImaginary - vImaginary);
+			}
+		}
+	}
+}
@@ -0,0 +1,54 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  realFFT.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Fast Fourier transform of real data with a fixed, power of two
+//				 length.  The twiddle factors and bit reversal permutation are
+//				 computed once, so one object can transform many windows (from
+//				 any number of threads).
+// History:
+
+#ifndef REAL_FFT_H_
+#define REAL_FFT_H_
+
+// Standard C++ headers
+#include <vector>
+#include <complex>
+
+// Reusable transform plan
+class RealFFT
+{
+public:
+	// size must be a power of two, and at least four
+	explicit RealFFT(const size_t &size);
+
+	static bool IsValidSize(const size_t &size);
+
+	size_t GetSize() const { return mSize; }
+	size_t GetBinCount() const { return mSize / 2 + 1; }
+
+	// Computes the non-negative frequency half of the transform of size input
+	// values.  out must hold GetBinCount() values, and is also used as the
+	// working space, so no memory is allocated.
+	void Transform(const double* in, std::complex<double>* out) const;
+
+private:
+	const size_t mSize;
+	const size_t mHalfSize;// Length of the complex transform we actually do
+
+	std::vector<std::complex<double>> mTwiddles;// exp(-2 pi i k / mHalfSize), k < mHalfSize / 2
+	std::vector<std::complex<double>> mSplitTwiddles;// exp(-2 pi i k / mSize), k <= mHalfSize / 2
+	std::vector<size_t> mBitReversed;
+
+	void TransformComplex(std::complex<double>* data) const;
+};
+
+#endif// REAL_FFT_H_
@@ -0,0 +1,197 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  resampler.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Computes the values of one signal at the sample times of another
+//				 (possibly recorded with different time units), so that curves
+//				 from different files can be combined.  Blocks of samples are
+//				 processed in parallel; within a block the source samples are
+//				 located first and the interpolation is done with VectorKernels.
+// History:
+
+// Standard C++ headers
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+// Local headers
+#include "signals/resampler.h"
+#include "signals/vectorKernels.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			Resampler
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for Resampler class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t Resampler::mBlockSize(2048);// [samples]
+
+//==========================================================================
+// Class:			Resampler
+// Function:		Resampler
+//
+// Description:		Constructor for Resampler class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Resampler::Resampler(ThreadPool &pool) : mPool(pool)
+{
+}
+
+//==========================================================================
+// Class:			Resampler
+// Function:		Resample
+//
+// Description:		Computes the source signal's value at each target time.
+//
+// Input Arguments:
+//		sourceTime		= const double*
+//		sourceValues	= const double*
+//		sourceCount		= const size_t&
+//		targetTime		= const double*
+//		targetCount		= const size_t&
+//		timeScale		= const double&, source time units per target unit
+//		method			= const Method&
+//
+// Output Arguments:
+//		out				= double*, targetCount values
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Resampler::Resample(const double* sourceTime, const double* sourceValues,
+	const size_t &sourceCount, const double* targetTime, const size_t &targetCount,
+	const double &timeScale, const Method &method, double* out) const
+{
+	PerfMonitor::ScopedTimer timer("Resample");
+
+	mPool.ParallelFor(targetCount, mBlockSize, [sourceTime, sourceValues, &sourceCount,
+		targetTime, &timeScale, &method, out](const size_t &begin, const size_t &end)
+	{
+		std::vector<double> scratch(4 * mBlockSize);
+		size_t blockBegin;
+		for (blockBegin = begin; blockBegin < end; blockBegin += mBlockSize)
+			ResampleBlock(sourceTime, sourceValues, sourceCount, targetTime + blockBegin,
+				std::min(mBlockSize, end - blockBegin), timeScale, method,
+				out + blockBegin, scratch.data());
+	});
+}
+
+//==========================================================================
+// Class:			Resampler
+// Function:		ResampleBlock
+//
+// Description:		Resamples one block.  Consecutive target times usually
+//					fall on the same or nearby source samples, so each search
+//					starts from the previous result.  The samples either side
+//					of each target time are gathered into arrays, so the
+//					interpolation itself is a handful of vector operations.
+//
+// Input Arguments:
+//		sourceTime		= const double*
+//		sourceValues	= const double*
+//		sourceCount		= const size_t&
+//		targetTime		= const double*
+//		count			= const size_t&
+//		timeScale		= const double&
+//		method			= const Method&
+//		scratch			= double*, 4 * count values
+//
+// Output Arguments:
+//		out				= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Resampler::ResampleBlock(const double* sourceTime, const double* sourceValues,
+	const size_t &sourceCount, const double* targetTime, const size_t &count,
+	const double &timeScale, const Method &method, double* out, double* scratch)
+{
+	const double nan(std::numeric_limits<double>::quiet_NaN());
+	double* t(scratch);
+	double* t0(scratch + count);
+	double* t1(scratch + 2 * count);
+	double* y1(scratch + 3 * count);
+	VectorKernels::ScaleAndOffset(targetTime, timeScale, 0.0, t, count);
+
+	const bool interpolate(method == Method::Linear);
+	const double first(sourceCount > 0 ? sourceTime[0] : nan);
+	const double last(sourceCount > 0 ? sourceTime[sourceCount - 1] : nan);
+	size_t i(0);// Last source sample at or before t[k]
+	bool located(false);
+	size_t k;
+	for (k = 0; k < count; ++k)
+	{
+		// The interpolation below turns these into y0 (which may be NaN)
+		t0[k] = 0.0;
+		t1[k] = 1.0;
+
+		if (!(t[k] >= first && t[k] <= last))// Also catches NaN
+		{
+			out[k] = nan;
+			y1[k] = nan;
+			continue;
+		}
+		else if (!located || t[k] < sourceTime[i])
+		{
+			i = std::upper_bound(sourceTime, sourceTime + sourceCount, t[k]) - sourceTime - 1;
+			located = true;
+		}
+		else
+		{
+			while (i + 1 < sourceCount && sourceTime[i + 1] <= t[k])
+				++i;
+		}
+
+		out[k] = sourceValues[i];
+		if (!interpolate || i + 1 == sourceCount)
+			y1[k] = out[k];
+		else
+		{
+			t0[k] = sourceTime[i];
+			t1[k] = sourceTime[i + 1];
+			y1[k] = sourceValues[i + 1];
+		}
+	}
+
+	if (!interpolate)
+		return;
+
+	// out = y0 + (t - t0) / (t1 - t0) * (y1 - y0)
+	VectorKernels::Subtract(t, t0, t, count);
+	VectorKernels::Subtract(t1, t0, t1, count);
+	VectorKernels::Divide(t, t1, t, count);
+	VectorKernels::Subtract(y1, out, y1, count);
+	VectorKernels::Multiply(t, y1, t, count);
+	VectorKernels::Add(out, t, out, count);
+}
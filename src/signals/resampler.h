@@ -0,0 +1,60 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  resampler.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Computes the values of one signal at the sample times of another
+//				 (possibly recorded with different time units), so that curves
+//				 from different files can be combined.  Blocks of samples are
+//				 processed in parallel; within a block the source samples are
+//				 located first and the interpolation is done with VectorKernels.
+// History:
+
+#ifndef RESAMPLER_H_
+#define RESAMPLER_H_
+
+// Standard C++ headers
+#include <cstddef>
+
+// Local forward declarations
+class ThreadPool;
+
+// Parallel resampling onto a different time base
+class Resampler
+{
+public:
+	explicit Resampler(ThreadPool &pool);
+
+	enum class Method
+	{
+		Linear,
+		ZeroOrderHold// Most recent sample
+	};
+
+	// Computes the source signal's value at each target time.  timeScale
+	// converts target times to the source's time units.  Source times must be
+	// increasing; target times are usually increasing too, but needn't be.
+	// Times outside the range of the source's times give NaN.
+	void Resample(const double* sourceTime, const double* sourceValues,
+		const size_t &sourceCount, const double* targetTime, const size_t &targetCount,
+		const double &timeScale, const Method &method, double* out) const;
+
+private:
+	static const size_t mBlockSize;// [samples]
+
+	ThreadPool &mPool;
+
+	// scratch must hold 4 * count values
+	static void ResampleBlock(const double* sourceTime, const double* sourceValues,
+		const size_t &sourceCount, const double* targetTime, const size_t &count,
+		const double &timeScale, const Method &method, double* out, double* scratch);
+};
+
+#endif// RESAMPLER_H_
@@ -0,0 +1,624 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  signalOperations.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Derivative, integral, RMS and element-wise operations on
+//				 Dataset2D objects, built on VectorKernels.  Long curves are
+//				 split among the pool's threads, and lists of curves are
+//				 processed concurrently.
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+#include <cstring>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Local headers
+#include "signals/signalOperations.h"
+#include "signals/vectorKernels.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for SignalOperations class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t SignalOperations::mBlockSize(1 << 16);
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		SignalOperations
+//
+// Description:		Constructor for SignalOperations class.
+//
+// Input Arguments:
+//		pool	= ThreadPool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SignalOperations::SignalOperations(ThreadPool &pool) : mPool(pool)
+{
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Apply
+//
+// Description:		Applies the operation to every curve.  Each curve is
+//					its own pool task (and long curves are split further).
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		curves		= const std::vector<const LibPlot2D::Dataset2D*>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<std::unique_ptr<LibPlot2D::Dataset2D>>, in the same order
+//
+//==========================================================================
+std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> SignalOperations::Apply(
+	const Operation &operation,
+	const std::vector<const LibPlot2D::Dataset2D*> &curves) const
+{
+	std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> results(curves.size());
+	mPool.ParallelFor(curves.size(), 1, [this, &operation, &curves, &results](
+		const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+			results[i] = Apply(operation, *curves[i]);
+	});
+
+	return results;
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Apply
+//
+// Description:		Applies the operation to one curve.
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		data		= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Apply(
+	const Operation &operation, const LibPlot2D::Dataset2D &data) const
+{
+	const unsigned int count(data.GetNumberOfPoints());
+	std::unique_ptr<LibPlot2D::Dataset2D> result(new LibPlot2D::Dataset2D(count));
+	const double* x(data.GetXPointer());
+	double* resultX(result->GetXPointer());
+	ForEachBlock(count, [x, resultX](const size_t &begin, const size_t &end)
+	{
+		memcpy(resultX + begin, x + begin, sizeof(double) * (end - begin));
+	});
+
+	Apply(operation, ArrayData{ x, data.GetYPointer(), count, result->GetYPointer() });
+	return result;
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Apply
+//
+// Description:		Applies the operation to every set of arrays.  Each is
+//					its own pool task (and long ones are split further).
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		curves		= const std::vector<ArrayData>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::Apply(const Operation &operation,
+	const std::vector<ArrayData> &curves) const
+{
+	mPool.ParallelFor(curves.size(), 1, [this, &operation, &curves](
+		const size_t &begin, const size_t &end)
+	{
+		size_t i;
+		for (i = begin; i < end; ++i)
+			Apply(operation, curves[i]);
+	});
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Apply
+//
+// Description:		Applies the operation to one set of arrays.
+//
+// Input Arguments:
+//		operation	= const Operation&
+//		data		= const ArrayData&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::Apply(const Operation &operation, const ArrayData &data) const
+{
+	switch (operation)
+	{
+	case Operation::Derivative:
+		Derivative(data);
+		break;
+
+	case Operation::Integral:
+		Integral(data);
+		break;
+
+	case Operation::RootMeanSquare:
+		RootMeanSquare(data);
+		break;
+	}
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Derivative
+//
+// Description:		Computes the derivative of the curve.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Derivative(
+	const LibPlot2D::Dataset2D &data) const
+{
+	return Apply(Operation::Derivative, data);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Integral
+//
+// Description:		Computes the running integral of the curve.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Integral(
+	const LibPlot2D::Dataset2D &data) const
+{
+	return Apply(Operation::Integral, data);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		RootMeanSquare
+//
+// Description:		Computes the running RMS of the curve.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::RootMeanSquare(
+	const LibPlot2D::Dataset2D &data) const
+{
+	return Apply(Operation::RootMeanSquare, data);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Derivative
+//
+// Description:		Computes the derivative of a curve held in arrays.
+//
+// Input Arguments:
+//		data	= const ArrayData&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::Derivative(const ArrayData &data) const
+{
+	PerfMonitor::ScopedTimer timer("Derivative");
+
+	if (data.count < 2)
+	{
+		std::fill(data.result, data.result + data.count, 0.0);
+		return;
+	}
+
+	// Slope j (between points j and j + 1) is stored at j + 1
+	ForEachBlock(data.count, [&data](const size_t &begin, const size_t &end)
+	{
+		const size_t lastSlope(std::min<size_t>(end, data.count - 1));
+		if (lastSlope > begin)
+			VectorKernels::Difference(data.x + begin, data.y + begin,
+				data.result + begin + 1, lastSlope - begin + 1);
+	});
+
+	data.result[0] = data.result[1];
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Integral
+//
+// Description:		Computes the running integral of a curve held in arrays.
+//
+// Input Arguments:
+//		data	= const ArrayData&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::Integral(const ArrayData &data) const
+{
+	PerfMonitor::ScopedTimer timer("Integral");
+
+	if (data.count == 0)
+		return;
+
+	// Area j (between points j and j + 1) is stored at j + 1, then summed
+	data.result[0] = 0.0;
+	PrefixSum(data.result + 1, data.count - 1, [&data](const size_t &begin, const size_t &end)
+	{
+		VectorKernels::TrapezoidAreas(data.x + begin, data.y + begin,
+			data.result + 1 + begin, end - begin + 1);
+	}, nullptr);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		RootMeanSquare
+//
+// Description:		Computes the running RMS of a curve held in arrays.
+//
+// Input Arguments:
+//		data	= const ArrayData&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::RootMeanSquare(const ArrayData &data) const
+{
+	PerfMonitor::ScopedTimer timer("RMS");
+
+	PrefixSum(data.result, data.count, [&data](const size_t &begin, const size_t &end)
+	{
+		VectorKernels::Square(data.y + begin, data.result + begin, end - begin);
+	}, [&data](const size_t &begin, const size_t &end)
+	{
+		VectorKernels::RootMeanOfSums(data.result + begin, begin,
+			data.result + begin, end - begin);
+	});
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Add
+//
+// Description:		Element-wise sum.
+//
+// Input Arguments:
+//		a	= const LibPlot2D::Dataset2D&
+//		b	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Add(
+	const LibPlot2D::Dataset2D &a, const LibPlot2D::Dataset2D &b) const
+{
+	return Combine(&VectorKernels::Add, a, b);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Subtract
+//
+// Description:		Element-wise difference.
+//
+// Input Arguments:
+//		a	= const LibPlot2D::Dataset2D&
+//		b	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Subtract(
+	const LibPlot2D::Dataset2D &a, const LibPlot2D::Dataset2D &b) const
+{
+	return Combine(&VectorKernels::Subtract, a, b);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Multiply
+//
+// Description:		Element-wise product.
+//
+// Input Arguments:
+//		a	= const LibPlot2D::Dataset2D&
+//		b	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Multiply(
+	const LibPlot2D::Dataset2D &a, const LibPlot2D::Dataset2D &b) const
+{
+	return Combine(&VectorKernels::Multiply, a, b);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Divide
+//
+// Description:		Element-wise quotient.
+//
+// Input Arguments:
+//		a	= const LibPlot2D::Dataset2D&
+//		b	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Divide(
+	const LibPlot2D::Dataset2D &a, const LibPlot2D::Dataset2D &b) const
+{
+	return Combine(&VectorKernels::Divide, a, b);
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		ScaleAndOffset
+//
+// Description:		Computes y * scale + offset.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//		scale	= const double&
+//		offset	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::ScaleAndOffset(
+	const LibPlot2D::Dataset2D &data, const double &scale, const double &offset) const
+{
+	const unsigned int count(data.GetNumberOfPoints());
+	std::unique_ptr<LibPlot2D::Dataset2D> result(new LibPlot2D::Dataset2D(count));
+	const double* x(data.GetXPointer());
+	const double* y(data.GetYPointer());
+	double* resultX(result->GetXPointer());
+	double* resultY(result->GetYPointer());
+
+	ForEachBlock(count, [x, y, resultX, resultY, &scale, &offset](
+		const size_t &begin, const size_t &end)
+	{
+		memcpy(resultX + begin, x + begin, sizeof(double) * (end - begin));
+		VectorKernels::ScaleAndOffset(y + begin, scale, offset, resultY + begin, end - begin);
+	});
+
+	return result;
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		Combine
+//
+// Description:		Applies an element-wise kernel to the y-data of two
+//					curves.
+//
+// Input Arguments:
+//		kernel	= const BinaryKernel&
+//		a		= const LibPlot2D::Dataset2D&
+//		b		= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>, nullptr if the sizes differ
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SignalOperations::Combine(
+	const BinaryKernel &kernel, const LibPlot2D::Dataset2D &a,
+	const LibPlot2D::Dataset2D &b) const
+{
+	PerfMonitor::ScopedTimer timer("Element-wise operation");
+
+	const unsigned int count(a.GetNumberOfPoints());
+	if (b.GetNumberOfPoints() != count)
+		return nullptr;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> result(new LibPlot2D::Dataset2D(count));
+	const double* x(a.GetXPointer());
+	const double* yA(a.GetYPointer());
+	const double* yB(b.GetYPointer());
+	double* resultX(result->GetXPointer());
+	double* resultY(result->GetYPointer());
+
+	ForEachBlock(count, [&kernel, x, yA, yB, resultX, resultY](
+		const size_t &begin, const size_t &end)
+	{
+		memcpy(resultX + begin, x + begin, sizeof(double) * (end - begin));
+		kernel(yA + begin, yB + begin, resultY + begin, end - begin);
+	});
+
+	return result;
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		ForEachBlock
+//
+// Description:		Calls function(begin, end) for each block of [0, count)
+//					on the pool.
+//
+// Input Arguments:
+//		count		= const size_t&
+//		function	= const BlockFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::ForEachBlock(const size_t &count,
+	const BlockFunction &function) const
+{
+	const size_t blockCount((count + mBlockSize - 1) / mBlockSize);
+	mPool.ParallelFor(blockCount, 1, [&function, count](const size_t &begin, const size_t &end)
+	{
+		size_t block;
+		for (block = begin; block < end; ++block)
+			function(block * mBlockSize, std::min(count, (block + 1) * mBlockSize));
+	});
+}
+
+//==========================================================================
+// Class:			SignalOperations
+// Function:		PrefixSum
+//
+// Description:		Fills values (block by block, in parallel) and replaces
+//					them with their running sum.  Each block is summed on
+//					its own first; once the block totals are known, the
+//					total of all preceding blocks is added to each block
+//					(again in parallel) and finish is called on it.
+//
+// Input Arguments:
+//		values	= double*
+//		count	= const size_t&
+//		fill	= const BlockFunction&, writes values [begin, end)
+//		finish	= const BlockFunction&, may be empty
+//
+// Output Arguments:
+//		values	= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SignalOperations::PrefixSum(double* values, const size_t &count,
+	const BlockFunction &fill, const BlockFunction &finish) const
+{
+	const size_t blockCount((count + mBlockSize - 1) / mBlockSize);
+	std::vector<double> offsets(blockCount);
+	ForEachBlock(count, [values, &fill, &offsets](const size_t &begin, const size_t &end)
+	{
+		fill(begin, end);
+		offsets[begin / mBlockSize] = VectorKernels::PrefixSum(values + begin, 0.0, end - begin);
+	});
+
+	double total(0.0);
+	for (auto& offset : offsets)
+	{
+		const double blockTotal(offset);
+		offset = total;
+		total += blockTotal;
+	}
+
+	ForEachBlock(count, [values, &finish, &offsets](const size_t &begin, const size_t &end)
+	{
+		const double offset(offsets[begin / mBlockSize]);
+		if (offset != 0.0)
+			VectorKernels::AddOffset(values + begin, offset, end - begin);
+		if (finish)
+			finish(begin, end);
+	});
+}
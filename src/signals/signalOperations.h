@@ -0,0 +1,113 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  signalOperations.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Derivative, integral, RMS and element-wise operations on
+//				 Dataset2D objects (the first three also on plain arrays),
+//				 built on VectorKernels.  Long curves are
+//				 split among the pool's threads, and lists of curves are
+//				 processed concurrently.
+// History:
+
+#ifndef SIGNAL_OPERATIONS_H_
+#define SIGNAL_OPERATIONS_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <functional>
+
+// Local forward declarations
+class ThreadPool;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Parallel signal operations
+class SignalOperations
+{
+public:
+	explicit SignalOperations(ThreadPool &pool);
+
+	enum class Operation
+	{
+		Derivative,
+		Integral,
+		RootMeanSquare
+	};
+
+	// Applies the operation to every curve, concurrently
+	std::vector<std::unique_ptr<LibPlot2D::Dataset2D>> Apply(const Operation &operation,
+		const std::vector<const LibPlot2D::Dataset2D*> &curves) const;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> Apply(const Operation &operation,
+		const LibPlot2D::Dataset2D &data) const;
+
+	// Curves held in plain arrays (e.g. columns of mapped files):  x and y
+	// hold count values, and result receives the count y-values
+	struct ArrayData
+	{
+		const double* x;
+		const double* y;
+		size_t count;
+		double* result;
+	};
+
+	void Apply(const Operation &operation, const std::vector<ArrayData> &curves) const;
+	void Apply(const Operation &operation, const ArrayData &data) const;
+
+	// Backward differences; the first point uses the first forward difference
+	std::unique_ptr<LibPlot2D::Dataset2D> Derivative(const LibPlot2D::Dataset2D &data) const;
+
+	// Cumulative trapezoidal integral, starting from zero
+	std::unique_ptr<LibPlot2D::Dataset2D> Integral(const LibPlot2D::Dataset2D &data) const;
+
+	// RMS of all points up to and including each point
+	std::unique_ptr<LibPlot2D::Dataset2D> RootMeanSquare(const LibPlot2D::Dataset2D &data) const;
+
+	// Element-wise on the y-data, keeping a's x-data.  Returns nullptr if the
+	// curves have different numbers of points.
+	std::unique_ptr<LibPlot2D::Dataset2D> Add(const LibPlot2D::Dataset2D &a,
+		const LibPlot2D::Dataset2D &b) const;
+	std::unique_ptr<LibPlot2D::Dataset2D> Subtract(const LibPlot2D::Dataset2D &a,
+		const LibPlot2D::Dataset2D &b) const;
+	std::unique_ptr<LibPlot2D::Dataset2D> Multiply(const LibPlot2D::Dataset2D &a,
+		const LibPlot2D::Dataset2D &b) const;
+	std::unique_ptr<LibPlot2D::Dataset2D> Divide(const LibPlot2D::Dataset2D &a,
+		const LibPlot2D::Dataset2D &b) const;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> ScaleAndOffset(const LibPlot2D::Dataset2D &data,
+		const double &scale, const double &offset) const;
+
+private:
+	static const size_t mBlockSize;
+
+	ThreadPool &mPool;
+
+	typedef std::function<void(const size_t&, const size_t&)> BlockFunction;
+	typedef void (*BinaryKernel)(const double*, const double*, double*, const size_t&);
+
+	void ForEachBlock(const size_t &count, const BlockFunction &function) const;
+	void PrefixSum(double* values, const size_t &count, const BlockFunction &fill,
+		const BlockFunction &finish) const;
+
+	void Derivative(const ArrayData &data) const;
+	void Integral(const ArrayData &data) const;
+	void RootMeanSquare(const ArrayData &data) const;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> Combine(const BinaryKernel &kernel,
+		const LibPlot2D::Dataset2D &a, const LibPlot2D::Dataset2D &b) const;
+};
+
+#endif// SIGNAL_OPERATIONS_H_
@@ -0,0 +1,457 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  spectralAnalysis.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Averaged power spectral density (Welch's method) and
+//				 spectrograms of long signals.  The signal is read one window
+//				 at a time, so the working memory depends on the window size
+//				 and thread count rather than the signal length.  Groups of
+//				 windows are transformed in parallel.
+// History:
+
+// Standard C++ headers
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <cstring>
+
+// LibPlot2D headers
+#include <lp2d/utilities/dataset2D.h>
+
+// Local headers
+#include "signals/spectralAnalysis.h"
+#include "signals/realFFT.h"
+#include "utilities/threadPool.h"
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for SpectralAnalysis class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t SpectralAnalysis::defaultWindowSize(4096);// [samples]
+const double SpectralAnalysis::defaultOverlap(0.5);
+const size_t SpectralAnalysis::defaultSliceCount(512);
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		SpectralAnalysis
+//
+// Description:		Constructor for SpectralAnalysis class.
+//
+// Input Arguments:
+//		pool		= ThreadPool&
+//		windowSize	= const size_t&
+//		overlap		= const double&, fraction of the window in [0, 1)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SpectralAnalysis::SpectralAnalysis(ThreadPool &pool, const size_t &windowSize,
+	const double &overlap) : mPool(pool), mWindowSize(RealFFT::IsValidSize(windowSize) ?
+	windowSize : defaultWindowSize), mOverlap(std::max(0.0, std::min(overlap, 0.95)))
+{
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		PowerSpectralDensity
+//
+// Description:		Computes the averaged PSD of a curve.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::unique_ptr<LibPlot2D::Dataset2D>, x-data in Hz
+//
+//==========================================================================
+std::unique_ptr<LibPlot2D::Dataset2D> SpectralAnalysis::PowerSpectralDensity(
+	const LibPlot2D::Dataset2D &data) const
+{
+	std::vector<double> frequency, density;
+	if (!PowerSpectralDensity(data.GetYPointer(), data.GetNumberOfPoints(),
+		GetSampleRate(data), frequency, density))
+		return nullptr;
+
+	std::unique_ptr<LibPlot2D::Dataset2D> result(
+		new LibPlot2D::Dataset2D(static_cast<unsigned int>(frequency.size())));
+	memcpy(result->GetXPointer(), frequency.data(), sizeof(double) * frequency.size());
+	memcpy(result->GetYPointer(), density.data(), sizeof(double) * density.size());
+	return result;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		PowerSpectralDensity
+//
+// Description:		Computes the averaged PSD with Welch's method.  The
+//					segments are split into a few groups per thread; each
+//					group's periodograms are summed separately and the group
+//					sums are added at the end, so the result does not depend
+//					on the order in which the threads finish.
+//
+// Input Arguments:
+//		values		= const double*
+//		count		= const size_t&
+//		sampleRate	= const double& [Hz]
+//
+// Output Arguments:
+//		frequency	= std::vector<double>& [Hz]
+//		density		= std::vector<double>& [units^2/Hz]
+//
+// Return Value:
+//		bool, false if there are too few values or the sample rate is invalid
+//
+//==========================================================================
+bool SpectralAnalysis::PowerSpectralDensity(const double* values, const size_t &count,
+	const double &sampleRate, std::vector<double> &frequency,
+	std::vector<double> &density) const
+{
+	PerfMonitor::ScopedTimer timer("PSD");
+
+	const size_t windowSize(GetWindowSize(count));
+	if (windowSize == 0 || !(sampleRate > 0.0))
+		return false;
+
+	const Plan plan(windowSize, mOverlap);
+	const size_t binCount(plan.fft->GetBinCount());
+	const size_t segmentCount(GetSegmentCount(count, plan));
+	const size_t groupCount(std::min<size_t>(segmentCount, 4 * (mPool.GetThreadCount() + 1)));
+
+	std::vector<double> sums(groupCount * binCount, 0.0);
+	SumPeriodograms(values, segmentCount, groupCount, plan, sums.data());
+
+	density.assign(sums.begin(), sums.begin() + binCount);
+	size_t group;
+	for (group = 1; group < groupCount; ++group)
+	{
+		const double* groupSums(sums.data() + group * binCount);
+		size_t k;
+		for (k = 0; k < binCount; ++k)
+			density[k] += groupSums[k];
+	}
+
+	ScaleDensity(density.data(), binCount, 1.0 / (sampleRate * plan.windowPower * segmentCount));
+	GetFrequencies(plan, sampleRate, frequency);
+	return true;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		ComputeSpectrogram
+//
+// Description:		Computes the averaged PSD of each of up to sliceCount
+//					consecutive runs of segments.  Each slice is computed by
+//					one thread, straight into its row of the result.
+//
+// Input Arguments:
+//		values		= const double*
+//		count		= const size_t&
+//		sampleRate	= const double& [Hz]
+//		sliceCount	= const size_t&
+//
+// Output Arguments:
+//		result		= Spectrogram&
+//
+// Return Value:
+//		bool, false if there are too few values or the sample rate is invalid
+//
+//==========================================================================
+bool SpectralAnalysis::ComputeSpectrogram(const double* values, const size_t &count,
+	const double &sampleRate, const size_t &sliceCount, Spectrogram &result) const
+{
+	PerfMonitor::ScopedTimer timer("Spectrogram");
+
+	const size_t windowSize(GetWindowSize(count));
+	if (windowSize == 0 || !(sampleRate > 0.0) || sliceCount == 0)
+		return false;
+
+	const Plan plan(windowSize, mOverlap);
+	const size_t binCount(plan.fft->GetBinCount());
+	const size_t segmentCount(GetSegmentCount(count, plan));
+	const size_t slices(std::min(sliceCount, segmentCount));
+
+	result.density.assign(slices * binCount, 0.0);
+	SumPeriodograms(values, segmentCount, slices, plan, result.density.data());
+
+	result.time.resize(slices);
+	size_t slice;
+	for (slice = 0; slice < slices; ++slice)
+	{
+		const size_t first(segmentCount * slice / slices);
+		const size_t last(segmentCount * (slice + 1) / slices);
+		ScaleDensity(result.density.data() + slice * binCount, binCount,
+			1.0 / (sampleRate * plan.windowPower * (last - first)));
+
+		const double firstSample(static_cast<double>(first * plan.step));
+		const double lastSample(static_cast<double>((last - 1) * plan.step + windowSize));
+		result.time[slice] = 0.5 * (firstSample + lastSample) / sampleRate;
+	}
+
+	GetFrequencies(plan, sampleRate, result.frequency);
+	return true;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		GetSampleRate
+//
+// Description:		Computes the average sample rate of a curve.
+//
+// Input Arguments:
+//		data	= const LibPlot2D::Dataset2D&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double [Hz]
+//
+//==========================================================================
+double SpectralAnalysis::GetSampleRate(const LibPlot2D::Dataset2D &data)
+{
+	const unsigned int count(data.GetNumberOfPoints());
+	if (count < 2 || !(data.GetXData(count - 1) > data.GetXData(0)))
+		return 0.0;
+	return (count - 1) / (data.GetXData(count - 1) - data.GetXData(0));
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		GetWindowSize
+//
+// Description:		Returns the segment length to use for a signal, which
+//					is reduced (to a smaller power of two) if the signal is
+//					shorter than one window.
+//
+// Input Arguments:
+//		count	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t, zero if the signal is too short
+//
+//==========================================================================
+size_t SpectralAnalysis::GetWindowSize(const size_t &count) const
+{
+	size_t windowSize(mWindowSize);
+	while (windowSize > count && RealFFT::IsValidSize(windowSize / 2))
+		windowSize /= 2;
+
+	return windowSize <= count ? windowSize : 0;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		GetSegmentCount
+//
+// Description:		Returns the number of whole segments in the signal.
+//
+// Input Arguments:
+//		count	= const size_t&, at least the window size
+//		plan	= const Plan&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t SpectralAnalysis::GetSegmentCount(const size_t &count, const Plan &plan) const
+{
+	return (count - plan.fft->GetSize()) / plan.step + 1;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		SumPeriodograms
+//
+// Description:		Divides the segments into groupCount runs and sums the
+//					squared magnitude of each run's transforms.  Each thread
+//					allocates one segment's worth of working space.
+//
+// Input Arguments:
+//		values			= const double*
+//		segmentCount	= const size_t&
+//		groupCount		= const size_t&
+//		plan			= const Plan&
+//
+// Output Arguments:
+//		sums			= double*, groupCount rows of bins, initially zero
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SpectralAnalysis::SumPeriodograms(const double* values, const size_t &segmentCount,
+	const size_t &groupCount, const Plan &plan, double* sums) const
+{
+	const size_t windowSize(plan.fft->GetSize());
+	const size_t binCount(plan.fft->GetBinCount());
+	mPool.ParallelFor(groupCount, 1, [values, &segmentCount, &groupCount, &plan, sums,
+		windowSize, binCount](const size_t &begin, const size_t &end)
+	{
+		std::vector<double> segment(windowSize);
+		std::vector<std::complex<double>> transform(binCount);
+		size_t group;
+		for (group = begin; group < end; ++group)
+		{
+			double* groupSums(sums + group * binCount);
+			const size_t last(segmentCount * (group + 1) / groupCount);
+			size_t s;
+			for (s = segmentCount * group / groupCount; s < last; ++s)
+			{
+				const double* start(values + s * plan.step);
+				double mean(0.0);
+				size_t i;
+				for (i = 0; i < windowSize; ++i)
+					mean += start[i];
+				mean /= windowSize;
+
+				for (i = 0; i < windowSize; ++i)
+					segment[i] = (start[i] - mean) * plan.window[i];
+
+				plan.fft->Transform(segment.data(), transform.data());
+				size_t k;
+				for (k = 0; k < binCount; ++k)
+					groupSums[k] += transform[k].real() * transform[k].real()
+						+ transform[k].imag() * transform[k].imag();
+			}
+		}
+	});
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		ScaleDensity
+//
+// Description:		Turns summed periodograms into a one-sided density.
+//					Every bin but the first and last stands for a positive
+//					and a negative frequency, so is doubled.
+//
+// Input Arguments:
+//		sums		= double*
+//		binCount	= const size_t&
+//		scale		= const double&
+//
+// Output Arguments:
+//		sums		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SpectralAnalysis::ScaleDensity(double* sums, const size_t &binCount,
+	const double &scale)
+{
+	size_t k;
+	for (k = 0; k < binCount; ++k)
+		sums[k] *= (k == 0 || k == binCount - 1) ? scale : 2.0 * scale;
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis
+// Function:		GetFrequencies
+//
+// Description:		Returns the frequency of each bin.
+//
+// Input Arguments:
+//		plan		= const Plan&
+//		sampleRate	= const double& [Hz]
+//
+// Output Arguments:
+//		frequency	= std::vector<double>& [Hz]
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SpectralAnalysis::GetFrequencies(const Plan &plan, const double &sampleRate,
+	std::vector<double> &frequency)
+{
+	frequency.resize(plan.fft->GetBinCount());
+	size_t k;
+	for (k = 0; k < frequency.size(); ++k)
+		frequency[k] = k * sampleRate / plan.fft->GetSize();
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis::Plan
+// Function:		Plan
+//
+// Description:		Constructor for Plan struct.  Prepares the transform and
+//					the (periodic) Hann window.
+//
+// Input Arguments:
+//		size	= const size_t&
+//		overlap	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SpectralAnalysis::Plan::Plan(const size_t &size, const double &overlap)
+	: fft(new RealFFT(size)), window(size), windowPower(0.0),
+	step(std::max<size_t>(1, static_cast<size_t>(size * (1.0 - overlap) + 0.5)))
+{
+	const double pi(4.0 * atan(1.0));// M_PI isn't standard
+	size_t i;
+	for (i = 0; i < size; ++i)
+	{
+		window[i] = 0.5 - 0.5 * cos(2.0 * pi * i / size);
+		windowPower += window[i] * window[i];
+	}
+}
+
+//==========================================================================
+// Class:			SpectralAnalysis::Plan
+// Function:		~Plan
+//
+// Description:		Destructor for Plan struct.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SpectralAnalysis::Plan::~Plan()
+{
+}
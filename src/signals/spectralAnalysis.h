@@ -0,0 +1,104 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  spectralAnalysis.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Averaged power spectral density (Welch's method) and
+//				 spectrograms of long signals.  The signal is read one window
+//				 at a time, so the working memory depends on the window size
+//				 and thread count rather than the signal length.  Groups of
+//				 windows are transformed in parallel.
+// History:
+
+#ifndef SPECTRAL_ANALYSIS_H_
+#define SPECTRAL_ANALYSIS_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+
+// Local forward declarations
+class ThreadPool;
+class RealFFT;
+
+// LibPlot2D forward declarations
+namespace LibPlot2D
+{
+class Dataset2D;
+}
+
+// Windowed, averaged spectra
+class SpectralAnalysis
+{
+public:
+	// windowSize is the number of samples per segment, and must be a power of
+	// two (it is reduced for signals shorter than one window).  Segments
+	// overlap by the specified fraction, are detrended by removing their mean
+	// and have a Hann window applied.
+	SpectralAnalysis(ThreadPool &pool, const size_t &windowSize = defaultWindowSize,
+		const double &overlap = defaultOverlap);
+
+	static const size_t defaultWindowSize;
+	static const double defaultOverlap;
+	static const size_t defaultSliceCount;
+
+	// One-sided density, in (units of y)^2 / Hz.  The sample rate is taken
+	// from the x-data.  Returns nullptr if there are too few points.
+	std::unique_ptr<LibPlot2D::Dataset2D> PowerSpectralDensity(
+		const LibPlot2D::Dataset2D &data) const;
+
+	bool PowerSpectralDensity(const double* values, const size_t &count,
+		const double &sampleRate, std::vector<double> &frequency,
+		std::vector<double> &density) const;
+
+	// Consecutive segments are averaged into at most sliceCount slices, so
+	// the size of the result is bounded however long the signal is
+	struct Spectrogram
+	{
+		std::vector<double> time;// [sec from the first sample] Middle of each slice
+		std::vector<double> frequency;// [Hz]
+		std::vector<double> density;// time.size() rows of frequency.size() values
+	};
+
+	bool ComputeSpectrogram(const double* values, const size_t &count,
+		const double &sampleRate, const size_t &sliceCount, Spectrogram &result) const;
+
+	// Zero if the x-data is not increasing
+	static double GetSampleRate(const LibPlot2D::Dataset2D &data);
+
+private:
+	ThreadPool &mPool;
+	const size_t mWindowSize;
+	const double mOverlap;
+
+	// Plan and window for one segment length
+	struct Plan
+	{
+		Plan(const size_t &size, const double &overlap);
+		~Plan();
+
+		std::unique_ptr<RealFFT> fft;
+		std::vector<double> window;
+		double windowPower;// Sum of the squares of the window
+		size_t step;// Between the starts of consecutive segments
+	};
+
+	size_t GetWindowSize(const size_t &count) const;
+	size_t GetSegmentCount(const size_t &count, const Plan &plan) const;
+
+	void SumPeriodograms(const double* values, const size_t &segmentCount,
+		const size_t &groupCount, const Plan &plan, double* sums) const;
+	static void ScaleDensity(double* sums, const size_t &binCount,
+		const double &scale);
+	static void GetFrequencies(const Plan &plan, const double &sampleRate,
+		std::vector<double> &frequency);
+};
+
+#endif// SPECTRAL_ANALYSIS_H_
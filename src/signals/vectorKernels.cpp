@@ -0,0 +1,948 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  vectorKernels.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Inner loops of the signal operations over plain arrays.  Each
+//				 has a scalar version and an AVX2 version; the AVX2 version is
+//				 used when the CPU supports it.
+// History:
+
+// Standard C++ headers
+#include <cmath>
+
+// Local headers
+#include "signals/vectorKernels.h"
+
+// Platform headers
+#ifdef VECTOR_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// The AVX2 functions are compiled for AVX2 regardless of the compiler flags
+// (MSVC doesn't need to be told), and only called if the CPU supports it
+#if defined(VECTOR_KERNELS_X86) && !defined(_MSC_VER)
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define AVX2_FUNCTION
+#endif
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for VectorKernels class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+bool VectorKernels::mUseAVX2(VectorKernels::DetectAVX2());
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		DetectAVX2
+//
+// Description:		Checks whether the CPU (and OS) support AVX2.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool VectorKernels::DetectAVX2()
+{
+#ifndef VECTOR_KERNELS_X86
+	return false;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	const bool osSavesYmm((info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6);
+	__cpuidex(info, 7, 0);
+	return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		UsingAVX2
+//
+// Description:		Returns true if the AVX2 versions are in use.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool VectorKernels::UsingAVX2()
+{
+	return mUseAVX2;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		SetAVX2Enabled
+//
+// Description:		Selects the AVX2 or scalar versions.  AVX2 can only be
+//					enabled if the CPU supports it.  Not thread-safe; call
+//					before starting any work.
+//
+// Input Arguments:
+//		enabled	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::SetAVX2Enabled(const bool &enabled)
+{
+	mUseAVX2 = enabled && DetectAVX2();
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Add
+//
+// Description:		Element-wise sum.
+//
+// Input Arguments:
+//		a		= const double*
+//		b		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Add(const double* a, const double* b, double* out,
+	const size_t &count)
+{
+	ApplyBinary(BinaryOperation::Add, a, b, out, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Subtract
+//
+// Description:		Element-wise difference.
+//
+// Input Arguments:
+//		a		= const double*
+//		b		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Subtract(const double* a, const double* b, double* out,
+	const size_t &count)
+{
+	ApplyBinary(BinaryOperation::Subtract, a, b, out, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Multiply
+//
+// Description:		Element-wise product.
+//
+// Input Arguments:
+//		a		= const double*
+//		b		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Multiply(const double* a, const double* b, double* out,
+	const size_t &count)
+{
+	ApplyBinary(BinaryOperation::Multiply, a, b, out, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Divide
+//
+// Description:		Element-wise quotient.
+//
+// Input Arguments:
+//		a		= const double*
+//		b		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Divide(const double* a, const double* b, double* out,
+	const size_t &count)
+{
+	ApplyBinary(BinaryOperation::Divide, a, b, out, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		ApplyBinary
+//
+// Description:		Dispatches an element-wise operation.
+//
+// Input Arguments:
+//		operation	= const BinaryOperation&
+//		a			= const double*
+//		b			= const double*
+//		count		= const size_t&
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::ApplyBinary(const BinaryOperation &operation, const double* a,
+	const double* b, double* out, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		ApplyBinaryAVX2(operation, a, b, out, count);
+		return;
+	}
+#endif
+
+	ApplyBinaryScalar(operation, a, b, out, 0, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		ApplyBinaryScalar
+//
+// Description:		Scalar element-wise operation over [begin, end).
+//
+// Input Arguments:
+//		operation	= const BinaryOperation&
+//		a			= const double*
+//		b			= const double*
+//		begin		= const size_t&
+//		end			= const size_t&
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::ApplyBinaryScalar(const BinaryOperation &operation,
+	const double* a, const double* b, double* out, const size_t &begin,
+	const size_t &end)
+{
+	size_t i;
+	switch (operation)
+	{
+	case BinaryOperation::Add:
+		for (i = begin; i < end; ++i)
+			out[i] = a[i] + b[i];
+		break;
+
+	case BinaryOperation::Subtract:
+		for (i = begin; i < end; ++i)
+			out[i] = a[i] - b[i];
+		break;
+
+	case BinaryOperation::Multiply:
+		for (i = begin; i < end; ++i)
+			out[i] = a[i] * b[i];
+		break;
+
+	case BinaryOperation::Divide:
+		for (i = begin; i < end; ++i)
+			out[i] = a[i] / b[i];
+		break;
+	}
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		ScaleAndOffset
+//
+// Description:		Computes a[i] * scale + offset.
+//
+// Input Arguments:
+//		a		= const double*
+//		scale	= const double&
+//		offset	= const double&
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::ScaleAndOffset(const double* a, const double &scale,
+	const double &offset, double* out, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		ScaleAndOffsetAVX2(a, scale, offset, out, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i < count; ++i)
+		out[i] = a[i] * scale + offset;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Difference
+//
+// Description:		Computes the slope between each pair of adjacent points.
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count	= const size_t&, number of points (count - 1 slopes)
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Difference(const double* x, const double* y, double* out,
+	const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		DifferenceAVX2(x, y, out, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i + 1 < count; ++i)
+		out[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		TrapezoidAreas
+//
+// Description:		Computes the area under each pair of adjacent points.
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count	= const size_t&, number of points (count - 1 areas)
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::TrapezoidAreas(const double* x, const double* y, double* out,
+	const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		TrapezoidAreasAVX2(x, y, out, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i + 1 < count; ++i)
+		out[i] = 0.5 * (y[i + 1] + y[i]) * (x[i + 1] - x[i]);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		Square
+//
+// Description:		Squares each element.
+//
+// Input Arguments:
+//		a		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::Square(const double* a, double* out, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		SquareAVX2(a, out, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i < count; ++i)
+		out[i] = a[i] * a[i];
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		PrefixSum
+//
+// Description:		Replaces each element with the running sum (in place).
+//
+// Input Arguments:
+//		a		= double*
+//		offset	= const double&, added to every sum
+//		count	= const size_t&
+//
+// Output Arguments:
+//		a		= double*
+//
+// Return Value:
+//		double, the last sum
+//
+//==========================================================================
+double VectorKernels::PrefixSum(double* a, const double &offset, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+		return PrefixSumAVX2(a, offset, count);
+#endif
+
+	double sum(offset);
+	size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		sum += a[i];
+		a[i] = sum;
+	}
+
+	return sum;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		AddOffset
+//
+// Description:		Adds a constant to each element (in place).
+//
+// Input Arguments:
+//		a		= double*
+//		offset	= const double&
+//		count	= const size_t&
+//
+// Output Arguments:
+//		a		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::AddOffset(double* a, const double &offset, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		AddOffsetAVX2(a, offset, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i < count; ++i)
+		a[i] += offset;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		RootMeanOfSums
+//
+// Description:		Converts running sums of squares to a running RMS.
+//
+// Input Arguments:
+//		a			= const double*
+//		firstIndex	= const size_t&, index of a[0] within the whole signal
+//		count		= const size_t&
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::RootMeanOfSums(const double* a, const size_t &firstIndex,
+	double* out, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		RootMeanOfSumsAVX2(a, firstIndex, out, count);
+		return;
+	}
+#endif
+
+	size_t i;
+	for (i = 0; i < count; ++i)
+		out[i] = sqrt(a[i] / static_cast<double>(firstIndex + i + 1));
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		SecondOrderSection
+//
+// Description:		Filters four interleaved channels through one second
+//					order section.  The recursion runs along each channel,
+//					so the four channels are what is done in parallel.
+//
+// Input Arguments:
+//		coefficients	= const double*, b0, b1, b2, a1, a2
+//		data			= double*, 4 * count values
+//		state			= double*, 8 values
+//		count			= const size_t&, number of frames
+//
+// Output Arguments:
+//		data			= double*
+//		state			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void VectorKernels::SecondOrderSection(const double* coefficients, double* data,
+	double* state, const size_t &count)
+{
+#ifdef VECTOR_KERNELS_X86
+	if (mUseAVX2)
+	{
+		SecondOrderSectionAVX2(coefficients, data, state, count);
+		return;
+	}
+#endif
+
+	const double b0(coefficients[0]), b1(coefficients[1]), b2(coefficients[2]);
+	const double a1(coefficients[3]), a2(coefficients[4]);
+	size_t i, c;
+	for (i = 0; i < count; ++i)
+	{
+		double* frame(data + 4 * i);
+		for (c = 0; c < 4; ++c)
+		{
+			const double x(frame[c]);
+			const double y(b0 * x + state[c]);
+			state[c] = b1 * x - a1 * y + state[c + 4];
+			state[c + 4] = b2 * x - a2 * y;
+			frame[c] = y;
+		}
+	}
+}
+
+#ifdef VECTOR_KERNELS_X86
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		ApplyBinaryAVX2
+//
+// Description:		AVX2 version of ApplyBinary().
+//
+// Input Arguments:
+//		operation	= const BinaryOperation&
+//		a			= const double*
+//		b			= const double*
+//		count		= const size_t&
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::ApplyBinaryAVX2(const BinaryOperation &operation,
+	const double* a, const double* b, double* out, const size_t &count)
+{
+	size_t i(0);
+	switch (operation)
+	{
+	case BinaryOperation::Add:
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		break;
+
+	case BinaryOperation::Subtract:
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		break;
+
+	case BinaryOperation::Multiply:
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		break;
+
+	case BinaryOperation::Divide:
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+		break;
+	}
+
+	ApplyBinaryScalar(operation, a, b, out, i, count);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		ScaleAndOffsetAVX2
+//
+// Description:		AVX2 version of ScaleAndOffset().  Multiplies and adds
+//					separately (no FMA) so results match the scalar version.
+//
+// Input Arguments:
+//		a		= const double*
+//		scale	= const double&
+//		offset	= const double&
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::ScaleAndOffsetAVX2(const double* a,
+	const double &scale, const double &offset, double* out, const size_t &count)
+{
+	const __m256d scaleVector(_mm256_set1_pd(scale));
+	const __m256d offsetVector(_mm256_set1_pd(offset));
+	size_t i;
+	for (i = 0; i + 4 <= count; i += 4)
+		_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(
+			_mm256_loadu_pd(a + i), scaleVector), offsetVector));
+
+	for (; i < count; ++i)
+		out[i] = a[i] * scale + offset;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		DifferenceAVX2
+//
+// Description:		AVX2 version of Difference().
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::DifferenceAVX2(const double* x, const double* y,
+	double* out, const size_t &count)
+{
+	size_t i;
+	for (i = 0; i + 5 <= count; i += 4)
+	{
+		const __m256d dy(_mm256_sub_pd(_mm256_loadu_pd(y + i + 1), _mm256_loadu_pd(y + i)));
+		const __m256d dx(_mm256_sub_pd(_mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(x + i)));
+		_mm256_storeu_pd(out + i, _mm256_div_pd(dy, dx));
+	}
+
+	for (; i + 1 < count; ++i)
+		out[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		TrapezoidAreasAVX2
+//
+// Description:		AVX2 version of TrapezoidAreas().
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::TrapezoidAreasAVX2(const double* x,
+	const double* y, double* out, const size_t &count)
+{
+	const __m256d half(_mm256_set1_pd(0.5));
+	size_t i;
+	for (i = 0; i + 5 <= count; i += 4)
+	{
+		const __m256d sum(_mm256_add_pd(_mm256_loadu_pd(y + i + 1), _mm256_loadu_pd(y + i)));
+		const __m256d dx(_mm256_sub_pd(_mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(x + i)));
+		_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_mul_pd(half, sum), dx));
+	}
+
+	for (; i + 1 < count; ++i)
+		out[i] = 0.5 * (y[i + 1] + y[i]) * (x[i + 1] - x[i]);
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		SquareAVX2
+//
+// Description:		AVX2 version of Square().
+//
+// Input Arguments:
+//		a		= const double*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		out		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::SquareAVX2(const double* a, double* out,
+	const size_t &count)
+{
+	size_t i;
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		const __m256d value(_mm256_loadu_pd(a + i));
+		_mm256_storeu_pd(out + i, _mm256_mul_pd(value, value));
+	}
+
+	for (; i < count; ++i)
+		out[i] = a[i] * a[i];
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		PrefixSumAVX2
+//
+// Description:		AVX2 version of PrefixSum().  Each group of four is
+//					summed within the register (two shift-and-add steps)
+//					before the running total is added, so the dependency
+//					chain is one add per four elements rather than per
+//					element.  The order of the additions differs from the
+//					scalar version, so results can differ in the last bit.
+//
+// Input Arguments:
+//		a		= double*
+//		offset	= const double&
+//		count	= const size_t&
+//
+// Output Arguments:
+//		a		= double*
+//
+// Return Value:
+//		double
+//
+//==========================================================================
+AVX2_FUNCTION double VectorKernels::PrefixSumAVX2(double* a, const double &offset,
+	const size_t &count)
+{
+	const __m256d zero(_mm256_setzero_pd());
+	__m256d carry(_mm256_set1_pd(offset));
+	size_t i;
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		__m256d value(_mm256_loadu_pd(a + i));
+		value = _mm256_add_pd(value, _mm256_blend_pd(
+			_mm256_permute4x64_pd(value, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+		value = _mm256_add_pd(value, _mm256_blend_pd(
+			_mm256_permute4x64_pd(value, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+		value = _mm256_add_pd(value, carry);
+		_mm256_storeu_pd(a + i, value);
+		carry = _mm256_permute4x64_pd(value, _MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	double sum(_mm256_cvtsd_f64(carry));
+	for (; i < count; ++i)
+	{
+		sum += a[i];
+		a[i] = sum;
+	}
+
+	return sum;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		AddOffsetAVX2
+//
+// Description:		AVX2 version of AddOffset().
+//
+// Input Arguments:
+//		a		= double*
+//		offset	= const double&
+//		count	= const size_t&
+//
+// Output Arguments:
+//		a		= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::AddOffsetAVX2(double* a, const double &offset,
+	const size_t &count)
+{
+	const __m256d offsetVector(_mm256_set1_pd(offset));
+	size_t i;
+	for (i = 0; i + 4 <= count; i += 4)
+		_mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i), offsetVector));
+
+	for (; i < count; ++i)
+		a[i] += offset;
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		RootMeanOfSumsAVX2
+//
+// Description:		AVX2 version of RootMeanOfSums().
+//
+// Input Arguments:
+//		a			= const double*
+//		firstIndex	= const size_t&
+//		count		= const size_t&
+//
+// Output Arguments:
+//		out			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::RootMeanOfSumsAVX2(const double* a,
+	const size_t &firstIndex, double* out, const size_t &count)
+{
+	const double first(static_cast<double>(firstIndex));
+	__m256d samples(_mm256_setr_pd(first + 1.0, first + 2.0, first + 3.0, first + 4.0));
+	const __m256d step(_mm256_set1_pd(4.0));
+	size_t i;
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_div_pd(_mm256_loadu_pd(a + i), samples)));
+		samples = _mm256_add_pd(samples, step);
+	}
+
+	for (; i < count; ++i)
+		out[i] = sqrt(a[i] / static_cast<double>(firstIndex + i + 1));
+}
+
+//==========================================================================
+// Class:			VectorKernels
+// Function:		SecondOrderSectionAVX2
+//
+// Description:		AVX2 version of SecondOrderSection(), with one channel
+//					per lane.  No FMA, so results match the scalar version.
+//
+// Input Arguments:
+//		coefficients	= const double*
+//		data			= double*
+//		state			= double*
+//		count			= const size_t&
+//
+// Output Arguments:
+//		data			= double*
+//		state			= double*
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+AVX2_FUNCTION void VectorKernels::SecondOrderSectionAVX2(const double* coefficients,
+	double* data, double* state, const size_t &count)
+{
+	const __m256d b0(_mm256_set1_pd(coefficients[0]));
+	const __m256d b1(_mm256_set1_pd(coefficients[1]));
+	const __m256d b2(_mm256_set1_pd(coefficients[2]));
+	const __m256d a1(_mm256_set1_pd(coefficients[3]));
+	const __m256d a2(_mm256_set1_pd(coefficients[4]));
+	__m256d z1(_mm256_loadu_pd(state));
+	__m256d z2(_mm256_loadu_pd(state + 4));
+	size_t i;
+	for (i = 0; i < count; ++i)
+	{
+		const __m256d x(_mm256_loadu_pd(data + 4 * i));
+		const __m256d y(_mm256_add_pd(_mm256_mul_pd(b0, x), z1));
+		z1 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(b1, x), _mm256_mul_pd(a1, y)), z2);
+		z2 = _mm256_sub_pd(_mm256_mul_pd(b2, x), _mm256_mul_pd(a2, y));
+		_mm256_storeu_pd(data + 4 * i, y);
+	}
+
+	_mm256_storeu_pd(state, z1);
+	_mm256_storeu_pd(state + 4, z2);
+}
+
+#endif// VECTOR_KERNELS_X86
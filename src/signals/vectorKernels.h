@@ -0,0 +1,115 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  vectorKernels.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Inner loops of the signal operations over plain arrays.  Each
+//				 has a scalar version and an AVX2 version; the AVX2 version is
+//				 used when the CPU supports it.
+// History:
+
+#ifndef VECTOR_KERNELS_H_
+#define VECTOR_KERNELS_H_
+
+// Standard C++ headers
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VECTOR_KERNELS_X86
+#endif
+
+// Array kernels.  Unless noted, out may be the same array as an input.
+class VectorKernels
+{
+public:
+	// True if the AVX2 versions are in use
+	static bool UsingAVX2();
+
+	// For comparing against the scalar versions
+	static void SetAVX2Enabled(const bool &enabled);
+
+	// out[i] = a[i] (op) b[i]
+	static void Add(const double* a, const double* b, double* out, const size_t &count);
+	static void Subtract(const double* a, const double* b, double* out, const size_t &count);
+	static void Multiply(const double* a, const double* b, double* out, const size_t &count);
+	static void Divide(const double* a, const double* b, double* out, const size_t &count);
+
+	// out[i] = a[i] * scale + offset
+	static void ScaleAndOffset(const double* a, const double &scale,
+		const double &offset, double* out, const size_t &count);
+
+	// out[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]) for i in [0, count - 1)
+	static void Difference(const double* x, const double* y, double* out,
+		const size_t &count);
+
+	// out[i] = 0.5 * (y[i + 1] + y[i]) * (x[i + 1] - x[i]) for i in [0, count - 1)
+	static void TrapezoidAreas(const double* x, const double* y, double* out,
+		const size_t &count);
+
+	// out[i] = a[i] * a[i]
+	static void Square(const double* a, double* out, const size_t &count);
+
+	// a[i] = offset + a[0] + ... + a[i]; returns a[count - 1], or offset if
+	// count is zero
+	static double PrefixSum(double* a, const double &offset, const size_t &count);
+
+	// a[i] += offset
+	static void AddOffset(double* a, const double &offset, const size_t &count);
+
+	// out[i] = sqrt(a[i] / (firstIndex + i + 1)), for turning running sums of
+	// squares into a running RMS
+	static void RootMeanOfSums(const double* a, const size_t &firstIndex,
+		double* out, const size_t &count);
+
+	// Runs one second order section (transposed direct form II) over count
+	// frames of four interleaved channels, in place:  data[4 * i + c] is
+	// sample i of channel c.  coefficients holds b0, b1, b2, a1 and a2 (a0 is
+	// one); state holds the four channels' first states then their second
+	// states, and is updated.
+	static void SecondOrderSection(const double* coefficients, double* data,
+		double* state, const size_t &count);
+
+private:
+	static bool mUseAVX2;
+	static bool DetectAVX2();
+
+	enum class BinaryOperation
+	{
+		Add,
+		Subtract,
+		Multiply,
+		Divide
+	};
+
+	static void ApplyBinary(const BinaryOperation &operation, const double* a,
+		const double* b, double* out, const size_t &count);
+	static void ApplyBinaryScalar(const BinaryOperation &operation, const double* a,
+		const double* b, double* out, const size_t &begin, const size_t &end);
+
+#ifdef VECTOR_KERNELS_X86
+	static void ApplyBinaryAVX2(const BinaryOperation &operation, const double* a,
+		const double* b, double* out, const size_t &count);
+	static void ScaleAndOffsetAVX2(const double* a, const double &scale,
+		const double &offset, double* out, const size_t &count);
+	static void DifferenceAVX2(const double* x, const double* y, double* out,
+		const size_t &count);
+	static void TrapezoidAreasAVX2(const double* x, const double* y, double* out,
+		const size_t &count);
+	static void SquareAVX2(const double* a, double* out, const size_t &count);
+	static double PrefixSumAVX2(double* a, const double &offset, const size_t &count);
+	static void AddOffsetAVX2(double* a, const double &offset, const size_t &count);
+	static void RootMeanOfSumsAVX2(const double* a, const size_t &firstIndex,
+		double* out, const size_t &count);
+	static void SecondOrderSectionAVX2(const double* coefficients, double* data,
+		double* state, const size_t &count);
+#endif
+};
+
+#endif// VECTOR_KERNELS_H_
@@ -0,0 +1,428 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  perfMonitor.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Application-wide timers and counters for the expensive steps
+//				 (loading, parsing, signal operations, drawing).  Nothing is
+//				 recorded unless monitoring is switched on.  Results can be
+//				 summarized as text or exported as a Chrome trace
+//				 (chrome://tracing or https://ui.perfetto.dev).
+// History:
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+// Local headers
+#include "utilities/perfMonitor.h"
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for PerfMonitor class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t PerfMonitor::mMaxEvents(1 << 18);
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		PerfMonitor
+//
+// Description:		Constructor for PerfMonitor class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PerfMonitor::PerfMonitor() : mEnabled(false), mStartTime(std::chrono::steady_clock::now())
+{
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		GetSharedMonitor
+//
+// Description:		Returns the application-wide monitor.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PerfMonitor&
+//
+//==========================================================================
+PerfMonitor& PerfMonitor::GetSharedMonitor()
+{
+	static PerfMonitor monitor;
+	return monitor;
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		SetEnabled
+//
+// Description:		Switches monitoring on or off.
+//
+// Input Arguments:
+//		enabled	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PerfMonitor::SetEnabled(const bool &enabled)
+{
+	if (enabled && !mEnabled)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEvents.clear();
+		mStatistics.clear();
+	}
+
+	mEnabled = enabled;
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		GetTime
+//
+// Description:		Returns the time since the monitor was created.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		long long [usec]
+//
+//==========================================================================
+long long PerfMonitor::GetTime() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - mStartTime).count();
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		RecordDuration
+//
+// Description:		Records a timed interval.  Ignored when monitoring is
+//					off.
+//
+// Input Arguments:
+//		name	= const char*
+//		start	= const long long& [usec]
+//		end		= const long long& [usec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PerfMonitor::RecordDuration(const char* name, const long long &start,
+	const long long &end)
+{
+	if (!mEnabled)
+		return;
+
+	Event event;
+	event.name = name;
+	event.start = start;
+	event.duration = end - start;
+	event.value = 0.0;
+	event.counter = false;
+	Record(event);
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		RecordCounter
+//
+// Description:		Records the current value of a counter.  Ignored when
+//					monitoring is off.
+//
+// Input Arguments:
+//		name	= const char*
+//		value	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PerfMonitor::RecordCounter(const char* name, const double &value)
+{
+	if (!mEnabled)
+		return;
+
+	Event event;
+	event.name = name;
+	event.start = GetTime();
+	event.duration = 0;
+	event.value = value;
+	event.counter = true;
+	Record(event);
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		Record
+//
+// Description:		Stores an event and updates its statistics.
+//
+// Input Arguments:
+//		event	= const Event&, without its thread number
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PerfMonitor::Record(const Event &event)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEvents.push_back(event);
+	mEvents.back().thread = GetThreadNumber();
+	if (mEvents.size() > mMaxEvents)
+		mEvents.pop_front();
+
+	Statistics& statistics(mStatistics[event.name]);
+	const double value(event.counter ? event.value : static_cast<double>(event.duration));
+	statistics.counter = event.counter;
+	statistics.last = value;
+	statistics.total += value;
+	statistics.maximum = statistics.count == 0 ? value : std::max(statistics.maximum, value);
+	++statistics.count;
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		GetThreadNumber
+//
+// Description:		Returns a small number identifying the calling thread.
+//					Must be called with mMutex locked.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//==========================================================================
+unsigned int PerfMonitor::GetThreadNumber()
+{
+	const auto inserted(mThreadNumbers.insert(std::make_pair(std::this_thread::get_id(),
+		static_cast<unsigned int>(mThreadNumbers.size() + 1))));
+	return inserted.first->second;
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		GetSummary
+//
+// Description:		Describes the recorded timers and counters.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string PerfMonitor::GetSummary() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::ostringstream summary;
+	summary << std::fixed;
+	for (const auto& entry : mStatistics)
+	{
+		const Statistics& statistics(entry.second);
+		summary << entry.first << ":  ";
+		if (statistics.counter)
+			summary << std::setprecision(statistics.last == std::floor(statistics.last) ? 0 : 2)
+				<< statistics.last << '\n';
+		else
+			summary << std::setprecision(2) << statistics.last * 1.0e-3 << " ms (mean "
+				<< statistics.total * 1.0e-3 / statistics.count << ", max "
+				<< statistics.maximum * 1.0e-3 << ", n = " << statistics.count << ")\n";
+	}
+
+	return summary.str();
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		ExportChromeTrace
+//
+// Description:		Writes the recorded events in the Trace Event Format.
+//					Timers are complete ("X") events on the thread which ran
+//					them; counters are counter ("C") events.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success
+//
+//==========================================================================
+bool PerfMonitor::ExportChromeTrace(const std::string &fileName) const
+{
+	std::ofstream file(fileName.c_str());
+	if (!file.is_open())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first(true);
+	for (const auto& event : mEvents)
+	{
+		if (!first)
+			file << ',';
+		first = false;
+
+		file << "\n{\"name\":\"" << EscapeJSON(event.name) << "\",\"cat\":\"DataPlotter\",\"ph\":\""
+			<< (event.counter ? 'C' : 'X') << "\",\"ts\":" << event.start
+			<< ",\"pid\":1,\"tid\":" << event.thread;
+		if (event.counter)
+			file << ",\"args\":{\"value\":" << event.value << "}}";
+		else
+			file << ",\"dur\":" << event.duration << '}';
+	}
+
+	for (const auto& thread : mThreadNumbers)
+		file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+			<< thread.second << ",\"args\":{\"name\":\"Thread " << thread.second << "\"}}";
+
+	file << "\n]}\n";
+	return static_cast<bool>(file);
+}
+
+//==========================================================================
+// Class:			PerfMonitor
+// Function:		EscapeJSON
+//
+// Description:		Escapes quotes, backslashes and control characters for
+//					use in a JSON string.
+//
+// Input Arguments:
+//		text	= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string PerfMonitor::EscapeJSON(const char* text)
+{
+	std::string escaped;
+	for (; *text; ++text)
+	{
+		if (*text == '"' || *text == '\\')
+			escaped += '\\';
+		else if (static_cast<unsigned char>(*text) < 0x20)
+		{
+			escaped += ' ';
+			continue;
+		}
+
+		escaped += *text;
+	}
+
+	return escaped;
+}
+
+//==========================================================================
+// Class:			PerfMonitor::ScopedTimer
+// Function:		ScopedTimer
+//
+// Description:		Constructor for ScopedTimer class.  Starts timing.
+//
+// Input Arguments:
+//		name	= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PerfMonitor::ScopedTimer::ScopedTimer(const char* name) : mName(name),
+	mStart(GetSharedMonitor().IsEnabled() ? GetSharedMonitor().GetTime() : -1)
+{
+}
+
+//==========================================================================
+// Class:			PerfMonitor::ScopedTimer
+// Function:		~ScopedTimer
+//
+// Description:		Destructor for ScopedTimer class.  Records the time
+//					since construction.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PerfMonitor::ScopedTimer::~ScopedTimer()
+{
+	if (mStart >= 0)
+		GetSharedMonitor().RecordDuration(mName, mStart, GetSharedMonitor().GetTime());
+}
@@ -0,0 +1,112 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  perfMonitor.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Application-wide timers and counters for the expensive steps
+//				 (loading, parsing, signal operations, drawing).  Nothing is
+//				 recorded unless monitoring is switched on.  Results can be
+//				 summarized as text or exported as a Chrome trace
+//				 (chrome://tracing or https://ui.perfetto.dev).
+// History:
+
+#ifndef PERF_MONITOR_H_
+#define PERF_MONITOR_H_
+
+// Standard C++ headers
+#include <string>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Collects timing and counter events
+class PerfMonitor
+{
+public:
+	// Monitor shared by the whole application
+	static PerfMonitor& GetSharedMonitor();
+
+	PerfMonitor(const PerfMonitor&) = delete;
+	PerfMonitor& operator=(const PerfMonitor&) = delete;
+
+	// Switching on clears anything recorded before
+	void SetEnabled(const bool &enabled);
+	bool IsEnabled() const { return mEnabled; }
+
+	// [usec since the monitor was created]
+	long long GetTime() const;
+
+	// Names must remain valid for the life of the monitor (use literals)
+	void RecordDuration(const char* name, const long long &start, const long long &end);
+	void RecordCounter(const char* name, const double &value);
+
+	// Times the enclosing scope.  Costs one check of the enabled flag when
+	// monitoring is off.
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(const char* name);
+		~ScopedTimer();
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		const char* mName;
+		long long mStart;// [usec], negative when monitoring is off
+	};
+
+	// One line per timer (count, last, mean and maximum duration) and
+	// counter (last value), in alphabetical order
+	std::string GetSummary() const;
+
+	bool ExportChromeTrace(const std::string &fileName) const;
+
+private:
+	PerfMonitor();
+
+	static const size_t mMaxEvents;
+
+	std::atomic<bool> mEnabled;
+	const std::chrono::steady_clock::time_point mStartTime;
+
+	struct Event
+	{
+		const char* name;
+		long long start;// [usec]
+		long long duration;// [usec], timers only
+		double value;// Counters only
+		unsigned int thread;
+		bool counter;
+	};
+
+	struct Statistics
+	{
+		bool counter = false;
+		unsigned long long count = 0;
+		double last = 0.0;// [usec] for timers
+		double total = 0.0;
+		double maximum = 0.0;
+	};
+
+	mutable std::mutex mMutex;
+	std::deque<Event> mEvents;// Oldest are dropped beyond mMaxEvents
+	std::map<std::string, Statistics> mStatistics;
+	std::map<std::thread::id, unsigned int> mThreadNumbers;
+
+	void Record(const Event &event);
+	unsigned int GetThreadNumber();
+	static std::string EscapeJSON(const char* text);
+};
+
+#endif// PERF_MONITOR_H_
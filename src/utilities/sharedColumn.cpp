@@ -0,0 +1,195 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  sharedColumn.cpp
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Column of values which can be referenced by several curves at
+//				 once (every curve from a file shares the file's time column).
+//				 The values are copied only when one of the sharing owners
+//				 modifies them.  Values may also live in storage owned by
+//				 something else (e.g. a memory mapped file).
+// History:
+
+// Standard C++ headers
+#include <algorithm>
+
+// Local headers
+#include "utilities/sharedColumn.h"
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		SharedColumn
+//
+// Description:		Constructor for SharedColumn class.
+//
+// Input Arguments:
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SharedColumn::SharedColumn(const size_t &size)
+	: mValues(std::make_shared<std::vector<double>>(size))
+{
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		SharedColumn
+//
+// Description:		Constructor for SharedColumn class.  Refers to values
+//					which are stored elsewhere.
+//
+// Input Arguments:
+//		owner	= const std::shared_ptr<const void>&, keeps values valid
+//		values	= const double*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SharedColumn::SharedColumn(const std::shared_ptr<const void> &owner,
+	const double* values, const size_t &size) : mOwner(owner),
+	mExternalValues(values), mExternalSize(size)
+{
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		GetSize
+//
+// Description:		Returns the number of values.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t SharedColumn::GetSize() const
+{
+	if (mOwner)
+		return mExternalSize;
+	return mValues ? mValues->size() : 0;
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		GetData
+//
+// Description:		Returns a pointer to the values.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const double*
+//
+//==========================================================================
+const double* SharedColumn::GetData() const
+{
+	if (mOwner)
+		return mExternalValues;
+	return mValues ? mValues->data() : nullptr;
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		GetWritableData
+//
+// Description:		Returns a pointer through which the values may be
+//					modified, copying them first if they are shared.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double*
+//
+//==========================================================================
+double* SharedColumn::GetWritableData()
+{
+	MakeUnique(GetSize());
+	return mValues->data();
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		Resize
+//
+// Description:		Changes the number of values.  New values are zero.
+//
+// Input Arguments:
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SharedColumn::Resize(const size_t &size)
+{
+	MakeUnique(std::min(size, GetSize()));
+	mValues->resize(size);
+}
+
+//==========================================================================
+// Class:			SharedColumn
+// Function:		MakeUnique
+//
+// Description:		Ensures no other SharedColumn refers to our values.  If
+//					one does, the values we are going to keep are copied.
+//
+// Input Arguments:
+//		sizeToKeep	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SharedColumn::MakeUnique(const size_t &sizeToKeep)
+{
+	if (mOwner)
+	{
+		mValues = std::make_shared<std::vector<double>>(mExternalValues,
+			mExternalValues + sizeToKeep);
+		mOwner.reset();
+		mExternalValues = nullptr;
+		mExternalSize = 0;
+	}
+	else if (!mValues)
+		mValues = std::make_shared<std::vector<double>>();
+	else if (mValues.use_count() > 1)
+		mValues = std::make_shared<std::vector<double>>(mValues->begin(),
+			mValues->begin() + sizeToKeep);
+}
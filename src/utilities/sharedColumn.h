@@ -0,0 +1,62 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  sharedColumn.h
+// Created:  10/17/2026
+// Author:  agent
+// Description:  Column of values which can be referenced by several curves at
+//				 once (every curve from a file shares the file's time column).
+//				 The values are copied only when one of the sharing owners
+//				 modifies them.  Values may also live in storage owned by
+//				 something else (e.g. a memory mapped file).
+// History:
+
+#ifndef SHARED_COLUMN_H_
+#define SHARED_COLUMN_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+
+// Copy-on-write column of doubles.  Copies of a SharedColumn refer to the
+// same values.  Different SharedColumn objects may be used from different
+// threads, but a single object may not.
+class SharedColumn
+{
+public:
+	SharedColumn() = default;
+	explicit SharedColumn(const size_t &size);
+
+	// Refers to values stored elsewhere; owner keeps the storage alive.  The
+	// values are treated as shared, so modifying them always makes a copy.
+	SharedColumn(const std::shared_ptr<const void> &owner,
+		const double* values, const size_t &size);
+
+	size_t GetSize() const;
+	const double* GetData() const;
+
+	// True if other SharedColumns (or external storage) refer to the same values
+	bool IsShared() const { return mOwner || (mValues && mValues.use_count() > 1); }
+
+	// These copy the values first if they are shared, so the pointer (like
+	// any previously returned by GetData()) is only valid until the next call
+	double* GetWritableData();
+	void Resize(const size_t &size);
+
+private:
+	std::shared_ptr<std::vector<double>> mValues;
+
+	std::shared_ptr<const void> mOwner;
+	const double* mExternalValues = nullptr;
+	size_t mExternalSize = 0;
+
+	void MakeUnique(const size_t &sizeToKeep);
+};
+
+#endif// SHARED_COLUMN_H_
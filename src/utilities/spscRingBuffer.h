@@ -0,0 +1,187 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  spscRingBuffer.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Lock-free ring buffer for passing data from one producer thread to
+//				 one consumer thread.
+// History:
+
+#ifndef SPSC_RING_BUFFER_H_
+#define SPSC_RING_BUFFER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+
+// Single-producer, single-consumer ring buffer.  TryPush() may only be called from
+// one thread and Pop() from one (other) thread.
+template<typename T>
+class SpscRingBuffer
+{
+public:
+	// Capacity is rounded up to a power of two
+	explicit SpscRingBuffer(const size_t &minimumCapacity);
+
+	SpscRingBuffer(const SpscRingBuffer&) = delete;
+	SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+	// Adds all of the items, or none of them if there isn't room, so the
+	// consumer never sees part of a batch
+	bool TryPush(const T* items, const size_t &count);
+
+	// Removes up to maxCount items; returns the number removed
+	size_t Pop(T* items, const size_t &maxCount);
+
+	size_t GetCapacity() const { return mBuffer.size(); }
+
+private:
+	std::vector<T> mBuffer;
+	const size_t mMask;
+
+	// Positions only ever increase; they are masked when indexing.  Each is
+	// kept apart from the other (to avoid false sharing between the threads),
+	// along with the other side's position as last seen by its owner.
+	std::atomic<size_t> mHead;// Written by the producer
+	size_t mCachedTail;
+	char mPadding[64];
+	std::atomic<size_t> mTail;// Written by the consumer
+	size_t mCachedHead;
+
+	static size_t RoundUpToPowerOfTwo(const size_t &value);
+};
+
+//==========================================================================
+// Class:			SpscRingBuffer
+// Function:		SpscRingBuffer
+//
+// Description:		Constructor for SpscRingBuffer class.
+//
+// Input Arguments:
+//		minimumCapacity	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template<typename T>
+SpscRingBuffer<T>::SpscRingBuffer(const size_t &minimumCapacity)
+	: mBuffer(RoundUpToPowerOfTwo(minimumCapacity)), mMask(mBuffer.size() - 1),
+	mHead(0), mCachedTail(0), mTail(0), mCachedHead(0)
+{
+}
+
+//==========================================================================
+// Class:			SpscRingBuffer
+// Function:		TryPush
+//
+// Description:		Copies items into the buffer.  Called from the producer
+//					thread only.
+//
+// Input Arguments:
+//		items	= const T*
+//		count	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, false if there was not enough space (nothing is added)
+//
+//==========================================================================
+template<typename T>
+bool SpscRingBuffer<T>::TryPush(const T* items, const size_t &count)
+{
+	const size_t head(mHead.load(std::memory_order_relaxed));
+	if (head + count - mCachedTail > mBuffer.size())
+	{
+		mCachedTail = mTail.load(std::memory_order_acquire);
+		if (head + count - mCachedTail > mBuffer.size())
+			return false;
+	}
+
+	const size_t start(head & mMask);
+	const size_t firstPart(std::min(count, mBuffer.size() - start));
+	std::copy(items, items + firstPart, mBuffer.begin() + start);
+	std::copy(items + firstPart, items + count, mBuffer.begin());
+
+	mHead.store(head + count, std::memory_order_release);
+	return true;
+}
+
+//==========================================================================
+// Class:			SpscRingBuffer
+// Function:		Pop
+//
+// Description:		Copies items out of the buffer.  Called from the consumer
+//					thread only.
+//
+// Input Arguments:
+//		maxCount	= const size_t&
+//
+// Output Arguments:
+//		items		= T*
+//
+// Return Value:
+//		size_t, number of items removed
+//
+//==========================================================================
+template<typename T>
+size_t SpscRingBuffer<T>::Pop(T* items, const size_t &maxCount)
+{
+	const size_t tail(mTail.load(std::memory_order_relaxed));
+	if (mCachedHead == tail)
+		mCachedHead = mHead.load(std::memory_order_acquire);
+
+	const size_t count(std::min(maxCount, mCachedHead - tail));
+	if (count == 0)
+		return 0;
+
+	const size_t start(tail & mMask);
+	const size_t firstPart(std::min(count, mBuffer.size() - start));
+	std::copy(mBuffer.begin() + start, mBuffer.begin() + start + firstPart, items);
+	std::copy(mBuffer.begin(), mBuffer.begin() + (count - firstPart), items + firstPart);
+
+	mTail.store(tail + count, std::memory_order_release);
+	return count;
+}
+
+//==========================================================================
+// Class:			SpscRingBuffer
+// Function:		RoundUpToPowerOfTwo
+//
+// Description:		Returns the smallest power of two not less than value.
+//
+// Input Arguments:
+//		value	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+template<typename T>
+size_t SpscRingBuffer<T>::RoundUpToPowerOfTwo(const size_t &value)
+{
+	size_t result(1);
+	while (result < value)
+		result <<= 1;
+
+	return result;
+}
+
+#endif// SPSC_RING_BUFFER_H_
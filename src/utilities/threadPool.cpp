@@ -0,0 +1,256 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  threadPool.cpp
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Fixed-size pool of worker threads for running independent tasks
+//				 (file parsing, signal operations, etc.) off of the GUI thread.
+// History:
+
+// Standard C++ headers
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+
+// Local headers
+#include "utilities/threadPool.h"
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ThreadPool
+//
+// Description:		Constructor for ThreadPool class.  Starts the worker
+//					threads.
+//
+// Input Arguments:
+//		threadCount	= const unsigned int&; zero for one per hardware thread
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::ThreadPool(const unsigned int &threadCount)
+{
+	unsigned int count(threadCount);
+	if (count == 0)
+		count = std::max(std::thread::hardware_concurrency(), 1U);
+
+	mThreads.reserve(count);
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		mThreads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		~ThreadPool
+//
+// Description:		Destructor for ThreadPool class.  Finishes any queued
+//					tasks and joins the worker threads.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mTaskCondition.notify_all();
+
+	for (auto& t : mThreads)
+		t.join();
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		GetSharedPool
+//
+// Description:		Returns the application-wide pool.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		ThreadPool&
+//
+//==========================================================================
+ThreadPool& ThreadPool::GetSharedPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		Push
+//
+// Description:		Adds a task to the queue and wakes a worker.
+//
+// Input Arguments:
+//		task	= std::function<void()>&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::Push(std::function<void()>&& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		assert(!mStopping);
+		mTasks.push(std::move(task));
+	}
+	mTaskCondition.notify_one();
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		WorkerLoop
+//
+// Description:		Main function for each worker thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::WorkerLoop()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mTaskCondition.wait(lock, [this]()
+			{
+				return mStopping || !mTasks.empty();
+			});
+
+			if (mTasks.empty())
+				return;
+
+			task = std::move(mTasks.front());
+			mTasks.pop();
+		}
+
+		task();
+	}
+}
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		ParallelFor
+//
+// Description:		Splits [0, count) into blocks and processes them on the
+//					pool.  Blocks are claimed through a shared counter, and
+//					the calling thread claims blocks as well, so this never
+//					waits on work that has not yet been started.
+//
+// Input Arguments:
+//		count			= const size_t&
+//		minBlockSize	= const size_t&
+//		function		= const RangeFunction&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void ThreadPool::ParallelFor(const size_t &count, const size_t &minBlockSize,
+	const RangeFunction &function)
+{
+	if (count == 0)
+		return;
+
+	const size_t blockSize(std::max(minBlockSize, static_cast<size_t>(1)));
+	const size_t blockCount((count + blockSize - 1) / blockSize);
+	if (blockCount == 1)
+	{
+		function(0, count);
+		return;
+	}
+
+	struct SharedState
+	{
+		std::atomic<size_t> nextBlock{0};
+		std::atomic<size_t> finishedBlocks{0};
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+	auto state(std::make_shared<SharedState>());
+
+	auto work([state, blockSize, blockCount, count, &function]()
+	{
+		size_t block;
+		while ((block = state->nextBlock++) < blockCount)
+		{
+			try
+			{
+				function(block * blockSize, std::min(count, (block + 1) * blockSize));
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				if (!state->error)
+					state->error = std::current_exception();
+			}
+
+			if (++state->finishedBlocks == blockCount)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->done.notify_all();
+			}
+		}
+	});
+
+	// Helpers that start after all blocks are claimed return immediately and
+	// never touch function, so capturing it by reference is safe
+	const size_t helperCount(std::min(blockCount - 1, mThreads.size()));
+	size_t i;
+	for (i = 0; i < helperCount; ++i)
+		Push(work);
+
+	work();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->done.wait(lock, [state, blockCount]()
+	{
+		return state->finishedBlocks == blockCount;
+	});
+
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
@@ -0,0 +1,99 @@
+/*===================================================================================
+                                    DataPlotter
+                          Copyright Kerry R. Loux 2011-2016
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  threadPool.h
+// Created:  10/16/2026
+// Author:  agent
+// Description:  Fixed-size pool of worker threads for running independent tasks
+//				 (file parsing, signal operations, etc.) off of the GUI thread.
+// History:
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+
+// Pool of worker threads
+class ThreadPool
+{
+public:
+	// A thread count of zero uses one thread per hardware core
+	explicit ThreadPool(const unsigned int &threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Pool shared by the whole application
+	static ThreadPool& GetSharedPool();
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(mThreads.size()); }
+
+	template<typename Function>
+	auto Enqueue(Function&& task) -> std::future<decltype(task())>;
+
+	// Calls function(begin, end) over [0, count) in blocks of at least
+	// minBlockSize items.  The calling thread processes blocks too, so this is
+	// safe to call from within a task that is already running on the pool.
+	typedef std::function<void(const size_t&, const size_t&)> RangeFunction;
+	void ParallelFor(const size_t &count, const size_t &minBlockSize,
+		const RangeFunction &function);
+
+private:
+	std::vector<std::thread> mThreads;
+	std::queue<std::function<void()>> mTasks;
+
+	std::mutex mMutex;
+	std::condition_variable mTaskCondition;
+	bool mStopping = false;
+
+	void WorkerLoop();
+	void Push(std::function<void()>&& task);
+};
+
+//==========================================================================
+// Class:			ThreadPool
+// Function:		Enqueue
+//
+// Description:		Adds a task to the queue.
+//
+// Input Arguments:
+//		task	= Function&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::future which becomes ready when the task completes
+//
+//==========================================================================
+template<typename Function>
+auto ThreadPool::Enqueue(Function&& task) -> std::future<decltype(task())>
+{
+	typedef decltype(task()) ReturnType;
+	auto packagedTask(std::make_shared<std::packaged_task<ReturnType()>>(
+		std::forward<Function>(task)));
+	std::future<ReturnType> result(packagedTask->get_future());
+	Push([packagedTask]()
+	{
+		(*packagedTask)();
+	});
+
+	return result;
+}
+
+#endif// THREAD_POOL_H_